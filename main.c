@@ -8,6 +8,25 @@
 #include "myGpio.h"
 #include "myClocks.h"
 #include "myLcd.h"
+#include "myRandom.h"
+#include "mySequence.h"
+#include "myDifficulty.h"
+#include "myAdaptive.h"
+#include "myScores.h"
+#include "myCheckpoint.h"
+#include "myPower.h"
+#include "myTrace.h"
+#include "myTelemetry.h"
+#include "myUart.h"
+#include "myRemote.h"
+#include "myBench.h"
+#include "myProfile.h"
+#include "myTimer.h"
+#include "myStack.h"
+#include "myIsr.h"
+#include "myMessage.h"
+#include "myLink.h"
+#include "myGame.h"
 
 #define RED_ON          0x0001      					// Enable and turn on the red LED
 #define RED_OFF         0xFFFE      					// Turn off the red LED
@@ -21,101 +40,221 @@
 #define ACLK		0x0100						// Timer_A SMCLK source
 #define DEVELOPMENT 	0x5A80						// Stop the watchdog timer
 #define BOUNCE_DELAY	0xA000						// Delay for Button Bounce
-#define MS_10		400						// Approximate value to count for 10ms
 #define SMCLK		0x0200						// Timer_A SMCLK source
 
+static Timer tickTimer;								// Wakes delay() at the next tick
+static volatile int ticked = 0;						// A tick has gone by since delay() last counted one
+
 
 void main (void)
 {
 	void DisplayMultipleWords(char words[250]);		
-	void ScrollWords(char words[250]);
+	void ScrollMessage(unsigned int id);
 	void DisplayNumber(unsigned long int number);
 	void DisplayWord(char words[250]);
-	int  delay(int count);
-	int  GetRandomSequence(int sequence);
-	void ShowSequence(int sequence, int i);
-	int  GetUserSequence(int sequence, int gameOver, int i);
-	void GameOverMessage(int score);
+	void DelayTicks(int count);
+	unsigned long GetRandomSequence(int *endless);
+	unsigned int GetDifficultyLevel(int *adaptive);
+	void ShowSequence(unsigned int i, const Tempo *tempo);
+	int  GetUserSequence(Game *game, const Tempo *tempo);
+	void GameOverMessage(unsigned int score, int won, int place, int race);
+
+    unsigned int i;										// Used in for loops
+
+    unsigned int firstRound;							// Round the game starts (or resumes) at
+
+    unsigned int score;									// Number correct so far
+
+    unsigned long seed;									// Seed the random LED sequence is made from
+
+    int endless;										// Is this an endless game?
 
-    int i;												// Used in for loops
+    unsigned int level;									// Difficulty level picked by the user
 
-    int score;											// Number correct so far
+    int adaptive;										// Does the tempo adapt to the user?
 
-    int sequence;										// Random sequence of 16 LED blinks
+    const Tempo *tempo;									// Timing for the current round
 
     int gameOver;										// Is game over?
 
+    Game game;											// Round, score and mistakes, by the rules in myGame.c
+
+    int place;											// Place in the high score table, or -1
+
+    int race;											// How a race against another board went (LINK_xxx)
+
     int delayCount;										// Number of 10ms delays needed
 
+    Checkpoint checkpoint;								// Game saved in FRAM before a reset
+
+    int resume;											// Is there a game to resume?
+
+    unsigned int resetReason;							// Why the board reset (SYSRSTIV)
+
     WDTCTL = WDTPW | WDTHOLD;                           // Stop watchdog timer
+	Stack_paint();										// Mark the unused stack, to see how deep it gets
 
+	Trace_init();										// Start an empty event trace
+	resetReason = SYSRSTIV;								// Find out why the board reset
+	TRACE(TRACE_BOOT, resetReason);						// and log it
 	initGPIO();											// Initialize GPIO
+	Power_init();										// Clear any button wakeup from LPM4.5
     initClocks();    									// Initialize clocks
+    Telemetry_init(resetReason);						// Start the UART telemetry stream
+    Remote_init();										// Take test commands over the UART
     myLCD_init();										// Initialize Liquid Crystal Display
+    Scores_load();										// Load high scores and statistics from FRAM
     PM5CTL0 = ENABLE_PINS;               				// Enable to turn on LEDs
 
     TA0CTL   = TA0CTL | (SMCLK + CONTINUOUS);			// SMCLK:  Counts faster than ACLK
                                                         // CONTINUOUS:  Count 0 to 0xFFFF
     TA0CCTL0 = CCIE;									// Timer_0 interrupt
 
-    TA1CTL   = TA1CTL | (ACLK  + UP);                   // Count up from 0 with ACLK
-    TA1CCR0  = MS_10;									// Duration approximatley 10ms
+    Timer_init();										// Timer_1 runs the software timers
+#ifdef LINK
+    Link_init();										// Link build: find another board to race
+#endif
 
     _BIS_SR(GIE);										// Activate all interrupts
 
+#ifdef BENCH
+    Bench_run();										// Benchmark build: time the display primitives
+#endif
+#ifdef PROFILE
+    Profile_start();									// Profile build: sample where the time goes
+#endif
+
+    resume = Checkpoint_load(&checkpoint);				// Was a game cut short by a reset?
+
 	while(1)											// Infinite loop
 	{
 		gameOver = 0;									// Reset gameOver flag back to 0 for new game
-		sequence = 0;									// Reset sequence back to 0 for new game
-		score    = 0;									// Reset the score back to 0 for new game
-
-		P1OUT = P1OUT | RED_ON;							// Turn on the red LED light
-		P9OUT = P9OUT | GREEN_ON;						// Turn on the green LED light
-
-		ScrollWords("PRESS S1 TO BEGIN");				// Scroll message across LCD
-
 
-		sequence = GetRandomSequence(sequence);			// Get a random sequence of LEDs for game
+		if(resume)										// If a game was cut short, pick it up at the
+		{												//  start of the round it was in
+			seed       = checkpoint.seed;
+			firstRound = checkpoint.round;
+			score      = checkpoint.score;
+			level      = checkpoint.level;
+			endless    = checkpoint.endless;
+			adaptive   = checkpoint.adaptive;
+			Sequence_resume(seed);						// The sequence is normally still in FRAM
+			resume = 0;
+			TRACE(TRACE_RESUME, firstRound);
+		}
+		else											// Otherwise start a new game
+		{
+			firstRound = 0;
+			score      = 0;							// Reset the score back to 0 for new game
+
+			P1OUT = P1OUT | RED_ON;						// Turn on the red LED light
+			P9OUT = P9OUT | GREEN_ON;					// Turn on the green LED light
+
+			TRACE(TRACE_PHASE, TRACE_PHASE_START);
+			ScrollMessage(MSG_PRESS_START);				// Scroll message across LCD
+
+			TRACE(TRACE_PHASE, TRACE_PHASE_WAIT);
+			seed = GetRandomSequence(&endless);			// Get a random sequence of LEDs for game
+			Remote_seed(&seed);							// A replay picks its own seed
+			Telemetry_seed(seed, endless);				// Report it, so the game can be replayed
+			Sequence_fill(seed);						// Pack the sequence into FRAM
+			TRACE(TRACE_PHASE, TRACE_PHASE_LEVEL);
+			level    = DIFFICULTY_NORMAL;				// A race takes the level of the board that
+			adaptive = 0;								//  started it
+			if(!LINK_INVITED)
+			{
+				level = GetDifficultyLevel(&adaptive);	// Let the user pick a difficulty level
+			}
+#ifdef LINK
+			if(Link_start(&seed, &level, &endless))		// Race the other board, if there is one
+			{
+				adaptive = 0;							// Both boards play at the same tempo
+				Telemetry_seed(seed, endless);			// Its game may have replaced ours
+				Sequence_fill(seed);
+			}
+#endif
+		}
+		TRACE(TRACE_GAME_START, level | (endless << 8) | (adaptive << 9));
+		Adaptive_start(adaptive, level, Difficulty_tempo(level, 0)->timeoutTicks);
+		Game_start(&game, firstRound, score, endless);
 
 		while(!gameOver)								// Keep looping while game is playing
 		{												//
-			for(i=0; i<16; i=i+1)						// This loops 16 times because we show the user
-			{											// a sequence of up to 16 LED blinks
+			for(i=firstRound; Game_playing(&game); i=i+1)	// This loops 16 times because we show
+			{											// the user a sequence of up to 16 LED blinks.
+														// An endless game keeps going until a mistake
+				Checkpoint_save(seed, i, game.score, level, endless, adaptive);	// Save the game at each round
+				Trace_spill();							// Keep the trace in FRAM, if enabled
+				Telemetry_trace();						// and send it over the UART
+				TRACE(TRACE_ROUND, i);
+				TRACE(TRACE_PHASE, TRACE_PHASE_INTRO);
+				tempo = Difficulty_tempo(level, i);		// Look up the timing for this round
 				P1OUT = P1OUT & RED_OFF;				// Turn off the red LED light
 				P9OUT = P9OUT & GREEN_OFF;				// Turn off the green LED light
-				delayCount = 50;						// Delay for (50*10ms) = 500ms
-				while(delayCount = delay(delayCount));	// Wait for delay to end
+				delayCount = tempo->introTicks;			// Delay for the round intro (500ms on NORMAL)
+				DelayTicks(delayCount);					// Sleep until the delay is over
 
 				if(!gameOver)							     // If the game isn't over yet
 				{
 					DisplayWord("ROUND");				     // Display word to LCD screen
-					delayCount = 50;					     // Delay for (50*10ms) = 500ms
-					while(delayCount = delay(delayCount));   // Wait for delay to be over
+					delayCount = tempo->introTicks;		     // Delay for the round intro
+					DelayTicks(delayCount);				     // Sleep until the delay is over
 					DisplayNumber(i+1);					     // Display number to LCD screen
-					delayCount = 50;					     // Delay for (50*10ms) = 500ms
-					while(delayCount = delay(delayCount));   // Wait for delay to be over
+					delayCount = tempo->introTicks;		     // Delay for the round intro
+					DelayTicks(delayCount);				     // Sleep until the delay is over
 
-					ShowSequence(sequence,i);			     // Show the user a sequence of LEDs
+					TRACE(TRACE_PHASE, TRACE_PHASE_PLAYBACK);
+					ShowSequence(i,tempo);				     // Show the user a sequence of LEDs
 
 					// User enters sequence of button pushes for LEDs
-					gameOver = GetUserSequence(sequence,gameOver,i);
-
-					if(!gameOver)						// If the user answered correctly
-					{
-						score += 1;						// Increment Score
-					}
+					TRACE(TRACE_PHASE, TRACE_PHASE_INPUT);
+					gameOver = GetUserSequence(&game,tempo);	// Scores the round if it's right
 				} // end if(!gameOver)
 				else									// Otherwise, if the game is over
 				{
 					break;								// Stop the game
 				}
-			} // end for(i=0; i<16; i=i+1)
+			} // end for(i=firstRound; Game_playing(&game); i=i+1)
 			gameOver = 1;								// If the user has played 16 rounds, end the
 														// game
 		} // end while(!gameOver)
+		score = game.score;
+
+		// Save the results to FRAM, once per game.  The checkpoint is cleared first so a reset
+		// in between can't resume a game that has already been counted
+		Checkpoint_clear();
+		race = LINK_NO_RACE;
+#ifdef LINK
+		if(Link_racing())								// Wait for the other board to finish
+		{
+			DisplayWord("WAIT");
+			race = Link_result();
+		}
+#endif
+		TRACE(TRACE_GAME_OVER, score);
+		TRACE(TRACE_STACK, Stack_highWater());
+#ifdef ISR_STATS
+		Isr_trace();									// Longest run and latest start of each ISR
+#endif
+		Trace_spill();
+		place = Scores_recordGame(score, level, endless, Game_won(&game));
+		Scores_commit();
+		Telemetry_trace();								// Send the rest of the trace, the result
+		Telemetry_game(score, level, endless, place);	//  and the counters
+		Telemetry_counter(COUNTER_CHECKPOINT_CYCLES, checkpointCycles);
+		Telemetry_counter(COUNTER_UART_DROPPED, uartDropped);
+		Telemetry_counter(COUNTER_STACK_USED, Stack_highWater());
+		Telemetry_counter(COUNTER_STACK_SIZE, Stack_size());
+#ifdef ISR_STATS
+		Isr_dump();
+#endif
+#ifdef PROFILE
+		Profile_dump();									// Where this game's time went
+#endif
 
 		// Loop in the GAME OVER message until user starts a new game
-		GameOverMessage(score);
+		TRACE(TRACE_PHASE, TRACE_PHASE_GAME_OVER);
+		GameOverMessage(score, Game_won(&game), place, race);
 	} // end while(1)
 } // end main
 
@@ -124,7 +263,10 @@ void main (void)
 #pragma vector=TIMER0_A0_VECTOR
 __interrupt void Timer_A0 (void)
 {
+	ISR_ENTER_AT(ISR_TIMER0, TA0CCR0);					// It is due when the count reaches CCR0 (0)
 	TA0CTL = TA0CTL & (~TAIFG);							// Reset Timer_0 so it keeps counting
+	traceEpoch = traceEpoch + 1;						// Timer_0 wrapped: count it for the trace
+	ISR_EXIT(ISR_TIMER0);
 }
 
 
@@ -147,6 +289,7 @@ void DisplayWord(char words[250])
 	char character;										// Current character to be displayed
 
 	clearLCD();											// Make sure that the LCD screen is blank
+	TRACE(TRACE_LCD_WORD, (uint8_t)words[0] | (words[0] ? (uint16_t)(uint8_t)words[1] << 8 : 0));	// Bytes, not signed chars
 	length = strlen(words);								// Get the length of the desired word
 	if (length<=6)										// If the word has 6 or less characters
 	{
@@ -183,7 +326,7 @@ void DisplayWord(char words[250])
 void DisplayMultipleWords(char words[250])
 {
 	void clearLCD(void);								// Declare functions used
-	int delay(int count);
+	void DelayTicks(int count);
 
 	unsigned int i;										// Used to get index of current character
 	unsigned int j;										// Used to get location of current character
@@ -208,7 +351,7 @@ void DisplayMultipleWords(char words[250])
 				else									// Otherwise, if the character is a space
 				{
 					delayCount = 40;					// Delay for (40*10ms) = 400ms between words
-					while(delayCount = delay(delayCount));// Wait for delay to be over
+					DelayTicks(delayCount);				// Sleep until the delay is over
 					clearLCD();							// Make sure that the LCD screen is blank
 					break;								// Break out of for(j = 1;j<=6;j++)
 				} // end else
@@ -216,7 +359,7 @@ void DisplayMultipleWords(char words[250])
 		} // end for(j = 1;j<=6;j++)
 	} // end for(i = 0;i<length;i++)
 	delayCount = 40;									// Delay for (40*10ms) = 400ms
-	while(delayCount = delay(delayCount));				// Wait for delay to be over
+	DelayTicks(delayCount);								// Sleep until the delay is over
 
 	clearLCD();											// Make sure that the LCD screen is blank
 } // end DisplayMultipleWords
@@ -234,13 +377,12 @@ void DisplayMultipleWords(char words[250])
 void ScrollWords(char words[250])
 {
 	void clearLCD(void);								// Declare functions used
-	int delay(int count);
+	void DelayTicks(int count);
+
+	void ScrollFrame(char words[250], unsigned int length, unsigned int offset);
 
-	unsigned int i;										// Used to get index of current character
-	unsigned int j;										// Used to get location of current character
 	unsigned int length;								// Keeps track of the length of the word
 	unsigned int delayCount;							// Determines the length of the delay
-	char character;										// Current character to be displayed
 	unsigned int offset;								// Offset window determines which six
 														//  characters will be displayed during each
 														//  shift
@@ -248,27 +390,13 @@ void ScrollWords(char words[250])
 	clearLCD();											// Make sure that the LCD screen is blank
 	length = strlen(words);								// Get the length of the desired message
 	offset=0;											// Start with an offset of 0
-	i=0;												// Start at index 0
 
 	while(offset<length+6)								// Loop as long as you haven't shifted all
 	{													// of the characters off the LCD screen
-		i=offset;										// Move index to the starting offset position
-		for(j = 1;j<=6;j=j+1)								// Loop through all of the LCD slots
-		{
-			character = words[i-6];						// Get the current character for LCD location
-			if(character && (i>=6) && (i<=length+6))	// If character exists and you haven't
-			{											//  reached the end of the message
-				myLCD_showChar(character,j);			// Show the character on the LCD
-			}
-			else										// Otherwise, if it doesn't exist...
-			{
-				myLCD_showChar(' ',j);					// Pad the rest of the locations with spaces
-			}
-			i++;										// Move on to the next character
-		} // end for(j = 1;j<=6;j++)
-
+		ScrollFrame(words, length, offset);				// Show the six characters at this offset
+		TRACE(TRACE_LCD_SCROLL, offset);
 		delayCount = 20;								// Delay for (20*10ms) = 200ms
-		while(delayCount=delay(delayCount));			// Wait for delay to be over
+		DelayTicks(delayCount);							// Sleep until the delay is over
 		offset = offset + 1;							// Increment offset to start one index
 														//  further than last time
 	}
@@ -276,6 +404,83 @@ void ScrollWords(char words[250])
 } // end ScrollWords
 
 
+//***************************************************************************************************
+// ScrollMessage()
+//
+// The function scrolls one of the packed messages in myMessageData.h across the LCD screen, the
+// same way ScrollWords() scrolls a string.  Each frame only draws the character coming in.
+//
+// This function has one argument and does not return a value.
+//
+//      Arg 1  - 'id' specifies the message, one of the MSG_xxx IDs
+//***************************************************************************************************
+void ScrollMessage(unsigned int id)
+{
+	void clearLCD(void);								// Declare functions used
+	void DelayTicks(int count);
+
+	MessageReader reader;								// Next character of the message
+	unsigned int length;								// Keeps track of the length of the message
+	unsigned int delayCount;							// Determines the length of the delay
+	unsigned int offset;								// How far the message has scrolled
+
+	clearLCD();											// The first frame is blank
+	length = Message_length(id);						// Get the length of the desired message
+	Message_open(&reader, id);
+
+	for(offset = 0; offset < length+6; offset++)		// Until the message has scrolled off the left
+	{
+		if(offset)										// Move it along, the next character in
+		{												//  at the right
+			Message_scroll(&reader);
+		}
+		TRACE(TRACE_LCD_SCROLL, offset);
+		delayCount = 20;								// Delay for (20*10ms) = 200ms
+		DelayTicks(delayCount);							// Sleep until the delay is over
+	}
+	clearLCD();											// Clear the LCD
+} // end ScrollMessage
+
+
+//***************************************************************************************************
+// ScrollFrame()
+//
+// The function shows one frame of a scrolling message: the six characters starting at 'offset',
+// where the message is preceded by six blanks and followed by blanks.
+//
+// This function has three arguments and does not return a value.
+//
+//      Arg 1  - 'words' specifies the text being scrolled
+//      Arg 2  - 'length' is the length of the text
+//      Arg 3  - 'offset' is how far the text has scrolled
+//***************************************************************************************************
+RAMFUNC void ScrollFrame(char words[250], unsigned int length, unsigned int offset)
+{
+	unsigned int i;										// Used to get index of current character
+	unsigned int j;										// Used to get location of current character
+	char character;										// Current character to be displayed
+
+	i=offset;											// Move index to the starting offset position
+	for(j = 1;j<=6;j=j+1)								// Loop through all of the LCD slots
+	{
+		character = 0;									// Blank before and after the message
+		if((i>=6) && (i<length+6))						// If the slot is within the message,
+		{
+			character = words[i-6];						//  get its character
+		}
+		if(character)									// If character exists
+		{
+			myLCD_showChar(character,j);				// Show the character on the LCD
+		}
+		else											// Otherwise, if it doesn't exist...
+		{
+			myLCD_showChar(' ',j);						// Pad the rest of the locations with spaces
+		}
+		i++;											// Move on to the next character
+	} // end for(j = 1;j<=6;j++)
+} // end ScrollFrame
+
+
 //***************************************************************************************************
 // DisplayNumber()
 //
@@ -285,7 +490,7 @@ void ScrollWords(char words[250])
 //
 //      Arg 1  - 'number' specifies the number that should appear on the LCD screen
 //***************************************************************************************************
-void DisplayNumber(unsigned long int number)
+RAMFUNC void DisplayNumber(unsigned long int number)
 {
 	void clearLCD(void);								// Declare functions used
 
@@ -296,6 +501,7 @@ void DisplayNumber(unsigned long int number)
 	int zeroFlag = 1;									// Flag that all leading 0s have been passed
 
 	clearLCD();											// Make sure that the LCD is blank
+	TRACE(TRACE_LCD_NUMBER, number);
 	if(number == 0)										// If the number is 0...
 	{
 	    myLCD_showChar('0', 6 );						// Show a 0 on the sixth LCD slot
@@ -339,10 +545,10 @@ void DisplayNumber(unsigned long int number)
 //
 // The function clears the LCD screen so that all slots display empty spaces.
 //***************************************************************************************************
-void clearLCD(void)
+RAMFUNC void clearLCD(void)
 {
 	int j;
-	for(j=0;j<=6;j=j+1)									// Loop through all LCD locations
+	for(j=1;j<=6;j=j+1)									// Loop through all LCD locations, 1 to 6
 	{
 		myLCD_showChar(' ',j);							// Pad all locations with spaces
 	}
@@ -352,43 +558,215 @@ void clearLCD(void)
 //***************************************************************************************************
 // delay()
 //
-// The function creates a delay in the program.
+// The function counts down a delay in Timer_1 ticks (about 12ms each).  Call it in a loop until
+// it returns 0.  If no tick has gone by since the last call, it sleeps in LPM0 until the next one,
+// so a loop that polls the buttons between calls polls them once a tick.
 //
-// This function has one argument and does not return a value.
+// This function has one argument and returns an integer value.
 //
-//      Arg 1  - 'count' specifies how many Timer_1 counting cycles to delay for
+//      Return - 'count' less one if a tick has gone by
+//      Arg 1  - 'count' specifies how many Timer_1 ticks are left to delay for
 //***************************************************************************************************
 int delay(int count)
 {
-	if(TA1CTL & TAIFG)									// If Timer_1 is done counting
+	int TickExpired(Timer *timer);						// Declare functions used
+
+	__disable_interrupt();
+	if(!ticked)											// If no tick has gone by since the last call
 	{
-		count = count-1;										// Decrement count
-		TA1CTL = TA1CTL & (~TAIFG);								// Reset Timer_1
+		if(!Timer_running(&tickTimer))
+		{
+			Timer_start(&tickTimer, 1, 0, TickExpired);	// Wake up at the next tick
+		}
+		__bis_SR_register(LPM0_bits | GIE);				// Sleep until then, keeping SMCLK for the UART
+	}
+	__enable_interrupt();
+
+	if(ticked)											// A remote button press can wake us sooner
+	{
+		ticked = 0;
+		count = count-1;								// Decrement count
 	}
 	return count;										// Return the value of count
 } // end delay
 
 
+//***************************************************************************************************
+// DelayTicks()
+//
+// The function sleeps for a delay of Timer_1 ticks in one go, for waits that don't poll anything.
+// It sets one timer for the end of the delay, so the CPU sleeps through the ticks in between
+// instead of waking at each one.  It ends on the same tick as a loop of delay() calls would,
+// counting a tick that went by before the call.
+//
+// This function has one argument and does not return a value.
+//
+//      Arg 1  - 'count' specifies how many Timer_1 ticks to delay for
+//***************************************************************************************************
+void DelayTicks(int count)
+{
+	int TickExpired(Timer *timer);						// Declare functions used
+
+	__disable_interrupt();
+	if(ticked)											// A tick went by since the last delay() call
+	{
+		ticked = 0;
+		count = count-1;
+	}
+	if(count > 0)
+	{
+		Timer_start(&tickTimer, count, 0, TickExpired);	// Wake up at the last tick of the delay
+		while(!ticked)									// A remote button press can wake us sooner
+		{
+			__bis_SR_register(LPM0_bits | GIE);			// Sleep, keeping SMCLK for the UART
+			__disable_interrupt();
+		}
+		ticked = 0;
+	}
+	__enable_interrupt();
+} // end DelayTicks
+
+
+//***************************************************************************************************
+// TickExpired()
+//
+// The callback of the timer delay() sleeps on.  It runs in the Timer_1 interrupt.
+//
+//      Return - '1' to wake the CPU
+//      Arg 1  - 'timer' is the timer that expired
+//***************************************************************************************************
+int TickExpired(Timer *timer)
+{
+	(void)timer;
+	ticked = 1;											// Tell delay() a tick has gone by
+	return 1;
+} // end TickExpired
+
+
 //***************************************************************************************************
 // GetRandomSequence()
 //
-// The function uses a timer to get a random sequence of LEDs to show the user.
+// The function waits for the user to press button 1 (normal game) or button 2 (endless game) and
+// then gets a random seed for the sequence of LEDs to show the user.  While it waits, it feeds the
+// entropy pool with Timer_0 jitter, the beat between the LFXT crystal and the DCO, and the exact
+// moment the button was pressed.  If no button is pressed for STANDBY_DISPLAY_SECONDS, it goes
+// into standby until one is.
 //
-// This function has one argument and returns an integer value.
+// This function has one argument and returns an unsigned long value.
 //
-//      Return - 'sequence' specifies the 16 bit sequence that will be displayed to the user
-//		Arg 1  - 'sequence' specifies the 16 bit sequence that will be displayed to the user
+//      Return - 'seed' specifies the seed that every step of the LED sequence is generated from
+//      Arg 1  - 'endless' is set to 1 if the user picked an endless game, or 0 otherwise
 //***************************************************************************************************
-int GetRandomSequence(int sequence)
+unsigned long GetRandomSequence(int *endless)
 {
-	while(!sequence)									// While we haven't set sequence to anything
+	int delay(int count);								// Declare functions used
+
+	unsigned int polls = 0;								// Number of times the buttons were polled
+	int idleCount = (int)TIMER_TICKS(STANDBY_DISPLAY_SECONDS * 1000UL);	// Time left before standby, in Timer_1 ticks
+
+	Random_sampleClockBeat();							// Sample the LFXT/DCO beat
+	while((BUTTON1 & BUTTONS_IN) && (BUTTON2 & BUTTONS_IN) && !LINK_INVITED)	// Wait for button 1 or button 2
+	{													//  to be pressed, or another board to start a race
+		Random_stir(TA0R);								// Timer_0 jitter between polls
+		polls = polls + 1;
+		idleCount = delay(idleCount);
+		if(!idleCount)									// If nobody pressed a button for a while
+		{
+			Power_deepSleep();							// Sleep with the LCD off until a button
+			idleCount = (int)TIMER_TICKS(STANDBY_DISPLAY_SECONDS * 1000UL);
+		}
+	}
+	*endless = ((BUTTON2 & BUTTONS_IN) == 0);			// Button 2 starts an endless game
+	Random_stir(TA0R ^ polls);							// When exactly the button was pressed
+	Random_sampleClockBeat();							// Sample the beat again after the press
+	Random_sampleAdc();									// ADC noise, if RANDOM_USE_ADC is defined
+	Random_seed();										// Seed the generator from the pool
+
+	return Random_next();
+}
+
+
+//***************************************************************************************************
+// GetDifficultyLevel()
+//
+// The function lets the user pick a difficulty level with a combination of buttons.  Button 1 on
+// its own picks EASY, button 2 on its own picks HARD, and both buttons together pick NORMAL.  The
+// buttons count as pressed together if the second one goes down within 100ms of the first.
+// Holding the combination for a second turns on adaptive mode, where the tempo of the level
+// follows how well the user is doing.
+//
+// This function has one argument and returns an unsigned integer value.
+//
+//      Return - 'level' specifies the difficulty level the user picked
+//      Arg 1  - 'adaptive' is set to 1 if the user held the buttons for adaptive mode, 0 otherwise
+//***************************************************************************************************
+unsigned int GetDifficultyLevel(int *adaptive)
+{
+	int delay(int count);								// Declare functions used
+	void DelayTicks(int count);
+	void DisplayWord(char words[250]);
+
+	int delayCount;										// Determines how long the delay will be
+	unsigned int pressed = 0;							// Buttons seen pressed during the combination
+	unsigned int level;									// Difficulty level picked by the user
+
+	DisplayWord("LEVEL");								// Display word to LCD
+	while(!(BUTTON1 & BUTTONS_IN) || !(BUTTON2 & BUTTONS_IN))	// Wait for the start button to be released,
+	{
+		DelayTicks(1);									//  sleeping a tick (10ms) at a time
+	}
+	delayCount = 3;										// Delay for (3*10ms) = 30ms
+	DelayTicks(delayCount);								// Sleep until the delay is over
+
+	while((BUTTON1 & BUTTONS_IN) && (BUTTON2 & BUTTONS_IN))	// Wait for a button to be pressed, in standby
+	{
+		if(!Power_sleep(STANDBY_DISPLAY_SECONDS))		// If nobody pressed a button for a while,
+		{
+			Power_deepSleep();							// Turn off the LCD and sleep deeper
+		}
+	}
+	delayCount = 10;									// Give the second button 100ms to join in
+	while(delayCount)
+	{
+		pressed = pressed | (~BUTTONS_IN & (BUTTON1 | BUTTON2));	// Remember every button pressed
+		delayCount = delay(delayCount);
+	}
+
+	if(pressed == BUTTON1)								// Button 1 on its own
+	{
+		level = DIFFICULTY_EASY;
+	}
+	else if(pressed == BUTTON2)							// Button 2 on its own
+	{
+		level = DIFFICULTY_HARD;
+	}
+	else												// Both buttons together
+	{
+		level = DIFFICULTY_NORMAL;
+	}
+
+	DisplayWord((char *)difficultyName[level]);			// Show the level that was picked
+	delayCount = 90;									// Held for another 900ms (1s in all)...
+	while(!(BUTTON1 & BUTTONS_IN) || !(BUTTON2 & BUTTONS_IN))	// Wait for the buttons to be released
 	{
-		if(!(BUTTON1 & P1IN))							// Check to see if button 1 is pressed
+		if(delayCount)
 		{
-			sequence = TA0R;							// Set sequence equal to the current value
-		}												//  that Timer_0 has counted up to
+			delayCount = delay(delayCount);
+			if(!delayCount)								// ...turns on adaptive mode
+			{
+				DisplayWord("AUTO");
+			}
+		}
+		else
+		{
+			DelayTicks(1);								// Sleep a tick at a time until they are
+		}
 	}
-	return sequence;
+	*adaptive = (delayCount == 0);
+	delayCount = 50;									// Delay for (50*10ms) = 500ms
+	DelayTicks(delayCount);								// Sleep until the delay is over
+
+	return level;
 }
 
 
@@ -399,37 +777,40 @@ int GetRandomSequence(int sequence)
 //
 // This function has two arguments and does not return anything.
 //
-//      Arg 1  - 'sequence' specifies the 16 bit sequence that the user is trying to enter
-//      Arg 2  - 'i' determines how many blinking LEDs to display
+//      Arg 1  - 'i' determines how many blinking LEDs to display
+//      Arg 2  - 'tempo' specifies how long each LED is off and on
 //***************************************************************************************************
-void ShowSequence(int sequence, int i)
+void ShowSequence(unsigned int i, const Tempo *tempo)
 {
-	int delay(int count);								// Declare functions used
+	void DelayTicks(int count);							// Declare functions used
 	void DisplayWord(char words[250]);
 
 	int segment;										// Designates a segment of the entire
 														// sequence to display
 	int delayCount;										// Determines how long each delay should be
-	int k;												// Used in the for loop to display i blinks
+	unsigned int k;										// Used in the for loop to display i blinks
+	SequenceIter it;									// Walks through the steps of the sequence
 
+	Sequence_begin(&it);								// Start at the first step
 	for(k=0;k<=i;k=k+1)									// Makes sure to show the correct
 	{													//  number of LEDs
 		DisplayWord("WATCH"); 							// Display word to LCD
-		delayCount = 25;								// Delay for (25*10ms) = 250ms
-		while(delayCount = delay(delayCount));			// Wait for the delay to be over
-		segment = (sequence >> k) & 0x01;				// Determines which LED should be on
+		delayCount = Adaptive_ticks(tempo->offTicks);	// Delay for the off time (250ms on NORMAL)
+		DelayTicks(delayCount);							// Sleep until the delay is over
+		segment = Sequence_next(&it);					// Determines which LED should be on
+		TRACE(TRACE_LED, segment);
 		if (segment == 0)								// If we want the red LED
 		{
 			P1OUT = P1OUT | RED_ON; 					// Turn on the red LED
 			P9OUT = P9OUT & GREEN_OFF; 					// Turn off the green LED
 		}
-		else											// Otherwise if we want the Green LED
+		else if (segment == 1)							// Otherwise if we want the Green LED
 		{
 			P9OUT = P9OUT | GREEN_ON; 					// Turn on the green LED
 			P1OUT = P1OUT & RED_OFF; 					// Turn off the red LED
 		}
-		delayCount = 25;								// Delay for (25*10ms) = 250ms
-		while(delayCount = delay(delayCount));			// Wait for the delay to be over
+		delayCount = Adaptive_ticks(tempo->onTicks);	// Delay for the on time (250ms on NORMAL)
+		DelayTicks(delayCount);							// Sleep until the delay is over
 		P1OUT &= RED_OFF;								// Turn off the red LED
 		P9OUT &= GREEN_OFF;								// Turn off the green LED
 	} // end for(k=0;k<=i;k+=1)
@@ -440,72 +821,91 @@ void ShowSequence(int sequence, int i)
 // GetUserSequence()
 //
 // The function checks to make sure that the user enters the correct sequence of button pushes.
+// If the user takes longer than the round's timeout to press a button, the game is over.  Each
+// press and timeout is scored by the rules in myGame.c.
 //
-// This function has three arguments and returns either '0' or '1'.
+// This function has two arguments and returns either '0' or '1'.
 //
 //      Return - 'gameOver' tells the program whether or not the user entered a correct sequence
-//      Arg 1  - 'sequence' specifies the 16 bit sequence that the user is trying to enter
-//      Arg 2  - 'gameOver' determines whether or not the user has entered a correct sequence
-//      Arg 3  - 'i' determines how many buttons pushes the function look for
+//      Arg 1  - 'game' is the game being played; its round determines how many button pushes
+//               the function looks for
+//      Arg 2  - 'tempo' specifies how long to wait for each button push
 //***************************************************************************************************
-int GetUserSequence(int sequence, int gameOver, int i)
+int GetUserSequence(Game *game, const Tempo *tempo)
 {
 	void DisplayWord(char words[250]);					// Declare functions used
 	int delay(int count);
+	void DelayTicks(int count);
 
-	int btn_counts=0;									// Keeps track of how many buttons the user
-														//  has pressed
+	unsigned int i = game->round;						// Round being answered
 	int delayCount;										// Determines how long the delay will be
-	int segment;										// Determines which button the user should be
-														//  pressing
-														//  Can have 2 different values
-														//  0 - The user should press BUTTON1
-														//  1 - The user should press BUTTON2
+	int timeoutCount;									// Time left to press the next button
+	int right;											// Was the right button pressed?
 
+	Game_begin(game);									// Start at the first step
+	timeoutCount = tempo->timeoutTicks;					// Start timing the first button push
 	DisplayWord("GO");									// Display word to LCD
-	while((btn_counts<=i) && !gameOver) 				// Wait for button input as long as the user
+	while((game->round == i) && !game->over) 			// Wait for button input as long as the user
 	{													//  hasn't entered a wrong sequence or
 														//  hasn't gotten all of them right
-		if((BUTTON1 & P1IN) == 0)						// Check if button 1 is pushed
+		if((BUTTON1 & BUTTONS_IN) == 0)					// Check if button 1 is pushed
 		{
-			while((BUTTON1 & P1IN) == 0)				// This loop accounts for button bounce
+			TRACE(TRACE_BUTTON_DOWN, 1);
+			while((BUTTON1 & BUTTONS_IN) == 0)			// This loop accounts for button bounce
 			{
 				P1OUT = P1OUT | RED_ON;					// Turn on the red LED
 				delayCount = 3;							// Delay for (3*10ms) = 30ms
-				while(delayCount=delay(delayCount));	// Wait for delay to be over
+				DelayTicks(delayCount);					// Sleep until the delay is over
 			}
 			P1OUT = P1OUT & RED_OFF;					// Turn off the red LED
+			TRACE(TRACE_BUTTON_UP, 1);
 
-			segment = (sequence >> btn_counts) & 0x01;	// Determines which button
-														// should have been pressed
-			if(segment != 0)							// If the user pressed the wrong button
+			right = (Game_press(game, 0) != GAME_WRONG);	// Button 1 is step 0
+			Adaptive_press(tempo->timeoutTicks - timeoutCount, right);
+			Telemetry_press(i, tempo->timeoutTicks - timeoutCount, right);
+			LINK_PRESSED(i, game->steps, !right);		// Tell the other board, if racing
+			if(!right)									// If the user pressed the wrong button
 			{
-				gameOver = 1;							// GAME OVER
-				break;									// Stop waiting for more button presses
+				break;									// GAME OVER
 			}
-			btn_counts = btn_counts + 1;				// Incrememnt number of times a button has
-		}												//  been pressed
-		else if((BUTTON2 & P1IN) == 0)					// Check if button 2 is pushed
+			timeoutCount = tempo->timeoutTicks;			// Restart the timeout
+		}
+		else if((BUTTON2 & BUTTONS_IN) == 0)			// Check if button 2 is pushed
 		{
-			while((BUTTON2 & P1IN) == 0)				// This loop accounts for button bounce
+			TRACE(TRACE_BUTTON_DOWN, 2);
+			while((BUTTON2 & BUTTONS_IN) == 0)			// This loop accounts for button bounce
 			{
 				P9OUT = P9OUT | GREEN_ON;				// Turn on the green LED
 				delayCount = 3;							// Delay for (3*10ms) = 30ms
-				while(delayCount=delay(delayCount));	// Wait for delay to be over
+				DelayTicks(delayCount);					// Sleep until the delay is over
 			}
 			P9OUT &= GREEN_OFF;							// Turn off the green LED
+			TRACE(TRACE_BUTTON_UP, 2);
 
-			segment = (sequence >> btn_counts) & 0x01;	// Determines which button
-														//  should have been pressed
-			if(segment == 0)							// If the user pressed the wrong button
+			right = (Game_press(game, 1) != GAME_WRONG);	// Button 2 is step 1
+			Adaptive_press(tempo->timeoutTicks - timeoutCount, right);
+			Telemetry_press(i, tempo->timeoutTicks - timeoutCount, right);
+			LINK_PRESSED(i, game->steps, !right);		// Tell the other board, if racing
+			if(!right)									// If the user pressed the wrong button
 			{
-				gameOver = 1;							// GAME OVER
-				break;									// Stop waiting for more button presses
+				break;									// GAME OVER
 			}
-			btn_counts = btn_counts + 1;				// Increment number of times a button has
-		}												//  been pressed
+			timeoutCount = tempo->timeoutTicks;			// Restart the timeout
+		}
+		else											// If no button is pushed
+		{
+			timeoutCount = delay(timeoutCount);			// Count down the timeout
+			if(!timeoutCount)							// If the user took too long
+			{
+				Adaptive_press(tempo->timeoutTicks, 0);
+				Telemetry_press(i, tempo->timeoutTicks, 0);
+				LINK_PRESSED(i, game->steps, 1);
+				TRACE(TRACE_TIMEOUT, i);
+				Game_timeout(game);						// GAME OVER
+			}
+		}
 	}
-	return gameOver;									// Return the gameOver state
+	return game->over;									// Return the gameOver state
 }
 
 
@@ -514,33 +914,53 @@ int GetUserSequence(int sequence, int gameOver, int i)
 //
 // The function shows the user a game over message on the LCD screen.
 //
-// This function has one argument and does not return anything.
+// This function has four arguments and does not return anything.
 //
 //      Arg 1  - 'score' specifies the user's score at the end of the game
+//      Arg 2  - 'won' tells whether the user answered every round of a normal game
+//      Arg 3  - 'place' specifies the score's place in the high score table (0 is the best), or -1
+//      Arg 4  - 'race' tells how a race against another board went (LINK_xxx), or LINK_NO_RACE
 //***************************************************************************************************
-void GameOverMessage(int score)
+void GameOverMessage(unsigned int score, int won, int place, int race)
 {
-	void ScrollWords(char words[250]);					// Declare functions used
+	void ScrollMessage(unsigned int id);				// Declare functions used
 	void DisplayNumber(unsigned long int number);
 
 	P1OUT = P1OUT | RED_ON;								// Turn on the red LED
 	P9OUT = P9OUT | GREEN_ON;							// Turn on the green LED
 
-	if(score == 16)										// If the user answered everything correctly
+	if(place == 0)										// If this is the best score so far
+	{
+		ScrollMessage(MSG_NEW_HIGH_SCORE);				// Scroll message across LCD screen
+	}
+
+	if(race == LINK_LOST)								// If the other board won the race
 	{
-		ScrollWords("YOU WIN");							// Scroll message across LCD screen
+		ScrollMessage(MSG_YOU_LOSE);					// Scroll message across LCD screen
+		DisplayNumber(score);							// Display number to LCD screen
+	}
+	else if((race == LINK_WON) || won)				// If the user won the race, or
+	{													//  answered everything correctly
+		ScrollMessage(MSG_YOU_WIN);						// Scroll message across LCD screen
 	}
 	else												// Otherwise if they didn't get everything
 	{													//  correct
-		ScrollWords("GAME OVER FINAL SCORE");			// Scroll words across LCD screen
+		ScrollMessage(MSG_GAME_OVER);					// Scroll words across LCD screen
 		DisplayNumber(score);							// Display number to LCD screen
 	}
 
 	while(1)											// Loops as long as the user hasn't reset the
 	{													//  game
-		if(!(BUTTON1 & P1IN)&&!(BUTTON2 & P1IN))		// If both buttons are pressed
+		if(!(BUTTON1 & BUTTONS_IN)&&!(BUTTON2 & BUTTONS_IN))	// If both buttons are pressed
 		{
 			break;										// Break out of the infinite loop to start a
 		}												//  new game
+		else if((BUTTON1 & BUTTONS_IN)&&(BUTTON2 & BUTTONS_IN))	// If no button is pressed, sleep with the
+		{												//  message still showing until one is
+			if(!Power_sleep(STANDBY_DISPLAY_SECONDS))	// If nobody pressed a button for a while,
+			{
+				Power_deepSleep();						// Turn off the LCD and sleep deeper
+			}
+		}
 	}
 }
@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// myAdaptive.c  ('FR6989 Launchpad)
+//
+// Closed-loop tempo controller for the adaptive mode.
+//
+// The controller keeps running averages of the player's success rate and
+// reaction time, and turns them into a scale factor for the LED off/on times
+// of the current difficulty level. A player who gets more than the target
+// share of presses right, quickly, gets faster playback; a player who makes
+// mistakes or hesitates gets slower playback.
+//
+// A normal game only ends on a mistake, so the presses of one game are all
+// right but the last. The controller therefore carries on from one game to
+// the next, in RAM: the mistake that ended a game slows the start of the
+// next one. It only starts again from 1.0 on a change of level, or after a
+// reset.
+//
+// Everything is integer fixed point (Q8, 256 = 1.0) and each update is a
+// fixed handful of adds and shifts, so the cost per press and per LED step
+// is constant.
+//
+// "simboard --adaptive" plays the controller against a thousand simulated
+// players of different speed on each level (tools/sim/adaptive.c). All of
+// those it can reach settle between 80% and 97% success per press, with a
+// median of 86% to 91%. Only players too slow for the level even at 2x
+// stay at the slowest playback, most of them on HARD.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include "myAdaptive.h"
+#include "myDifficulty.h"
+
+
+//***** Defines ***************************************************************
+#define AVERAGE_SHIFT               3                                           // Running averages weigh each press 1/8
+#define GAIN_P                      4                                           // Scale change per unit of success error (divisor)
+#define GAIN_RT                     64                                          // Scale change per tick of reaction error (divisor)
+
+
+//***** Global Variables ******************************************************
+static int      enabled    = 0;                                                 // Is adaptive mode on for this game?
+static int16_t  scale      = ADAPTIVE_ONE;                                      // Controller output, Q8
+static int16_t  successAvg = ADAPTIVE_TARGET_P;                                 // Running success rate, Q8
+static int16_t  reactAvg   = 0;                                                 // Running reaction time, Q4 ticks
+static int16_t  reactGoal  = 0;                                                 // Target reaction time, ticks
+static uint8_t  learnedOn  = DIFFICULTY_LEVELS;                                 // Level the state was learned on (none yet)
+
+
+//*****************************************************************************
+// Adaptive_start()
+//
+// Starts a game. An adaptive game on the same level as the last one keeps
+// the controller as that game left it. On another level the controller is
+// reset, with the averages on their targets so the first few presses don't
+// swing the tempo. A game without adaptive mode leaves it alone.
+//
+// Arg 1: "on" turns adaptive mode on (1) or off (0) for this game
+// Arg 2: "level" is the game's DIFFICULTY_xxx level
+// Arg 3: "timeoutTicks" is the level's button timeout; the controller aims
+//        for reactions of a quarter of it
+//*****************************************************************************
+void Adaptive_start( int on, unsigned int level, uint16_t timeoutTicks )
+{
+    enabled = on;
+    if ( !on || level == learnedOn )
+    {
+        return;
+    }
+
+    learnedOn  = level;
+    scale      = ADAPTIVE_ONE;
+    successAvg = ADAPTIVE_TARGET_P;
+    reactGoal  = (int16_t)( timeoutTicks / 4 );
+    reactAvg   = reactGoal * 16;
+}
+
+//*****************************************************************************
+// Adaptive_press()
+//
+// Updates the controller with one button press (or timeout).
+//
+// Arg 1: "reactTicks" is the time since the previous press (or "GO"), in ticks
+// Arg 2: "correct" is 1 if the right button was pressed, 0 otherwise
+//*****************************************************************************
+void Adaptive_press( uint16_t reactTicks, int correct )
+{
+    int16_t errorP;
+    int16_t errorRt;
+
+    if ( !enabled )
+    {
+        return;
+    }
+
+    if ( reactTicks > 0x07FF )
+    {
+        reactTicks = 0x07FF;                                                    // Keep the Q4 value in 16 bits
+    }
+
+    successAvg += ( ( correct ? ADAPTIVE_ONE : 0 ) - successAvg ) / ( 1 << AVERAGE_SHIFT );
+    reactAvg   += ( (int16_t)( reactTicks * 16 ) - reactAvg ) / ( 1 << AVERAGE_SHIFT );
+
+    errorP  = ADAPTIVE_TARGET_P - successAvg;                                   // > 0: too many mistakes
+    errorRt = reactAvg / 16 - reactGoal;                                        // > 0: too slow
+
+    scale += errorP / GAIN_P + errorRt / GAIN_RT;
+
+    if ( scale < ADAPTIVE_SCALE_MIN )
+    {
+        scale = ADAPTIVE_SCALE_MIN;
+    }
+    else if ( scale > ADAPTIVE_SCALE_MAX )
+    {
+        scale = ADAPTIVE_SCALE_MAX;
+    }
+}
+
+//*****************************************************************************
+// Adaptive_ticks()
+//
+// Returns a tempo time scaled by the controller output, never less than one
+// tick. When adaptive mode is off the time is returned unchanged.
+//
+// Arg 1: "ticks" is the time from the difficulty level's tempo table
+//*****************************************************************************
+uint16_t Adaptive_ticks( uint16_t ticks )
+{
+    uint32_t scaled;
+
+    if ( !enabled )
+    {
+        return ticks;
+    }
+
+    scaled = ( (uint32_t)ticks * (uint16_t)scale ) >> 8;
+    if ( scaled == 0 )
+    {
+        scaled = 1;
+    }
+    return (uint16_t)scaled;
+}
@@ -0,0 +1,23 @@
+/*
+ * myAdaptive.h
+ *
+ */
+
+#ifndef MYADAPTIVE_H_
+#define MYADAPTIVE_H_
+
+#include <stdint.h>
+
+//***** Prototypes ************************************************************
+void     Adaptive_start( int, unsigned int, uint16_t );                         // Start a game; a new level resets the controller
+void     Adaptive_press( uint16_t, int );                                       // Feed back one button press
+uint16_t Adaptive_ticks( uint16_t );                                            // Scale a tempo time by the controller output
+
+//***** Defines ***************************************************************
+#define ADAPTIVE_ONE                256                                         // 1.0 in the controller's Q8 fixed point
+#define ADAPTIVE_TARGET_P           230                                         // Target success probability per press (0.9 in Q8)
+#define ADAPTIVE_SCALE_MIN          64                                          // Fastest playback: 0.25x the level's times
+#define ADAPTIVE_SCALE_MAX          512                                         // Slowest playback: 2x the level's times
+
+
+#endif /* MYADAPTIVE_H_ */
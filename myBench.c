@@ -0,0 +1,235 @@
+// ----------------------------------------------------------------------------
+// myBench.c  ('FR6989 Launchpad)
+//
+// Cycle counts for the display primitives the game leans on, and for
+// reading a step of the packed sequence store.
+//
+// Each primitive is timed BENCH_RUNS times, with its arguments varied from
+// run to run, and the shortest, median and longest times are sent as
+// TELEMETRY_BENCH frames; tools/telemetry.c prints them. The median of an
+// empty sample is taken off every time, so the results are the cost of the
+// call alone.
+//
+// Timer_A can't count MCLK, so Timer_0 counts SMCLK, and the counts are
+// scaled up to MCLK cycles: a result is good to a couple of cycles (eight
+// with CLOCKS_16MHZ). Interrupts are held off while a sample is taken, so
+// a tick or a UART interrupt doesn't land in it. A sample must be shorter
+// than one Timer_0 period (65536 SMCLK counts, 32ms).
+//
+// To compare clock settings, compare times rather than cycles: at 16MHz a
+// cycle is a quarter as long, but FRAM's wait state adds cycles to code
+// that runs from it. tools/telemetry.c prints the median time too, from
+// the MCLK rate in the HELLO frame. BENCH_BURST_RENDER is the throughput
+// of the display path, a whole scrolling message rendered back to back;
+// BENCH_MESSAGE_BURST is the same message scrolled by myMessage.c.
+//
+// The suite also builds for the simulated board in tools/sim, to check the
+// plumbing; the counts there aren't cycles, since simulated code takes no
+// time.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myBench.h"
+#include "myClocks.h"
+#include "myLcd.h"
+#include "myMessage.h"
+#include "mySequence.h"
+#include "myTelemetry.h"
+
+#ifdef BENCH
+
+//***** Defines ***************************************************************
+#define CYCLES_PER_COUNT    ( myMCLK_FREQUENCY_IN_HZ / mySMCLK_FREQUENCY_IN_HZ )
+
+
+//***** Prototypes ************************************************************
+void DisplayWord(char words[250]);                                              // In main.c
+void DisplayNumber(unsigned long int number);
+void clearLCD(void);
+void ScrollFrame(char words[250], unsigned int length, unsigned int offset);
+
+
+//***** Global Variables ******************************************************
+static uint32_t samples[ BENCH_RUNS ];
+static MessageReader reader;                                                    // For the message primitives
+
+
+//*****************************************************************************
+// The primitives, each called for run 'k'
+//*****************************************************************************
+static void Bench_nothing( unsigned int k )
+{
+    (void)k;
+}
+
+static void Bench_showChar( unsigned int k )
+{
+    myLCD_showChar( 'A' + k % 26, 1 + k % 6 );
+}
+
+static void Bench_displayWord( unsigned int k )
+{
+    (void)k;
+    DisplayWord( "LEVEL" );
+}
+
+static void Bench_displayNumber( unsigned int k )
+{
+    DisplayNumber( 123456 + k );
+}
+
+static void Bench_lcdDisplayNumber( unsigned int k )
+{
+    myLCD_displayNumber( (unsigned long)k * 7919 );
+}
+
+static void Bench_showSymbol( unsigned int k )
+{
+    myLCD_showSymbol( LCD_TOGGLE, k % ( LCD_A4COL + 1 ), LCD_MEMORY_MAIN );
+}
+
+static void Bench_clearLcd( unsigned int k )
+{
+    (void)k;
+    clearLCD();
+}
+
+static void Bench_scrollFrame( unsigned int k )
+{
+    ScrollFrame( "PRESS S1 OR S2 FOR ENDLESS", 26, k % 32 );
+}
+
+static void Bench_burstRender( unsigned int k )
+{
+    unsigned int offset;
+
+    (void)k;
+    for ( offset = 0; offset < BENCH_BURST_FRAMES; offset++ )
+    {
+        ScrollFrame( "PRESS S1 OR S2 FOR ENDLESS", 26, offset );
+    }
+}
+
+static void Bench_messageChar( unsigned int k )
+{
+    if ( k % Message_length( MSG_PRESS_START ) == 0 )
+    {
+        Message_open( &reader, MSG_PRESS_START );
+    }
+    Message_showGlyph( Message_next( &reader ), 1 + k % 6 );
+}
+
+static void Bench_messageFrame( unsigned int k )
+{
+    if ( k % BENCH_BURST_FRAMES == 0 )
+    {
+        Message_open( &reader, MSG_PRESS_START );
+    }
+    Message_scroll( &reader );
+}
+
+static void Bench_messageBurst( unsigned int k )
+{
+    unsigned int offset;
+
+    (void)k;
+    Message_open( &reader, MSG_PRESS_START );
+    for ( offset = 1; offset < BENCH_BURST_FRAMES; offset++ )                   // Frame 0 is the blank screen
+    {
+        Message_scroll( &reader );
+    }
+}
+
+static void Bench_sequence1( unsigned int k )
+{
+    BENCH_Sequence_extract( 1, k );
+}
+
+static void Bench_sequence2( unsigned int k )
+{
+    BENCH_Sequence_extract( 2, k );
+}
+
+static void Bench_sequence3( unsigned int k )
+{
+    BENCH_Sequence_extract( 3, k );
+}
+
+static void (* const bench[ BENCH_COUNT ])( unsigned int ) =                    // Indexed by BENCH_xxx
+{
+    Bench_nothing,
+    Bench_showChar,
+    Bench_displayWord,
+    Bench_displayNumber,
+    Bench_lcdDisplayNumber,
+    Bench_showSymbol,
+    Bench_clearLcd,
+    Bench_scrollFrame,
+    Bench_burstRender,
+    Bench_messageChar,
+    Bench_messageFrame,
+    Bench_messageBurst,
+    Bench_sequence1,
+    Bench_sequence2,
+    Bench_sequence3
+};
+
+
+//*****************************************************************************
+// Bench_time()
+//
+// Times every run of one primitive into samples[], in MCLK cycles less
+// 'overhead', and sorts them.
+//
+// Arg 1: "id" is one of the BENCH_xxx IDs
+// Arg 2: "overhead" is the cost of an empty sample
+//*****************************************************************************
+static void Bench_time( unsigned int id, uint32_t overhead )
+{
+    unsigned int k, j;
+    uint16_t state;
+    uint16_t start;
+    uint32_t cycles;
+
+    for ( k = 0; k < BENCH_RUNS; k++ )
+    {
+        state = __get_interrupt_state();
+        __disable_interrupt();
+        start = TA0R;
+        bench[ id ]( k );
+        cycles = (uint32_t)(uint16_t)( TA0R - start ) * CYCLES_PER_COUNT;
+        __set_interrupt_state( state );
+
+        cycles = ( cycles > overhead ) ? cycles - overhead : 0;
+        for ( j = k; j > 0 && samples[ j - 1 ] > cycles; j-- )                  // Insertion sort, as they come
+        {
+            samples[j] = samples[ j - 1 ];
+        }
+        samples[j] = cycles;
+    }
+}
+
+//*****************************************************************************
+// Bench_run()
+//
+// Times each primitive and sends the results. The LCD is left cleared.
+//*****************************************************************************
+void Bench_run( void )
+{
+    unsigned int id;
+    uint32_t overhead;
+
+    Bench_time( BENCH_OVERHEAD, 0 );
+    overhead = samples[ BENCH_RUNS / 2 ];
+    Telemetry_bench( BENCH_OVERHEAD, BENCH_RUNS, samples[0], overhead, samples[ BENCH_RUNS - 1 ] );
+
+    for ( id = BENCH_OVERHEAD + 1; id < BENCH_COUNT; id++ )
+    {
+        Bench_time( id, overhead );
+        Telemetry_bench( id, BENCH_RUNS, samples[0], samples[ BENCH_RUNS / 2 ], samples[ BENCH_RUNS - 1 ] );
+    }
+    clearLCD();
+}
+
+#endif /* BENCH */
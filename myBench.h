@@ -0,0 +1,42 @@
+/*
+ * myBench.h
+ *
+ */
+
+#ifndef MYBENCH_H_
+#define MYBENCH_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+// Define BENCH in the project's predefined symbols (a Bench build
+// configuration) to time the display primitives and the sequence store at
+// startup. Without it the suite compiles to nothing.
+#define BENCH_RUNS                  64                                          // Times each primitive is timed
+
+// Benchmark IDs, as sent in TELEMETRY_BENCH frames.
+// Keep tools/telemetry.c in step with this list.
+#define BENCH_OVERHEAD              0                                           // An empty sample, taken off the others
+#define BENCH_SHOW_CHAR             1                                           // myLCD_showChar()
+#define BENCH_DISPLAY_WORD          2                                           // DisplayWord() of a five letter word
+#define BENCH_DISPLAY_NUMBER        3                                           // DisplayNumber() of a six digit number
+#define BENCH_LCD_DISPLAY_NUMBER    4                                           // myLCD_displayNumber()
+#define BENCH_SHOW_SYMBOL           5                                           // myLCD_showSymbol()
+#define BENCH_CLEAR_LCD             6                                           // clearLCD()
+#define BENCH_SCROLL_FRAME          7                                           // One frame of ScrollWords()
+#define BENCH_BURST_RENDER          8                                           // All BENCH_BURST_FRAMES frames of a message
+#define BENCH_MESSAGE_CHAR          9                                           // Message_next() and Message_showGlyph()
+#define BENCH_MESSAGE_FRAME         10                                          // One frame of ScrollMessage()
+#define BENCH_MESSAGE_BURST         11                                          // BENCH_BURST_RENDER, with Message_scroll()
+#define BENCH_SEQUENCE_1BIT         12                                          // Sequence_extract() of a 1 bit step (2 LEDs)
+#define BENCH_SEQUENCE_2BIT         13                                          // 2 bit step (4 LEDs)
+#define BENCH_SEQUENCE_3BIT         14                                          // 3 bit step (8 LEDs)
+#define BENCH_COUNT                 15
+
+#define BENCH_BURST_FRAMES          32                                          // "PRESS S1 OR S2 FOR ENDLESS", in and out
+
+//***** Prototypes ************************************************************
+void Bench_run( void );                                                         // Time each primitive, send the results
+
+
+#endif /* MYBENCH_H_ */
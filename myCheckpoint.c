@@ -0,0 +1,98 @@
+// ----------------------------------------------------------------------------
+// myCheckpoint.c  ('FR6989 Launchpad)
+//
+// Saves the state of a game in progress to FRAM so it can be resumed after
+// a power loss or reset.
+//
+// The game saves a checkpoint at the start of every round. It is small
+// (the sequence itself is regenerated from the seed) and carries a CRC, so
+// a checkpoint cut short by a power loss is simply not resumed. At boot,
+// main() checks for a valid checkpoint and, if there is one, skips the
+// start screen and level selection and goes straight into the round intro.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include <stddef.h>
+#include "myCheckpoint.h"
+#include "myFram.h"
+#include "myClocks.h"
+
+
+//***** Global Variables ******************************************************
+#pragma PERSISTENT(checkpointFram)
+Checkpoint checkpointFram = { 0 };                                              // Kept in FRAM
+
+volatile uint16_t checkpointCycles = 0;
+
+
+//*****************************************************************************
+// Checkpoint_save()
+//
+// Writes a checkpoint for the round about to be played. The time it takes,
+// measured with Timer_0 and scaled to MCLK cycles, is left in
+// checkpointCycles.
+//
+// Arg 1: "seed" is the seed of the game's sequence
+// Arg 2: "round" is the round about to be played, starting at 0
+// Arg 3: "score" is the score so far
+// Arg 4: "level" is the difficulty level
+// Arg 5: "endless" is 1 for an endless game
+// Arg 6: "adaptive" is 1 if adaptive mode is on
+//*****************************************************************************
+void Checkpoint_save( uint32_t seed, unsigned int round, unsigned int score,
+                      unsigned int level, int endless, int adaptive )
+{
+    Checkpoint cp;
+    uint16_t window;
+    uint16_t start = TA0R;
+
+    cp.seed     = seed;
+    cp.round    = round;
+    cp.score    = score;
+    cp.level    = level;
+    cp.endless  = endless;
+    cp.adaptive = adaptive;
+    cp.reserved = 0;
+    cp.crc      = Fram_crc( &cp, offsetof( Checkpoint, crc ) );
+
+    window = Fram_open();
+    Fram_write( &checkpointFram, &cp, sizeof( Checkpoint ) );
+    Fram_close( window );
+
+    checkpointCycles = ( TA0R - start ) * ( myMCLK_FREQUENCY_IN_HZ / mySMCLK_FREQUENCY_IN_HZ );
+}
+
+//*****************************************************************************
+// Checkpoint_load()
+//
+// Copies the checkpoint out of FRAM if there is a valid one. Returns 1 if a
+// game can be resumed, 0 otherwise.
+//
+// Arg 1: "cp" receives the checkpoint
+//*****************************************************************************
+int Checkpoint_load( Checkpoint *cp )
+{
+    if ( Fram_crc( &checkpointFram, offsetof( Checkpoint, crc ) ) != checkpointFram.crc )
+    {
+        return 0;
+    }
+    *cp = checkpointFram;
+    return 1;
+}
+
+//*****************************************************************************
+// Checkpoint_clear()
+//
+// Invalidates the checkpoint by storing the complement of its CRC, so a
+// finished game is not resumed. Clearing twice leaves it invalid.
+//*****************************************************************************
+void Checkpoint_clear( void )
+{
+    uint16_t window;
+    uint16_t crc = ~Fram_crc( &checkpointFram, offsetof( Checkpoint, crc ) );
+
+    window = Fram_open();
+    Fram_write( &checkpointFram.crc, &crc, sizeof( crc ) );
+    Fram_close( window );
+}
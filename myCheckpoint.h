@@ -0,0 +1,33 @@
+/*
+ * myCheckpoint.h
+ *
+ */
+
+#ifndef MYCHECKPOINT_H_
+#define MYCHECKPOINT_H_
+
+#include <stdint.h>
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint32_t seed;                                                              // Seed of the game's sequence
+    uint16_t round;                                                             // Next round to play, starting at 0
+    uint16_t score;                                                             // Score so far
+    uint8_t  level;                                                             // DIFFICULTY_xxx
+    uint8_t  endless;                                                           // 1 for an endless game
+    uint8_t  adaptive;                                                          // 1 if adaptive mode is on
+    uint8_t  reserved;                                                          // Keeps the CRC word aligned
+    uint16_t crc;
+} Checkpoint;
+
+//***** Prototypes ************************************************************
+void Checkpoint_save( uint32_t, unsigned int, unsigned int, unsigned int, int, int );   // Save the state at a round boundary
+int  Checkpoint_load( Checkpoint * );                                                   // Get a valid checkpoint, if there is one
+void Checkpoint_clear( void );                                                          // Forget the checkpoint at game over
+
+//***** Global Variables ******************************************************
+extern volatile uint16_t checkpointCycles;                                      // MCLK cycles taken by the last Checkpoint_save()
+
+
+#endif /* MYCHECKPOINT_H_ */
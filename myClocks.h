@@ -13,10 +13,36 @@ void initClocks(void);
 #define LF_CRYSTAL_FREQUENCY_IN_HZ     32768
 #define HF_CRYSTAL_FREQUENCY_IN_HZ     0                                        // FR6989 Launchpad does not ship with HF Crystal populated
 
+// Define CLOCKS_16MHZ in the project's predefined symbols to run MCLK at
+// 16MHz instead of 4MHz. SMCLK stays at 2MHz, so the UART and Timer_0 don't
+// change. FRAM can't be read at more than 8MHz without a wait state, which
+// initClocks() sets first, so code running from FRAM gets less than four
+// times faster. The hot routines are marked RAMFUNC to run from RAM at the
+// full clock instead.
+#ifdef CLOCKS_16MHZ
+#define myMCLK_FREQUENCY_IN_HZ         16000000
+#else
 #define myMCLK_FREQUENCY_IN_HZ         4000000
+#endif
 #define mySMCLK_FREQUENCY_IN_HZ        2000000
 #define myACLK_FREQUENCY_IN_HZ         32768
 
+// A RAMFUNC function goes into the .TI.ramfunc section. The device's linker
+// command file loads that into FRAM and has it copied to RAM at boot (its
+// BINIT table, which the C startup code runs), and the function is linked
+// to run at its RAM address. There are 2KB of RAM, and the stack, the UART
+// ring and the trace take well over half, so only what runs for every
+// character of a scroll or a number is marked: about 400 bytes. The tick
+// ISR runs at most once a tick and stays in FRAM. What the marked functions
+// call in the trace and the run-time library (32-bit division) runs from
+// FRAM too. The profiler can't see code in RAM: its samples there count as
+// outside.
+#if defined( CLOCKS_16MHZ ) && defined( __TI_COMPILER_VERSION__ )
+#define RAMFUNC                        __attribute__(( ramfunc ))
+#else
+#define RAMFUNC
+#endif
+
 
 #endif /* LCD_MYCLOCKS_H_ */
 
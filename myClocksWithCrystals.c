@@ -5,13 +5,14 @@
 // internal clock source (DCO). Then configures ACLK, SMCLK, and MCLK:
 //    ACLK  = 32KHz
 //    SMCLK =  2MHz
-//    MCLK  =  4MHz
+//    MCLK  =  4MHz  (16MHz with CLOCKS_16MHZ, see 'myClocks.h')
 // ----------------------------------------------------------------------------
 
 //***** Header Files **********************************************************
 #include <stdbool.h>
 #include <driverlib.h>
 #include "myClocks.h"
+#include "myTrace.h"
 
 
 //***** Defines ***************************************************************
@@ -76,11 +77,22 @@ void initClocks(void) {
 //         while( 1 );
 //     }
 
+#ifdef CLOCKS_16MHZ
+    // FRAM needs one wait state above 8MHz. Set it before MCLK gets there.
+    FRAMCtl_configureWaitStateControl( FRAMCTL_ACCESS_TIME_CYCLES_1 );
+
+    // Set DCO to 16MHz
+    CS_setDCOFreq(
+            CS_DCORSEL_1,                                                       // Set Frequency range (DCOR)
+            CS_DCOFSEL_4                                                        // Set Frequency (DCOF)
+    );
+#else
     // Set DCO to 4MHz
     CS_setDCOFreq(
             CS_DCORSEL_0,                                                       // Set Frequency range (DCOR)
             CS_DCOFSEL_3                                                        // Set Frequency (DCOF)
     );
+#endif
 
     //**************************************************************************
     // Configure Clocks
@@ -94,14 +106,19 @@ void initClocks(void) {
     );
 
     // Select LFXT as SMCLK oscillator source  ('FR6989 Launchpad does not ship with HFXT populated)
-    // With DCO set at 4MHz, SMCLK is set for half that rate (2MHz)
+    // With DCO set at 4MHz, SMCLK is set for half that rate (2MHz); at 16MHz, for an eighth
     CS_initClockSignal( 
             CS_SMCLK,                                                           // Clock you're configuring
             CS_DCOCLK_SELECT,                                                   // Clock source
+#ifdef CLOCKS_16MHZ
+            CS_CLOCK_DIVIDER_8                                                  // Divide down clock source by this much
+#else
             CS_CLOCK_DIVIDER_2                                                  // Divide down clock source by this much
+#endif
     );
 
-    // Set MCLK to use DCO as its oscillator source (DCO was configured earlier in this function for 4MHz)
+    // Set MCLK to use DCO as its oscillator source (DCO was configured earlier in this function for 4MHz,
+    // or 16MHz)
     CS_initClockSignal(
             CS_MCLK,                                                            // Clock you're configuring
             CS_DCOCLK_SELECT,                                                   // Clock source
@@ -112,5 +129,8 @@ void initClocks(void) {
     myACLK  = CS_getACLK();
     mySMCLK = CS_getSMCLK();
     myMCLK  = CS_getMCLK();
+
+    // Log the switch to the new clocks
+    TRACE( TRACE_CLOCKS, myMCLK / 1000 );
 }
 
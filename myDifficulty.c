@@ -0,0 +1,73 @@
+// ----------------------------------------------------------------------------
+// myDifficulty.c  ('FR6989 Launchpad)
+//
+// Tempo tables for the difficulty levels.
+//
+// Every level has a timing curve over the rounds of a game. The curves are
+// expanded by the preprocessor into a const table, which the compiler places
+// in FRAM, so the game only has to look up a row each round and never
+// computes any timing while it is playing. The curves are written in
+// milliseconds and turned into Timer_1 ticks (about 12.2ms) with
+// TIMER_TICKS(), rounded down.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include "myDifficulty.h"
+#include "myTimer.h"
+
+
+//***** Defines ***************************************************************
+// A value that starts at 'base' and drops by 'step' each round, but never
+// goes below 'floor'.
+#define CURVE( base, floor, step, r )   ( ( (base) - (step) * (r) ) > (floor) ? ( (base) - (step) * (r) ) : (floor) )
+
+// One row of the table, from times in milliseconds
+#define TEMPO( offBase, offFloor, onBase, onFloor, step, intro, timeout, r )  \
+    { TIMER_TICKS( CURVE( offBase, offFloor, step, r ) ), TIMER_TICKS( CURVE( onBase, onFloor, step, r ) ), \
+      TIMER_TICKS( intro ), TIMER_TICKS( timeout ) }
+
+// Curve for each level, in ms. NORMAL keeps the game's original 250ms/250ms
+// timing.
+//                                 off         on          step intro timeout
+#define TEMPO_EASY( r )     TEMPO( 350, 350,   350, 350,   0,   600,  6000, r )
+#define TEMPO_NORMAL( r )   TEMPO( 250, 250,   250, 250,   0,   500,  4000, r )
+#define TEMPO_HARD( r )     TEMPO( 200,  60,   200,  80,  10,   300,  2000, r )
+
+#define TEMPO_CURVE( T )                                                        \
+    { T( 0), T( 1), T( 2), T( 3), T( 4), T( 5), T( 6), T( 7),                   \
+      T( 8), T( 9), T(10), T(11), T(12), T(13), T(14), T(15) }
+
+
+//***** Global Variables ******************************************************
+const Tempo tempoTable[ DIFFICULTY_LEVELS ][ TEMPO_ROUNDS ] =
+{
+    TEMPO_CURVE( TEMPO_EASY   ),
+    TEMPO_CURVE( TEMPO_NORMAL ),
+    TEMPO_CURVE( TEMPO_HARD   )
+};
+
+const char * const difficultyName[ DIFFICULTY_LEVELS ] =
+{
+    "EASY",
+    "NORMAL",
+    "HARD"
+};
+
+
+//*****************************************************************************
+// Difficulty_tempo()
+//
+// Returns the tempo row for a level and round. Rounds past the end of the
+// table (endless games) keep the tempo of the last round.
+//
+// Arg 1: "level" is one of DIFFICULTY_EASY, DIFFICULTY_NORMAL or DIFFICULTY_HARD
+// Arg 2: "round" is the round of the game, starting at 0
+//*****************************************************************************
+const Tempo *Difficulty_tempo( unsigned int level, unsigned int round )
+{
+    if ( round >= TEMPO_ROUNDS )
+    {
+        round = TEMPO_ROUNDS - 1;
+    }
+    return &tempoTable[ level ][ round ];
+}
@@ -0,0 +1,38 @@
+/*
+ * myDifficulty.h
+ *
+ */
+
+#ifndef MYDIFFICULTY_H_
+#define MYDIFFICULTY_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define DIFFICULTY_EASY             0
+#define DIFFICULTY_NORMAL           1
+#define DIFFICULTY_HARD             2
+#define DIFFICULTY_LEVELS           3
+
+#define TEMPO_ROUNDS                16                                          // Rounds with their own tempo; later rounds reuse the last
+
+//***** Type Definitions ******************************************************
+// Timing for one round. All times are in Timer_1 ticks (TIMER_TICK_COUNTS
+// ACLK counts, about 12.2ms); myDifficulty.c sets them in milliseconds.
+typedef struct
+{
+    uint8_t  offTicks;                                                          // "WATCH" gap before each LED
+    uint8_t  onTicks;                                                           // Time each LED stays on
+    uint8_t  introTicks;                                                        // Each of the round intro delays
+    uint16_t timeoutTicks;                                                      // Longest wait for a button press
+} Tempo;
+
+//***** Prototypes ************************************************************
+const Tempo *Difficulty_tempo( unsigned int, unsigned int );                    // Tempo for a level and round
+
+//***** Global Variables ******************************************************
+extern const Tempo tempoTable[ DIFFICULTY_LEVELS ][ TEMPO_ROUNDS ];
+extern const char * const difficultyName[ DIFFICULTY_LEVELS ];
+
+
+#endif /* MYDIFFICULTY_H_ */
@@ -0,0 +1,91 @@
+// ----------------------------------------------------------------------------
+// myFram.c  ('FR6989 Launchpad)
+//
+// Helpers for keeping data in FRAM.
+//
+// FRAM is written like RAM, but the MPU normally keeps the program and
+// constant segments write-protected. Fram_open() opens a short write window:
+// interrupts are held off and the MPU is disabled until Fram_close() puts
+// both back the way they were. Keep the window as short as possible; a
+// stray write while it is open could land anywhere in FRAM.
+//
+// Fram_crc() uses the CRC16 hardware module (CRC-CCITT, seed 0xFFFF), which
+// takes one 16-bit word per write, so records should have an even size.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include <string.h>
+#include "myFram.h"
+
+
+//***** Global Variables ******************************************************
+static uint16_t savedMpu;                                                       // MPU control bits while the window is open
+
+
+//*****************************************************************************
+// Fram_open()
+//
+// Opens the FRAM write window. Returns the interrupt state that must be
+// passed to Fram_close().
+//*****************************************************************************
+uint16_t Fram_open( void )
+{
+    uint16_t interruptState;
+
+    interruptState = __get_interrupt_state();
+    __disable_interrupt();
+
+    savedMpu = MPUCTL0 & 0x00FF;
+    MPUCTL0  = MPUPW;                                                           // Unlock and disable the MPU
+
+    return interruptState;
+}
+
+//*****************************************************************************
+// Fram_close()
+//
+// Closes the FRAM write window, putting the MPU and interrupts back.
+//
+// Arg 1: "interruptState" is the value returned by Fram_open()
+//*****************************************************************************
+void Fram_close( uint16_t interruptState )
+{
+    MPUCTL0 = MPUPW | savedMpu;                                                 // Put the MPU back as it was
+
+    __set_interrupt_state( interruptState );
+}
+
+//*****************************************************************************
+// Fram_write()
+//
+// Copies a block of RAM into FRAM. The write window must be open.
+//
+// Arg 1: "dst" is the FRAM address to write
+// Arg 2: "src" is the data to write
+// Arg 3: "bytes" is the number of bytes to write
+//*****************************************************************************
+void Fram_write( void *dst, const void *src, unsigned int bytes )
+{
+    memcpy( dst, src, bytes );
+}
+
+//*****************************************************************************
+// Fram_crc()
+//
+// Returns the CRC-CCITT of a block, computed by the CRC16 module.
+//
+// Arg 1: "data" is the block to check; it must be word aligned
+// Arg 2: "bytes" is the size of the block; it must be even
+//*****************************************************************************
+uint16_t Fram_crc( const void *data, unsigned int bytes )
+{
+    const uint16_t *word = (const uint16_t *)data;
+
+    CRCINIRES = 0xFFFF;
+    for ( bytes = bytes >> 1; bytes; bytes-- )
+    {
+        CRCDI = *word++;
+    }
+    return CRCINIRES;
+}
@@ -0,0 +1,18 @@
+/*
+ * myFram.h
+ *
+ */
+
+#ifndef MYFRAM_H_
+#define MYFRAM_H_
+
+#include <stdint.h>
+
+//***** Prototypes ************************************************************
+uint16_t Fram_open( void );                                                     // Open a protected FRAM write window
+void     Fram_close( uint16_t );                                                // Close the window opened by Fram_open()
+void     Fram_write( void *, const void *, unsigned int );                      // Copy RAM to FRAM (window must be open)
+uint16_t Fram_crc( const void *, unsigned int );                                // CRC-CCITT of an even number of bytes
+
+
+#endif /* MYFRAM_H_ */
@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// myGame.c  ('FR6989 Launchpad)
+//
+// The rules of the game: which press is right, when a round is answered,
+// the score, when the game is over and when it is won.
+//
+// main.c does the waiting, the LEDs and the buttons, and tells this module
+// each press and timeout. Nothing here touches the hardware or the clock,
+// so the simulated board can also check the rules on their own against
+// every sequence and every single mistake (tools/sim/verify.c).
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include "myGame.h"
+
+
+//*****************************************************************************
+// Game_start()
+//
+// Starts a game at round "round" with score "score": round 0 and a score of
+// 0 for a new game, or the checkpoint's for a resumed one.
+//
+// Arg 1: "game" is the game to start
+// Arg 2: "round" is the first round to play, starting at 0
+// Arg 3: "score" is the score so far
+// Arg 4: "endless" is 1 for an endless game, which goes on until a mistake
+//*****************************************************************************
+void Game_start( Game *game, unsigned int round, unsigned int score, int endless )
+{
+    game->round   = round;
+    game->steps   = 0;
+    game->score   = score;
+    game->endless = endless ? 1 : 0;
+    game->over    = 0;
+    Sequence_begin( &game->it );
+}
+
+//*****************************************************************************
+// Game_begin()
+//
+// Starts answering the current round, from the first step of the sequence.
+// Call it once the round has been shown.
+//
+// Arg 1: "game" is the game being played
+//*****************************************************************************
+void Game_begin( Game *game )
+{
+    game->steps = 0;
+    Sequence_begin( &game->it );
+}
+
+//*****************************************************************************
+// Game_press()
+//
+// Checks a button press against the next step of the round. A wrong press
+// ends the game. The right press for the last step of the round adds one
+// to the score and moves on to the next round. Once the game is over every
+// press is wrong.
+//
+// Arg 1: "game" is the game being played
+// Arg 2: "button" is the step the button stands for (0 for button 1)
+//
+// Returns GAME_RIGHT, GAME_ROUND_DONE or GAME_WRONG
+//*****************************************************************************
+int Game_press( Game *game, unsigned int button )
+{
+    if ( game->over )
+    {
+        return GAME_WRONG;
+    }
+    if ( button != Sequence_next( &game->it ) )
+    {
+        game->over = 1;
+        return GAME_WRONG;
+    }
+
+    game->steps++;
+    if ( game->steps <= game->round )                                           // Round r has r + 1 steps
+    {
+        return GAME_RIGHT;
+    }
+    game->score++;
+    game->round++;
+    return GAME_ROUND_DONE;
+}
+
+//*****************************************************************************
+// Game_timeout()
+//
+// Ends the game: the user took too long to press the next button.
+//
+// Arg 1: "game" is the game being played
+//*****************************************************************************
+void Game_timeout( Game *game )
+{
+    game->over = 1;
+}
+
+//*****************************************************************************
+// Game_playing()
+//
+// Returns 1 while there is another round to play: until a mistake, and in
+// a normal game only until all GAME_ROUNDS rounds are answered.
+//
+// Arg 1: "game" is the game being played
+//*****************************************************************************
+int Game_playing( const Game *game )
+{
+    return !game->over && ( game->endless || game->round < GAME_ROUNDS );
+}
+
+//*****************************************************************************
+// Game_won()
+//
+// Returns 1 if the user answered every round of a normal game. An endless
+// game can't be won.
+//
+// Arg 1: "game" is the game that was played
+//*****************************************************************************
+int Game_won( const Game *game )
+{
+    return !game->endless && game->score == GAME_ROUNDS;
+}
@@ -0,0 +1,40 @@
+/*
+ * myGame.h
+ *
+ */
+
+#ifndef MYGAME_H_
+#define MYGAME_H_
+
+#include <stdint.h>
+#include "mySequence.h"
+
+//***** Defines ***************************************************************
+#define GAME_ROUNDS                 16                                          // Rounds in a normal (not endless) game
+
+// Results of Game_press()
+#define GAME_RIGHT                  0                                           // Right button, more of the round to go
+#define GAME_ROUND_DONE             1                                           // Right button, and the round is answered
+#define GAME_WRONG                  2                                           // Wrong button: game over
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    SequenceIter it;                                                            // Next step the user has to press
+    unsigned int round;                                                         // Round being played, starting at 0
+    unsigned int steps;                                                         // Steps of the round pressed right so far
+    unsigned int score;                                                         // Rounds answered right
+    uint8_t      endless;                                                       // 1 for an endless game
+    uint8_t      over;                                                          // 1 once a wrong press or a timeout ends it
+} Game;
+
+//***** Prototypes ************************************************************
+void Game_start( Game *, unsigned int, unsigned int, int );                     // New game, or one resumed at a round
+void Game_begin( Game * );                                                      // The user starts answering the round
+int  Game_press( Game *, unsigned int );                                        // A button (the step it stands for) was pressed, GAME_xxx
+void Game_timeout( Game * );                                                    // The user took too long to press
+int  Game_playing( const Game * );                                              // Are there rounds left to play?
+int  Game_won( const Game * );                                                  // Was every round of a normal game answered?
+
+
+#endif /* MYGAME_H_ */
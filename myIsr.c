@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// myIsr.c  ('FR6989 Launchpad)
+//
+// Per-ISR statistics: runs, time spent, entry latency and nesting.
+//
+// Each instrumented ISR reads Timer_0 as its body starts (ISR_ENTER) and
+// ends (ISR_EXIT). Timer_0 counts SMCLK, which comes from the same DCO as
+// MCLK, so reading TA0R is as exact as a capture. The time between the two
+// is the ISR's own, less its prologue and epilogue, and plus any ISR that
+// interrupted it.
+//
+// The latency is from the event that raised the interrupt to the first
+// line of the body: the 6 cycles the CPU takes to get to the vector, the
+// prologue, and any time the interrupt waited while interrupts were off or
+// another ISR ran. It needs the Timer_0 count of the event, so only ISRs
+// raised by Timer_0 itself have one. The Timer_0 wrap comes about 30 times
+// a second at any point in the program, so its worst latency is the
+// longest that any interrupt has been held off.
+//
+// Nesting is how many instrumented ISRs were running when one started,
+// itself included. It stays 1 while no ISR turns interrupts back on.
+// The profiler's ISR (myProfileIsr.asm) isn't counted.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myIsr.h"
+#include "myTelemetry.h"
+#include "myTrace.h"
+
+#ifdef ISR_STATS
+
+//***** Global Variables ******************************************************
+IsrStats             isrStats[ ISR_COUNT ];
+static uint8_t       isrDepth = 0;                                              // ISRs running now
+
+
+//*****************************************************************************
+// Isr_enter(), Isr_enterAt()
+//
+// Count one more ISR running, and keep its most nested. Isr_enterAt() also
+// keeps the latest start.
+//
+// Arg 1: "id" is one of the ISR_xxx IDs
+// Arg 2: "event" is the Timer_0 count when the interrupt was raised
+//
+// Returns the Timer_0 count at entry, for Isr_exit().
+//*****************************************************************************
+uint16_t Isr_enter( uint8_t id )
+{
+    uint16_t entry = TA0R;
+
+    isrDepth++;
+    if ( isrDepth > isrStats[ id ].maxNesting )
+    {
+        isrStats[ id ].maxNesting = isrDepth;
+    }
+    return entry;
+}
+
+uint16_t Isr_enterAt( uint8_t id, uint16_t event )
+{
+    uint16_t entry = Isr_enter( id );
+
+    if ( (uint16_t)( entry - event ) > isrStats[ id ].maxLatency )
+    {
+        isrStats[ id ].maxLatency = entry - event;
+    }
+    return entry;
+}
+
+//*****************************************************************************
+// Isr_exit()
+//
+// Adds the run that is ending to its ISR's stats.
+//
+// Arg 1: "id" is one of the ISR_xxx IDs
+// Arg 2: "entry" is what Isr_enter() returned
+//*****************************************************************************
+void Isr_exit( uint8_t id, uint16_t entry )
+{
+    IsrStats *stats  = &isrStats[ id ];
+    uint16_t  counts = TA0R - entry;
+
+    stats->runs++;
+    stats->totalCounts += counts;
+    if ( counts > stats->maxCounts )
+    {
+        stats->maxCounts = counts;
+    }
+    isrDepth--;
+}
+
+//*****************************************************************************
+// Isr_dump()
+//
+// Sends the stats of every ISR, one TELEMETRY_ISR frame each. They are
+// kept from boot, not cleared. Can be called from an ISR.
+//*****************************************************************************
+void Isr_dump( void )
+{
+    IsrStats     copy;
+    uint16_t     state;
+    unsigned int id;
+
+    for ( id = 0; id < ISR_COUNT; id++ )
+    {
+        state = __get_interrupt_state();
+        __disable_interrupt();
+        copy = isrStats[ id ];
+        __set_interrupt_state( state );
+
+        Telemetry_isr( id, copy.maxNesting, copy.runs, copy.totalCounts, copy.maxCounts, copy.maxLatency );
+    }
+}
+
+//*****************************************************************************
+// Isr_trace()
+//
+// Logs each ISR's longest run and latest start in the trace, as
+// TRACE_ISR_TIME and TRACE_ISR_LATENCY events. Call it from main context.
+//*****************************************************************************
+void Isr_trace( void )
+{
+    unsigned int id;
+    uint16_t     counts, latency;
+
+    for ( id = 0; id < ISR_COUNT; id++ )
+    {
+        counts  = isrStats[ id ].maxCounts;
+        latency = isrStats[ id ].maxLatency;
+        TRACE( TRACE_ISR_TIME, id << 12 | ( counts < 0x0FFF ? counts : 0x0FFF ) );
+        TRACE( TRACE_ISR_LATENCY, id << 12 | ( latency < 0x0FFF ? latency : 0x0FFF ) );
+    }
+}
+
+#endif /* ISR_STATS */
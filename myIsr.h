@@ -0,0 +1,62 @@
+/*
+ * myIsr.h
+ *
+ */
+
+#ifndef MYISR_H_
+#define MYISR_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+// Define ISR_STATS in the project's predefined symbols to count how often
+// each ISR runs, how long it takes, how late it starts and how deeply
+// interrupts nest. Without it the ISR_xxx macros compile to nothing.
+// Times are in Timer_0 counts (SMCLK); tools/telemetry.c converts them.
+
+// ISR IDs, as sent in TELEMETRY_ISR frames and the TRACE_ISR_xxx events.
+// Keep tools/telemetry.c and tools/tracedump.c in step with this list.
+#define ISR_TIMER0                  0                                           // Timer_0 wrap (main.c)
+#define ISR_TIMER1                  1                                           // Timer_1 software timers (myTimer.c)
+#define ISR_PORT1                   2                                           // Button wakeup (myPower.c)
+#define ISR_UART                    3                                           // Remote commands (myRemote.c)
+#define ISR_DMA                     4                                           // Telemetry sent (myUart.c)
+#define ISR_LINK                    5                                           // The other board (myLink.c)
+#define ISR_COUNT                   6
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint32_t runs;
+    uint32_t totalCounts;                                                       // Time in the ISR, all runs
+    uint16_t maxCounts;                                                         // Longest run
+    uint16_t maxLatency;                                                        // Latest start after its event, if known
+    uint8_t  maxNesting;                                                        // Most ISRs running at once, itself included
+} IsrStats;
+
+//***** Prototypes ************************************************************
+uint16_t Isr_enter( uint8_t );                                                  // Use ISR_ENTER(), ISR_ENTER_AT()
+uint16_t Isr_enterAt( uint8_t, uint16_t );                                      //  and ISR_EXIT() instead
+void     Isr_exit( uint8_t, uint16_t );
+void     Isr_dump( void );                                                      // Send the stats (TELEMETRY_ISR frames)
+void     Isr_trace( void );                                                     // Log each ISR's maxima in the trace
+
+//***** Global Variables ******************************************************
+extern IsrStats isrStats[ ISR_COUNT ];
+
+//***** Macros ****************************************************************
+// ISR_ENTER() goes first in an ISR's body, and ISR_EXIT() last, before every
+// return. ISR_ENTER_AT() is for an ISR whose event has a Timer_0 count,
+// such as a compare: the count at entry less that one is its latency.
+#ifdef ISR_STATS
+#define ISR_ENTER( id )             uint16_t isrEntry_ = Isr_enter( id )
+#define ISR_ENTER_AT( id, event )   uint16_t isrEntry_ = Isr_enterAt( id, event )
+#define ISR_EXIT( id )              Isr_exit( id, isrEntry_ )
+#else
+#define ISR_ENTER( id )             do { } while ( 0 )
+#define ISR_ENTER_AT( id, event )   do { } while ( 0 )
+#define ISR_EXIT( id )              do { } while ( 0 )
+#endif
+
+
+#endif /* MYISR_H_ */
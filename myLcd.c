@@ -6,6 +6,7 @@
 #include "myLcd.h"
 #include "string.h"
 #include "driverlib.h"
+#include "myClocks.h"
 
 
 // ***** Prototypes ***********************************************************
@@ -71,6 +72,10 @@ const char alphabetBig[26][2] =
     {0x90, 0x28}   /* "Z" */
 };
 
+// LCD memory map for a space, and for a character that has no pattern
+const char blankGlyph[2] = {0x00, 0x00};
+const char unknownGlyph[2] = {0xFF, 0xFF};
+
 // This structure is defined by the LCD_C DriverLib module, and is passed to the LCD_C_init() function
 LCD_C_initParam initParams = {
     LCD_C_CLOCKSOURCE_ACLK,                                                     // Use ACLK as the LCD's clock source
@@ -178,51 +183,43 @@ void myLCD_init()
 // The Position number is used to lookup locations for each nibble that
 // controls a segment pin. Four nibbles are required per character.
 //
-// This routine uses the native LCD_C DriverLib "setMemory" functions. The
-// LCD_C version of this routine only programs a nibble at a time, as opposed
-// to the LCD_E_setMemory(), which programs the entire 8-bit LCDMEM register.
-// See the examples found later in this file for an example which is closer
-// to the LCD_E method. We called our example: myLCD_setMemoryBits().
+// In 4-mux mode each segment pin is one nibble of LCD memory, pin n being
+// the low (even n) or high (odd n) nibble of LCDM(n/2 + 1). A position's
+// four pins are two pairs that each start on an even pin, so the nibbles
+// LCD_C_setMemory() would program one at a time make up two whole bytes:
+// the two bytes of the character's pattern. Writing them directly takes two
+// stores instead of eight read-modify-writes through DriverLib, which adds
+// up when a message scrolls. It only holds in 4-mux mode (see initParams).
 //*****************************************************************************
-void myLCD_showChar( char c, int Position )
+RAMFUNC void myLCD_showChar( char c, int Position )
 {
+    const char *glyph;
+
     Position -= 1;
 
-    if ( ( Position >= 0 ) && ( Position <= 6 ) )
+    if ( ( Position >= 0 ) && ( Position < LCD_NUM_CHAR ) )                     // Positions 1 to 6 only
     {
 
         if ( c == ' ' )
         {
-            // Display space
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][0], 0 );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][1], 0 );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][2], 0 );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][3], 0 );
+            glyph = blankGlyph;                                                 // Display space
         }
         else if ( c >= '0' && c <= '9' )
         {
-            // Display digit
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][0], digit[c-48][0] );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][1], digit[c-48][0] >> 4 );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][2], digit[c-48][1] );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][3], digit[c-48][1] >> 4 );
+            glyph = digit[c-48];                                                // Display digit
         }
         else if ( c >= 'A' && c <= 'Z' )
         {
-            // Display alphabet
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][0], alphabetBig[c-65][0] );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][1], alphabetBig[c-65][0] >> 4 );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][2], alphabetBig[c-65][1] );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][3], alphabetBig[c-65][1] >> 4 );
+            glyph = alphabetBig[c-65];                                          // Display alphabet
         }
         else
         {
             // Turn all segments on if character is not a space, digit, or uppercase letter
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][0], 0xFF );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][1], 0xFF );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][2], 0xFF );
-            LCD_C_setMemory( LCD_C_BASE, SegmentLoc[Position][3], 0xFF );
+            glyph = unknownGlyph;
         }
+
+        LCDMEM[ SegmentLoc[Position][0] / 2 ] = glyph[0];                       // Pins 0 and 1
+        LCDMEM[ SegmentLoc[Position][2] / 2 ] = glyph[1];                       // Pins 2 and 3
     }
 }
 
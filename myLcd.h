@@ -145,6 +145,7 @@ uint8_t myLCD_getBlinkingMemoryBits   ( uint8_t          );
 #define LCD_A4COL                   23
 
 //***** Global Variables ******************************************************
+extern const uint8_t SegmentLoc[ LCD_NUM_CHAR ][ 4 ];                           // LCD memory nibbles of each position
 extern const char digit[10][2];                                                 // Segment values for each number character
 extern const char alphabetBig[26][2];                                           // Segment values for each alphabet character
 
@@ -0,0 +1,705 @@
+// ----------------------------------------------------------------------------
+// myLink.c  ('FR6989 Launchpad)
+//
+// Head-to-head races between two boards, over eUSCI_A0 (P4.2 and P4.3, on
+// the BoosterPack header): wire each board's TXD to the other's RXD, and
+// join their grounds. The backchannel UART is left to telemetry and test
+// commands.
+//
+// Whoever presses start first picks the level, and the other board joins
+// in: both play the same sequence (the same seed) at the same tempo, and
+// start at the same moment. Each press is sent to the other board, which
+// shows how far its opponent is into the round on the battery segments
+// B1 to B6. The player who gets furthest wins; if both get as far, the one
+// who got there first.
+//
+// The boards keep time in Timer_counts() (ACLK, 30.5us a count, from the
+// 32kHz crystal), and each one works out how far the other's clock is
+// from its own, the way NTP does. A ping carries the time it was sent, the
+// reply the times the ping came in and the reply went out, and the reply
+// is stamped when it comes in:
+//
+//    round trip = ( back - sent ) - ( replied - received )
+//    offset     = received - sent - round trip / 2        (theirs - ours)
+//
+// Frames are stamped at their first byte, on both sides, so the time a
+// frame takes to send doesn't count; and a ping or a reply is only sent
+// when nothing else is going out, so it doesn't wait behind other frames.
+// Of the last LINK_SAMPLES samples, the one with the shortest round trip
+// is used, since it has waited least. The round trip is about two bytes
+// (under 0.2ms) on the wire, so the offset is good to well under a
+// millisecond, and a ping every half second follows the drift between the
+// crystals (up to 40ppm). The start of a race, and each press, are then
+// in the same time on both boards, and the start also lines up the ticks
+// (Timer_align()), so the two boards play the sequence back together.
+//
+// If both players press start together, both boards invite the other,
+// and the invitation with the smaller seed wins on both.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myLink.h"
+#include "myUart.h"
+#include "myTimer.h"
+#include "myLcd.h"
+#include "myTelemetry.h"
+#include "myIsr.h"
+
+#ifdef LINK
+
+//***** Defines ***************************************************************
+#define LINK_TXD            0x04        // P4.2 is UCA0TXD
+#define LINK_RXD            0x08        // P4.3 is UCA0RXD
+#define TX_MASK             ( LINK_TX_BYTES - 1 )
+#define FRAME_MAX           13          // LINK_PONG
+
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    int32_t  offset;                                                            // Their time less ours, in counts
+    uint32_t roundTrip;
+} LinkSample;
+
+
+//***** Global Variables ******************************************************
+static uint8_t           txRing[ LINK_TX_BYTES ];
+static volatile uint8_t  txHead = 0;                                            // Next byte to queue
+static volatile uint8_t  txTail = 0;                                            // Next byte to send
+
+static uint8_t           rxFrame[ LINK_RX_BYTES ];
+static uint8_t           rxLength = 0;
+static uint8_t           rxOverflow = 0;                                        // Current frame is too long
+static uint32_t          rxAt;                                                  // When its first byte came in
+
+static Timer             pingTimer;
+static Timer             waitTimer;                                             // Wakes Link_tick()
+static volatile uint8_t  waited = 0;
+static LinkSample        samples[ LINK_SAMPLES ];
+static uint8_t           sampleNext = 0;
+static volatile uint8_t  sampleCount = 0;                                       // 0 while there is no other board
+static volatile uint16_t silentTicks = 0;                                       // Since its last frame
+static int32_t           offset = 0;                                            // From the best sample
+static uint32_t          roundTrip = 0;
+
+static volatile uint8_t  invited = 0;                                           // The other board's invitation
+static uint32_t          inviteSeed;
+static uint8_t           inviteLevel;
+static uint8_t           inviteEndless;
+static uint32_t          inviteStart;                                           //  and its start, in our time
+static uint32_t          ourSeed;                                               // Our invitation
+static volatile uint8_t  inviting = 0;
+static volatile uint8_t  joined = 0;                                            // The other board took it
+
+static volatile uint8_t  racing = 0;
+static uint32_t          presses;                                               // Right presses, all rounds
+static uint32_t          lastAt;                                                //  and when the last one was
+static volatile uint32_t theirPresses;                                          // The same for the other board,
+static volatile uint32_t theirLastAt;                                           //  in our time
+static volatile uint8_t  theirDone;
+
+
+//***** Prototypes ************************************************************
+static int Link_ping( Timer * );
+
+
+//*****************************************************************************
+// Link_put16(), Link_put32(), Link_get16(), Link_get32()
+//
+// Little-endian fields.
+//*****************************************************************************
+static uint8_t *Link_put16( uint8_t *p, uint16_t value )
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)( value >> 8 );
+    return p + 2;
+}
+
+static uint8_t *Link_put32( uint8_t *p, uint32_t value )
+{
+    p = Link_put16( p, (uint16_t)value );
+    return Link_put16( p, (uint16_t)( value >> 16 ) );
+}
+
+static uint16_t Link_get16( const uint8_t *p )
+{
+    return (uint16_t)( p[0] | ( p[1] << 8 ) );
+}
+
+static uint32_t Link_get32( const uint8_t *p )
+{
+    return p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+}
+
+//*****************************************************************************
+// Link_idle()
+//
+// Returns 1 if nothing is waiting to go out, so a frame sent now starts at
+// once. Call it with interrupts off.
+//*****************************************************************************
+static int Link_idle( void )
+{
+    return !( UCA0IE & UCTXIE );
+}
+
+//*****************************************************************************
+// Link_send()
+//
+// COBS-encodes a frame into the transmit ring, and starts sending it if the
+// UART is idle. The frame is dropped if it doesn't fit. Like
+// Uart_sendFrame(), it can be called from ISRs as well as from main
+// context.
+//
+// Returns 1 if the frame was queued, 0 if it was dropped.
+//
+// Arg 1: "frame" is the frame, at most FRAME_MAX bytes
+// Arg 2: "length" is the number of bytes in it
+//*****************************************************************************
+static int Link_send( const uint8_t *frame, unsigned int length )
+{
+    uint8_t      encoded[ FRAME_MAX + 2 ];
+    unsigned int n, k;
+    uint16_t     state;
+
+    n = Uart_encode( frame, length, encoded );
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    if ( ( ( txTail - txHead - 1 ) & TX_MASK ) < n )
+    {
+        __set_interrupt_state( state );
+        return 0;
+    }
+    for ( k = 0; k < n; k++ )
+    {
+        txRing[ txHead ] = encoded[k];
+        txHead = ( txHead + 1 ) & TX_MASK;
+    }
+    if ( Link_idle() )                                                          // Send the first byte; the rest go
+    {                                                                           //  from the transmit interrupt
+        UCA0TXBUF = txRing[ txTail ];
+        txTail    = ( txTail + 1 ) & TX_MASK;
+        UCA0IE   |= UCTXIE;
+    }
+    __set_interrupt_state( state );
+    return 1;
+}
+
+//*****************************************************************************
+// Link_init()
+//
+// Sets up eUSCI_A0 for 115200 baud, 8N1, from the 2MHz SMCLK, and starts
+// pinging the other board. Call it after Timer_init().
+//*****************************************************************************
+void Link_init( void )
+{
+    P4SEL0 |=  ( LINK_TXD | LINK_RXD );                                         // Primary function: eUSCI_A0
+    P4SEL1 &= ~( LINK_TXD | LINK_RXD );
+
+    UCA0CTLW0  = UCSWRST;                                                       // Hold the eUSCI in reset to configure it
+    UCA0CTLW0 |= UCSSEL__SMCLK;
+    UCA0BRW    = 1;                                                             // As eUSCI_A1 (myUart.c)
+    UCA0MCTLW  = UCOS16 | UCBRF_1 | 0x4A00;
+    UCA0CTLW0 &= ~UCSWRST;
+    UCA0IE    |= UCRXIE;
+
+    Timer_start( &pingTimer, LINK_PING_TICKS, LINK_PING_TICKS, Link_ping );
+}
+
+//*****************************************************************************
+// Link_sample()
+//
+// Adds the clock sample from a ping's reply, and picks the best of the
+// last LINK_SAMPLES. Called from the receive interrupt.
+//
+// Arg 1: "sent" is when the ping went out, in our time
+// Arg 2: "received" is when it came in, in theirs
+// Arg 3: "replied" is when the reply went out, in theirs
+// Arg 4: "back" is when the reply came in, in ours
+//*****************************************************************************
+static void Link_sample( uint32_t sent, uint32_t received, uint32_t replied, uint32_t back )
+{
+    LinkSample  *sample = &samples[ sampleNext ];
+    uint32_t     trip   = ( back - sent ) - ( replied - received );
+    unsigned int k;
+
+    if ( (int32_t)trip < 0 )                                                    // Not a reply to a ping of ours
+    {
+        return;
+    }
+    sample->roundTrip = trip;
+    sample->offset    = (int32_t)( received - sent - trip / 2 );
+    sampleNext = ( sampleNext + 1 ) % LINK_SAMPLES;
+    if ( sampleCount < LINK_SAMPLES )
+    {
+        sampleCount++;
+    }
+
+    sample = &samples[0];
+    for ( k = 1; k < sampleCount; k++ )
+    {
+        if ( samples[k].roundTrip < sample->roundTrip )
+        {
+            sample = &samples[k];
+        }
+    }
+    offset    = sample->offset;
+    roundTrip = sample->roundTrip;
+}
+
+//*****************************************************************************
+// Link_show()
+//
+// Shows the other board's progress through its round on B1 to B6.
+//
+// Arg 1: "round" is its round, from 0
+// Arg 2: "steps" is how many steps of it were right
+//*****************************************************************************
+static void Link_show( unsigned int round, unsigned int steps )
+{
+    unsigned int lit = (unsigned int)( (uint32_t)steps * 6 / ( round + 1UL ) );
+    unsigned int k;
+
+    for ( k = 0; k < 6; k++ )
+    {
+        myLCD_showSymbol( ( k < lit ) ? LCD_UPDATE : LCD_CLEAR, LCD_B1 + k, LCD_MEMORY_MAIN );
+    }
+}
+
+//*****************************************************************************
+// Link_frame()
+//
+// Acts on one decoded frame from the other board. Called from the receive
+// interrupt.
+//
+// Arg 1: "frame" is the decoded frame
+// Arg 2: "length" is the number of bytes in it
+//*****************************************************************************
+static void Link_frame( const uint8_t *frame, unsigned int length )
+{
+    uint8_t  reply[ FRAME_MAX ];
+    unsigned int round, steps;
+
+    silentTicks = 0;
+    switch ( frame[0] )
+    {
+    case LINK_PING:
+        if ( ( length >= 5 ) && Link_idle() )                                   // Busy: let the next ping do
+        {
+            reply[0] = LINK_PONG;
+            Link_put32( Link_put32( Link_put32( &reply[1], Link_get32( &frame[1] ) ), rxAt ), Timer_counts() );
+            Link_send( reply, 13 );
+        }
+        break;
+
+    case LINK_PONG:
+        if ( length >= 13 )
+        {
+            Link_sample( Link_get32( &frame[1] ), Link_get32( &frame[5] ), Link_get32( &frame[9] ), rxAt );
+        }
+        break;
+
+    case LINK_START:
+        if ( ( length >= 11 ) && !racing )
+        {
+            inviteSeed    = Link_get32( &frame[1] );
+            inviteLevel   = frame[5];
+            inviteEndless = frame[6];
+            inviteStart   = Link_get32( &frame[7] );
+            invited       = 1;
+        }
+        break;
+
+    case LINK_JOIN:
+        if ( ( length >= 5 ) && inviting && ( Link_get32( &frame[1] ) == ourSeed ) )
+        {
+            joined = 1;
+        }
+        break;
+
+    case LINK_PRESS:
+        if ( ( length >= 10 ) && racing && !theirDone )
+        {
+            round = Link_get16( &frame[1] );
+            steps = Link_get16( &frame[3] );
+            if ( !frame[5] )
+            {
+                theirPresses = (uint32_t)round * ( round + 1 ) / 2 + steps;     // Every step of the rounds before
+                theirLastAt  = Link_get32( &frame[6] ) - offset;
+            }
+            Link_show( round, frame[5] ? 0 : steps );
+        }
+        break;
+
+    case LINK_DONE:
+        if ( ( length >= 9 ) && racing )
+        {
+            theirPresses = Link_get32( &frame[1] );
+            theirLastAt  = Link_get32( &frame[5] ) - offset;
+            theirDone    = 1;
+        }
+        break;
+    }
+}
+
+//*****************************************************************************
+// Link_receive()
+//
+// Adds a received byte to the frame being read, noting when the frame
+// started. A 0x00 ends the frame.
+//
+// Arg 1: "byte" is the byte received
+//*****************************************************************************
+static void Link_receive( uint8_t byte )
+{
+    unsigned int length;
+
+    if ( byte != 0 )
+    {
+        if ( rxLength == 0 )
+        {
+            rxAt = Timer_counts();
+        }
+        if ( rxLength < LINK_RX_BYTES )
+        {
+            rxFrame[ rxLength++ ] = byte;
+        }
+        else
+        {
+            rxOverflow = 1;
+        }
+        return;
+    }
+
+    if ( !rxOverflow && rxLength )                                              // End of a frame
+    {
+        length = Uart_decode( rxFrame, rxLength );
+        if ( length )
+        {
+            Link_frame( rxFrame, length );
+        }
+    }
+    rxLength   = 0;
+    rxOverflow = 0;
+}
+
+
+// eUSCI_A0 Interrupt Service Routine
+#pragma vector=USCI_A0_VECTOR
+__interrupt void USCI_A0_ISR (void)
+{
+    ISR_ENTER( ISR_LINK );
+    switch ( __even_in_range( UCA0IV, USCI_UART_UCTXCPTIFG ) )
+    {
+    case USCI_UART_UCRXIFG:
+        Link_receive( UCA0RXBUF );
+        break;
+
+    case USCI_UART_UCTXIFG:                                                     // Ready for the next byte
+        if ( txTail != txHead )
+        {
+            UCA0TXBUF = txRing[ txTail ];
+            txTail    = ( txTail + 1 ) & TX_MASK;
+        }
+        else
+        {
+            UCA0IE &= ~UCTXIE;
+        }
+        break;
+    }
+    ISR_EXIT( ISR_LINK );
+}
+
+
+//*****************************************************************************
+// Link_ping()
+//
+// The callback of pingTimer: pings the other board, and forgets it if it
+// has gone quiet.
+//
+// Returns 0: there is nothing to wake the game for.
+//*****************************************************************************
+static int Link_ping( Timer *timer )
+{
+    uint8_t ping[5];
+
+    (void)timer;
+    if ( silentTicks < LINK_TIMEOUT_TICKS )
+    {
+        silentTicks += LINK_PING_TICKS;
+    }
+    else
+    {
+        sampleCount = 0;                                                        // No other board (any more)
+    }
+    if ( Link_idle() )
+    {
+        ping[0] = LINK_PING;
+        Link_put32( &ping[1], Timer_counts() );
+        Link_send( ping, sizeof( ping ) );
+    }
+    return 0;
+}
+
+//*****************************************************************************
+// Link_wake()
+//
+// The callback of waitTimer.
+//
+// Returns 1 to wake Link_wait().
+//*****************************************************************************
+static int Link_wake( Timer *timer )
+{
+    (void)timer;
+    waited = 1;
+    return 1;
+}
+
+//*****************************************************************************
+// Link_tick()
+//
+// Sleeps until the next tick.
+//*****************************************************************************
+static void Link_tick( void )
+{
+    __disable_interrupt();
+    waited = 0;
+    Timer_start( &waitTimer, 1, 0, Link_wake );
+    while ( !waited )                                                           // The game's timers can wake us sooner
+    {
+        __bis_SR_register( LPM0_bits | GIE );
+        __disable_interrupt();
+    }
+    __enable_interrupt();
+}
+
+//*****************************************************************************
+// Link_invited()
+//
+// Returns 1 if the other board has invited us to a race that we can still
+// join: one that starts after the next tick. An older invitation is
+// dropped. Use LINK_INVITED, which is 0 without LINK.
+//*****************************************************************************
+int Link_invited( void )
+{
+    uint16_t state;
+    int      valid;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    if ( invited && ( (int32_t)( inviteStart - Timer_counts() ) < 2 * TIMER_TICK_COUNTS ) )
+    {
+        invited = 0;                                                            // Too late to start with it
+    }
+    valid = invited;
+    __set_interrupt_state( state );
+    return valid;
+}
+
+//*****************************************************************************
+// Link_invitation()
+//
+// Takes the other board's invitation, if we can still join it.
+//
+// Returns 1 if there was one: its game is in the arguments, and the other
+// board has been told we are joining.
+//*****************************************************************************
+static int Link_invitation( unsigned long *seed, unsigned int *level, int *endless, uint32_t *start )
+{
+    uint8_t  join[5];
+    uint16_t state;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    if ( !Link_invited() )
+    {
+        __set_interrupt_state( state );
+        return 0;
+    }
+    invited  = 0;
+    *seed    = inviteSeed;
+    *level   = inviteLevel;
+    *endless = inviteEndless;
+    *start   = inviteStart;
+    __set_interrupt_state( state );
+
+    join[0]  = LINK_JOIN;
+    Link_put32( &join[1], *seed );
+    Link_send( join, sizeof( join ) );
+    return 1;
+}
+
+//*****************************************************************************
+// Link_start()
+//
+// Starts a race, after the player has pressed start and picked a level.
+// If the other board has invited us, we join its race instead, and its
+// game replaces ours in the arguments. Otherwise, if there is another
+// board, we invite it to ours. Either way this returns at the start of the
+// race, which is the same moment on both boards.
+//
+// Returns 1 if there is a race, 0 if the game is played alone.
+//
+// Arg 1: "seed" is the seed of the game
+// Arg 2: "level" is its level
+// Arg 3: "endless" is whether it is endless
+//*****************************************************************************
+int Link_start( unsigned long *seed, unsigned int *level, int *endless )
+{
+    uint8_t  start[11];
+    uint32_t startAt;                                                           // In our time
+    unsigned long theirSeed;
+    unsigned int  theirLevel;
+    int           theirEndless;
+
+    racing = 0;
+    if ( !Link_invitation( seed, level, endless, &startAt ) )
+    {
+        if ( !sampleCount )                                                     // Nobody to race
+        {
+            return 0;
+        }
+        ourSeed  = *seed;
+        startAt  = Timer_counts() + LINK_START_COUNTS;
+        joined   = 0;
+        inviting = 1;
+        start[0] = LINK_START;
+        Link_put32( &start[1], ourSeed );
+        start[5] = (uint8_t)*level;
+        start[6] = (uint8_t)*endless;
+        Link_put32( &start[7], startAt + offset );                              // In its time
+        Link_send( start, sizeof( start ) );
+    }
+
+    while ( (int32_t)( startAt - Timer_counts() ) > TIMER_TICK_COUNTS )         // Until the last tick before the start
+    {
+        Link_tick();
+        if ( inviting && invited && ( inviteSeed > ourSeed ) )                  // Invited each other: ours wins
+        {
+            invited = 0;
+        }
+        if ( inviting && Link_invitation( &theirSeed, &theirLevel, &theirEndless, &startAt ) )
+        {
+            *seed    = theirSeed;
+            *level   = theirLevel;
+            *endless = theirEndless;
+            inviting = 0;
+        }
+    }
+    while ( (int32_t)( startAt - Timer_counts() ) > 0 );                        // The last few milliseconds
+    Timer_align();                                                              // Tick with the other board
+
+    if ( inviting && !joined )                                                  // Nobody took our invitation
+    {
+        inviting = 0;
+        return 0;
+    }
+    inviting     = 0;
+    presses      = 0;
+    lastAt       = startAt;
+    theirPresses = 0;
+    theirLastAt  = startAt;
+    theirDone    = 0;
+    racing       = 1;
+    myLCD_showSymbol( LCD_UPDATE, LCD_BATT, LCD_MEMORY_MAIN );                  // The other board's progress
+    Link_show( 0, 0 );
+    return 1;
+}
+
+//*****************************************************************************
+// Link_racing()
+//
+// Returns 1 while a race is on.
+//*****************************************************************************
+int Link_racing( void )
+{
+    return racing;
+}
+
+//*****************************************************************************
+// Link_press()
+//
+// Tells the other board about a press, or a timeout. Use LINK_PRESSED(),
+// which compiles to nothing without LINK.
+//
+// Arg 1: "round" is the round, from 0
+// Arg 2: "steps" is how many steps of the round are right, this one
+//        included if it was
+// Arg 3: "wrong" is 1 if it was the wrong button, or too late
+//*****************************************************************************
+void Link_press( unsigned int round, unsigned int steps, int wrong )
+{
+    uint8_t  press[10];
+    uint32_t at = Timer_counts();
+
+    if ( !racing )
+    {
+        return;
+    }
+    if ( !wrong )
+    {
+        presses = (uint32_t)round * ( round + 1 ) / 2 + steps;                  // Endless races go past 65535
+        lastAt  = at;
+    }
+    press[0] = LINK_PRESS;
+    press[5] = wrong ? 1 : 0;
+    Link_put32( Link_put16( Link_put16( &press[1], round ), steps ) + 1, at );
+    Link_send( press, sizeof( press ) );
+}
+
+//*****************************************************************************
+// Link_result()
+//
+// Ends our side of a race: tells the other board how far we got, and
+// waits until it has finished too, or gone quiet. The result is sent in a
+// TELEMETRY_RACE frame as well.
+//
+// Returns LINK_WON, LINK_LOST or LINK_TIED, or LINK_NO_RACE if there was
+// no race, or the other board went away.
+//*****************************************************************************
+int Link_result( void )
+{
+    uint8_t      done[9];
+    int32_t      margin;                                                        // How much sooner we got there
+    int          result;
+    unsigned int ticks = 0;
+
+    if ( !racing )
+    {
+        return LINK_NO_RACE;
+    }
+    done[0] = LINK_DONE;
+    Link_put32( Link_put32( &done[1], presses ), lastAt );
+    Link_send( done, sizeof( done ) );
+
+    while ( !theirDone && sampleCount )
+    {
+        Link_tick();
+        if ( ++ticks % LINK_PING_TICKS == 0 )                                   // Again, in case it was lost: the
+        {                                                                       //  other board may be waiting for it
+            Link_send( done, sizeof( done ) );
+        }
+    }
+    margin = (int32_t)( theirLastAt - lastAt );
+    if ( !theirDone )
+    {
+        result = LINK_NO_RACE;
+    }
+    else if ( presses != theirPresses )
+    {
+        result = ( presses > theirPresses ) ? LINK_WON : LINK_LOST;
+    }
+    else
+    {
+        result = ( margin > 0 ) ? LINK_WON : ( margin < 0 ) ? LINK_LOST : LINK_TIED;
+    }
+
+    racing = 0;
+    Link_show( 0, 0 );
+    myLCD_showSymbol( LCD_CLEAR, LCD_BATT, LCD_MEMORY_MAIN );
+    Telemetry_race( (uint8_t)result, presses, theirPresses, margin, offset, (uint16_t)roundTrip );
+    return result;
+}
+
+#endif
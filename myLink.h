@@ -0,0 +1,60 @@
+/*
+ * myLink.h
+ *
+ */
+
+#ifndef MYLINK_H_
+#define MYLINK_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+// Define LINK in the project's predefined symbols (a Link build
+// configuration) to race a second board over eUSCI_A0. Without it the link
+// compiles to nothing, and LINK_INVITED and LINK_PRESSED() with it.
+#define LINK_RX_BYTES               16                                          // Longest frame, COBS-encoded
+#define LINK_TX_BYTES               64                                          // Size of the transmit ring (power of 2)
+#define LINK_SAMPLES                8                                           // Clock samples the best one is taken from
+#define LINK_PING_TICKS             41                                          // Ticks between pings (about 0.5s)
+#define LINK_TIMEOUT_TICKS          246                                         // The other board is gone after 3s of silence
+#define LINK_START_COUNTS           16384                                       // ACLK counts from an invitation to the start (0.5s)
+
+// Frames between the boards. Each is one COBS frame that starts with its
+// type. Times are in Timer_counts() of the board that sends the frame,
+// unless it says otherwise.
+#define LINK_PING                   0                                           // sent (u32)
+#define LINK_PONG                   1                                           // ping sent (u32), ping received (u32), sent (u32)
+#define LINK_START                  2                                           // seed (u32), level, endless, start (u32, receiver's time)
+#define LINK_JOIN                   3                                           // seed (u32) of the invitation taken
+#define LINK_PRESS                  4                                           // round, steps right (u16), wrong, at (u32)
+#define LINK_DONE                   5                                           // presses right, last one at (u32)
+
+// Results of a race, from Link_result()
+#define LINK_NO_RACE                0                                           // Played alone, or the other board went away
+#define LINK_WON                    1
+#define LINK_LOST                   2
+#define LINK_TIED                   3
+
+#ifdef LINK
+
+//***** Prototypes ************************************************************
+void Link_init( void );                                                         // eUSCI_A0 at 115200 baud, start pinging (after Timer_init)
+int  Link_invited( void );                                                      // Use LINK_INVITED instead
+int  Link_start( unsigned long *, unsigned int *, int * );                      // Start a race, or join one; 1 if racing
+int  Link_racing( void );                                                       // Is a race on?
+void Link_press( unsigned int, unsigned int, int );                             // Tell the other board about a press
+int  Link_result( void );                                                       // Wait for the other board, LINK_xxx
+
+//***** Macros ****************************************************************
+#define LINK_INVITED                ( Link_invited() )                          // The other board has started a race
+#define LINK_PRESSED( round, steps, wrong )     Link_press( round, steps, wrong )
+
+#else
+
+#define LINK_INVITED                0
+#define LINK_PRESSED( round, steps, wrong )     do { } while ( 0 )
+
+#endif
+
+
+#endif /* MYLINK_H_ */
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// myMessage.c  ('FR6989 Launchpad)
+//
+// Scrolls the packed messages of myMessageData.c across the LCD.
+//
+// The messages are made by tools/msgpack.c from tools/messages.txt: each
+// one is a string of 4-bit codes into messageGlyph[], a dictionary of the
+// two LCD memory bytes of a position, so a character is drawn without
+// looking its pattern up. A code below MESSAGE_ESCAPE is the entry itself,
+// and MESSAGE_ESCAPE is followed by one more code, so reading a character
+// takes at most two nibbles.
+//
+// A scroll moves what the LCD shows one position left and draws only the
+// character coming in at the right: the LCD memory is the frame buffer.
+// Each frame costs the same, however long the message, where a frame of
+// ScrollWords() looks up all six characters (BENCH_MESSAGE_FRAME against
+// BENCH_SCROLL_FRAME). Like myLCD_showChar(), it relies on a position
+// being two whole bytes of LCD memory in 4-mux mode.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myMessage.h"
+#include "myLcd.h"
+#include "myClocks.h"
+
+
+//*****************************************************************************
+// Message_length()
+//
+// Returns the number of characters in a message.
+//
+// Arg 1: "id" is one of the MSG_xxx IDs
+//*****************************************************************************
+unsigned int Message_length( uint8_t id )
+{
+    return messageLength[ id ];
+}
+
+//*****************************************************************************
+// Message_open()
+//
+// Sets a reader to the first character of a message.
+//
+// Arg 1: "reader" is the reader
+// Arg 2: "id" is one of the MSG_xxx IDs
+//*****************************************************************************
+void Message_open( MessageReader *reader, uint8_t id )
+{
+    reader->nibble = messageStart[ id ];
+    reader->left   = messageLength[ id ];
+}
+
+//*****************************************************************************
+// Message_next()
+//
+// Reads the next character of a message. After the last one, every
+// character is a blank.
+//
+// Returns its entry in messageGlyph[].
+//*****************************************************************************
+RAMFUNC uint8_t Message_next( MessageReader *reader )
+{
+    uint8_t byte, glyph;
+
+    if ( reader->left == 0 )
+    {
+        return MESSAGE_BLANK;
+    }
+    reader->left--;
+
+    byte  = messageCode[ reader->nibble >> 1 ];
+    glyph = ( reader->nibble++ & 1 ) ? byte >> 4 : byte & 0x0F;
+    if ( glyph == MESSAGE_ESCAPE )                                              // One more code
+    {
+        byte   = messageCode[ reader->nibble >> 1 ];
+        glyph += ( reader->nibble++ & 1 ) ? byte >> 4 : byte & 0x0F;
+    }
+    return glyph;
+}
+
+//*****************************************************************************
+// Message_showGlyph()
+//
+// Draws an entry of messageGlyph[] at a position of the LCD.
+//
+// Arg 1: "glyph" is the entry, as Message_next() returns it
+// Arg 2: "position" is 1 to 6, from the left
+//*****************************************************************************
+RAMFUNC void Message_showGlyph( uint8_t glyph, int position )
+{
+    if ( ( position >= 1 ) && ( position <= LCD_NUM_CHAR ) && ( glyph < MESSAGE_GLYPHS ) )
+    {
+        LCDMEM[ SegmentLoc[ position - 1 ][0] / 2 ] = messageGlyph[ glyph ][0];
+        LCDMEM[ SegmentLoc[ position - 1 ][2] / 2 ] = messageGlyph[ glyph ][1];
+    }
+}
+
+//*****************************************************************************
+// Message_scroll()
+//
+// Shows the next frame of a scrolling message: moves every position one to
+// the left, and draws the message's next character at position 6.
+//
+// Arg 1: "reader" is the message being scrolled
+//*****************************************************************************
+RAMFUNC void Message_scroll( MessageReader *reader )
+{
+    int position;
+
+    for ( position = 0; position < LCD_NUM_CHAR - 1; position++ )
+    {
+        LCDMEM[ SegmentLoc[ position ][0] / 2 ] = LCDMEM[ SegmentLoc[ position + 1 ][0] / 2 ];
+        LCDMEM[ SegmentLoc[ position ][2] / 2 ] = LCDMEM[ SegmentLoc[ position + 1 ][2] / 2 ];
+    }
+    Message_showGlyph( Message_next( reader ), LCD_NUM_CHAR );
+}
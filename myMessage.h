@@ -0,0 +1,31 @@
+/*
+ * myMessage.h
+ *
+ */
+
+#ifndef MYMESSAGE_H_
+#define MYMESSAGE_H_
+
+#include <stdint.h>
+#include "myMessageData.h"
+
+//***** Defines ***************************************************************
+#define MESSAGE_BLANK               0                                           // Dictionary entry of a blank position
+#define MESSAGE_ESCAPE              15                                          // Code: the entry is 15 + the next code
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint16_t nibble;                                                            // Next code to read, in messageCode[]
+    uint8_t  left;                                                              // Characters not read yet
+} MessageReader;
+
+//***** Prototypes ************************************************************
+unsigned int Message_length( uint8_t );                                         // Characters in a message
+void         Message_open( MessageReader *, uint8_t );                          // Start reading a message
+uint8_t      Message_next( MessageReader * );                                   // Its next glyph, blank after the end
+void         Message_showGlyph( uint8_t, int );                                 // Draw a glyph at position 1-6
+void         Message_scroll( MessageReader * );                                 // Move the display left, next glyph in
+
+
+#endif /* MYMESSAGE_H_ */
@@ -0,0 +1,62 @@
+// ----------------------------------------------------------------------------
+// myMessageData.c  ('FR6989 Launchpad)
+//
+// The messages of tools/messages.txt, packed by tools/msgpack.c. Don't edit
+// it: change the messages and run the tool again. See myMessage.c.
+//
+// 5 messages, 76 characters: 42 bytes of code and 44 of patterns.
+// ----------------------------------------------------------------------------
+
+#include "myMessageData.h"
+
+const uint8_t messageGlyph[ MESSAGE_GLYPHS ][ 2 ] =
+{
+    { 0x00, 0x00 },                                                             //  0: " ", used 12 times
+    { 0x9F, 0x00 },                                                             //  1: "E", used 9 times
+    { 0xB7, 0x00 },                                                             //  2: "S", used 9 times
+    { 0xFC, 0x00 },                                                             //  3: "O", used 8 times
+    { 0xCF, 0x02 },                                                             //  4: "R", used 6 times
+    { 0x6C, 0x82 },                                                             //  5: "N", used 4 times
+    { 0x1C, 0x00 },                                                             //  6: "L", used 3 times
+    { 0x90, 0x50 },                                                             //  7: "I", used 3 times
+    { 0x8F, 0x00 },                                                             //  8: "F", used 2 times
+    { 0x6C, 0x0A },                                                             //  9: "W", used 2 times
+    { 0x6F, 0x00 },                                                             // 10: "H", used 2 times
+    { 0xBD, 0x00 },                                                             // 11: "G", used 2 times
+    { 0x9C, 0x00 },                                                             // 12: "C", used 2 times
+    { 0x00, 0xB0 },                                                             // 13: "Y", used 2 times
+    { 0x7C, 0x00 },                                                             // 14: "U", used 2 times
+    { 0xEF, 0x00 },                                                             // 15: "A", used 2 times
+    { 0xCF, 0x00 },                                                             // 16: "P", used 1 time
+    { 0x60, 0x20 },                                                             // 17: "1", used 1 time
+    { 0xDB, 0x00 },                                                             // 18: "2", used 1 time
+    { 0xF0, 0x50 },                                                             // 19: "D", used 1 time
+    { 0x6C, 0xA0 },                                                             // 20: "M", used 1 time
+    { 0x0C, 0x28 }                                                              // 21: "V", used 1 time
+};
+
+const uint8_t messageLength[ MESSAGE_COUNT ] =
+{
+    26,                                                                         // MSG_PRESS_START
+    14,                                                                         // MSG_NEW_HIGH_SCORE
+    7,                                                                          // MSG_YOU_WIN
+    21,                                                                         // MSG_GAME_OVER
+    8                                                                           // MSG_YOU_LOSE
+};
+
+const uint16_t messageStart[ MESSAGE_COUNT ] =
+{
+    0,                                                                          // MSG_PRESS_START
+    30,                                                                         // MSG_NEW_HIGH_SCORE
+    44,                                                                         // MSG_YOU_WIN
+    51,                                                                         // MSG_GAME_OVER
+    76                                                                          // MSG_YOU_LOSE
+};
+
+const uint8_t messageCode[ 42 ] =
+{
+    0x1F, 0x14, 0x22, 0x20, 0x2F, 0x30, 0x04, 0xF2, 0x03, 0x38, 0x04, 0x51,
+    0x4F, 0x16, 0x22, 0x15, 0x09, 0x7A, 0xAB, 0x20, 0x3C, 0x14, 0x3D, 0x0E,
+    0x79, 0xB5, 0x0F, 0x5F, 0x01, 0xF3, 0x16, 0x04, 0x78, 0xF5, 0x60, 0x20,
+    0x3C, 0x14, 0x3D, 0x0E, 0x36, 0x12
+};
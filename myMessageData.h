@@ -0,0 +1,29 @@
+/*
+ * myMessageData.h
+ *
+ * Made by tools/msgpack.c from tools/messages.txt. Don't edit it: change the
+ * messages and run the tool again.
+ */
+
+#ifndef MYMESSAGEDATA_H_
+#define MYMESSAGEDATA_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define MSG_PRESS_START             0                                           // "PRESS S1 OR S2 FOR ENDLESS"
+#define MSG_NEW_HIGH_SCORE          1                                           // "NEW HIGH SCORE"
+#define MSG_YOU_WIN                 2                                           // "YOU WIN"
+#define MSG_GAME_OVER               3                                           // "GAME OVER FINAL SCORE"
+#define MSG_YOU_LOSE                4                                           // "YOU LOSE"
+#define MESSAGE_COUNT               5
+#define MESSAGE_GLYPHS              22
+
+//***** Global Variables ******************************************************
+extern const uint8_t  messageGlyph[ MESSAGE_GLYPHS ][ 2 ];                      // Segment patterns, blank first
+extern const uint8_t  messageLength[ MESSAGE_COUNT ];                           // Characters in each message
+extern const uint16_t messageStart[ MESSAGE_COUNT ];                            // Nibble its code starts at
+extern const uint8_t  messageCode[ 42 ];                                        // Codes, low nibble first
+
+
+#endif /* MYMESSAGEDATA_H_ */
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// myPower.c  ('FR6989 Launchpad)
+//
+// Standby for the screens where the game just waits for a button.
+//
+// Power_sleep() turns off the LEDs and the CPU but keeps ACLK running, so
+// the LCD keeps showing the last frame (LPM3). A software timer (myTimer.c)
+// ends the sleep after a timeout. Power_deepSleep() also turns off the LCD and
+// ACLK (LPM4, or LPM4.5 with POWER_USE_LPMX5). Either one wakes on a P1
+// interrupt from button 1 or button 2.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myPower.h"
+#include "myTrace.h"
+#include "myUart.h"
+#include "myRemote.h"
+#include "myTimer.h"
+#include "myIsr.h"
+
+
+//***** Defines ***************************************************************
+#define RED_LED             0x0001      // P1.0 is the red LED
+#define GREEN_LED           0x0080      // P9.7 is the green LED
+#define BUTTONS             0x0006      // P1.1 and P1.2 are the buttons
+
+
+//***** Global Variables ******************************************************
+static volatile int buttonWoke = 0;                                             // Set by the Port 1 ISR
+static Timer        standbyTimer;                                               // Ends Power_sleep()
+
+
+//*****************************************************************************
+// Power_timeout()
+//
+// The callback of standbyTimer: wakes the CPU at the end of the sleep.
+//*****************************************************************************
+static int Power_timeout( Timer *timer )
+{
+    (void)timer;
+    return 1;
+}
+
+
+//*****************************************************************************
+// Power_init()
+//
+// Clears the button interrupt flag that is left set when a button press
+// woke the board from LPM4.5. Call it after the GPIO are initialized.
+//*****************************************************************************
+void Power_init( void )
+{
+    P1IE  &= ~BUTTONS;
+    P1IES |=  BUTTONS;                                                          // Interrupt on the falling edge (press)
+    P1IFG &= ~BUTTONS;
+}
+
+//*****************************************************************************
+// Power_sleep()
+//
+// Sleeps in LPM3 with the LCD still on and the LEDs off, until a button is
+// pressed or the timeout runs out. The LEDs are put back afterwards.
+//
+// Returns 1 if a button woke the board, 0 if the timeout ran out.
+//
+// Arg 1: "seconds" is the longest time to sleep, at most 127 seconds
+//*****************************************************************************
+int Power_sleep( unsigned int seconds )
+{
+    uint8_t leds1 = P1OUT & RED_LED;                                            // Remember which LEDs were on
+    uint8_t leds9 = P9OUT & GREEN_LED;
+
+    P1OUT &= ~RED_LED;
+    P9OUT &= ~GREEN_LED;
+
+    Timer_start( &standbyTimer, (uint16_t)TIMER_TICKS( seconds * 1000UL ), 0, Power_timeout );
+
+    TRACE( TRACE_SLEEP, 3 );                                                    // While Timer_0 can still count its wraps
+    __disable_interrupt();
+    buttonWoke = 0;
+    P1IFG &= ~BUTTONS;
+    P1IE  |=  BUTTONS;
+    if ( ( BUTTONS_IN & BUTTONS ) == BUTTONS )                                  // Don't sleep through a press that is already down
+    {
+        __bis_SR_register( LPM3_bits | GIE );                                   // GIE and sleep together, so no wakeup is missed
+    }
+    else
+    {
+        buttonWoke = 1;
+        __enable_interrupt();
+    }
+
+    P1IE &= ~BUTTONS;
+    Timer_stop( &standbyTimer );
+    if ( ( BUTTONS_IN & BUTTONS ) != BUTTONS )                                  // A press from myRemote wakes the
+    {                                                                           //  board without a P1 interrupt
+        buttonWoke = 1;
+    }
+    TRACE( TRACE_WAKE, buttonWoke );
+
+    P1OUT |= leds1;
+    P9OUT |= leds9;
+
+    return buttonWoke;
+}
+
+//*****************************************************************************
+// Power_deepSleep()
+//
+// Turns off the LCD and the LEDs and sleeps in LPM4 until a button is
+// pressed. With POWER_USE_LPMX5 the board goes to LPM4.5 instead, and the
+// button press wakes it through a reset, so this does not return. Like
+// Power_sleep(), it checks the buttons after clearing their flags, so a
+// press that came after the caller's last poll isn't slept through.
+//
+// In a LINK build the body is compiled out, since LPM4 would stop ACLK,
+// which the link keeps time on. It then returns straight away with the LCD
+// still on, and the caller keeps waiting for a button in LPM3.
+//*****************************************************************************
+void Power_deepSleep( void )
+{
+#ifndef LINK
+    uint8_t leds1 = P1OUT & RED_LED;
+    uint8_t leds9 = P9OUT & GREEN_LED;
+
+    P1OUT &= ~RED_LED;
+    P9OUT &= ~GREEN_LED;
+    LCD_C_off( LCD_C_BASE );
+    while ( Uart_busy() );                                                      // LPM4 stops SMCLK: let the UART finish
+
+    TRACE( TRACE_SLEEP, 4 );
+    __disable_interrupt();
+    P1IFG &= ~BUTTONS;
+    P1IE  |=  BUTTONS;
+    if ( ( BUTTONS_IN & BUTTONS ) == BUTTONS )                                  // Don't sleep through a press that is already down
+    {
+#ifdef POWER_USE_LPMX5
+        PMMCTL0 = PMMPW | ( PMMCTL0 & 0x00FF ) | PMMREGOFF;                     // LPM4 becomes LPM4.5
+#endif
+        __bis_SR_register( LPM4_bits | GIE );
+    }
+    else
+    {
+        __enable_interrupt();
+    }
+
+    P1IE &= ~BUTTONS;
+    TRACE( TRACE_WAKE, 1 );
+    LCD_C_on( LCD_C_BASE );                                                     // LCD memory kept its contents
+    P1OUT |= leds1;
+    P9OUT |= leds9;
+#endif
+}
+
+
+// Port 1 Interrupt Service Routine
+#pragma vector=PORT1_VECTOR
+__interrupt void Port_1 (void)
+{
+    ISR_ENTER( ISR_PORT1 );
+    P1IFG &= ~BUTTONS;                                                          // Clear the button flags
+    buttonWoke = 1;
+    __bic_SR_register_on_exit( LPM4_bits );                                     // Wake up from LPM3 or LPM4
+    ISR_EXIT( ISR_PORT1 );
+}
@@ -0,0 +1,28 @@
+/*
+ * myPower.h
+ *
+ */
+
+#ifndef MYPOWER_H_
+#define MYPOWER_H_
+
+//***** Prototypes ************************************************************
+void Power_init( void );                                                        // Clear any wakeup left from LPMx.5
+int  Power_sleep( unsigned int );                                               // LPM3, LCD on, until a button or timeout
+void Power_deepSleep( void );                                                   // LCD off, LPM4 (or LPM4.5) until a button
+
+//***** Defines ***************************************************************
+#define STANDBY_DISPLAY_SECONDS     30                                          // Time the LCD stays on before deep sleep (max 127)
+
+// Define POWER_USE_LPMX5 in the project's predefined symbols to use LPM4.5
+// instead of LPM4 for deep sleep. LPM4.5 turns off the core regulator, so
+// RAM is lost and a button press wakes the board through a reset.
+//
+// A LINK build (myLink.h) doesn't deep sleep: the body of Power_deepSleep()
+// is compiled out, so it leaves the LCD on and doesn't sleep at all. Its
+// callers go back to waiting for a button, in LPM3 between Timer_1 ticks
+// or in Power_sleep(), so ACLK keeps running and the board keeps time with
+// the other board.
+
+
+#endif /* MYPOWER_H_ */
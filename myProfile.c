@@ -0,0 +1,74 @@
+// ----------------------------------------------------------------------------
+// myProfile.c  ('FR6989 Launchpad)
+//
+// Statistical profiler: where the CPU spends its time, over a whole game.
+//
+// Timer_0 CCR1 interrupts every PROFILE_PERIOD SMCLK counts, and its ISR
+// (Profile_isr in myProfileIsr.asm) adds one to the bucket of the program
+// counter it interrupted. The histogram is sent as TELEMETRY_PROFILE frames
+// at the end of each game; tools/profile.c matches the buckets with the
+// functions in the ELF file, so delay(), the button polls, the LCD writes
+// and the driverlib calls each show up with their share of the samples.
+//
+// Timer_0 counts SMCLK, which stops in LPM3 and LPM4, so time asleep isn't
+// sampled. Interrupts don't nest: a sample that falls due in another ISR is
+// taken as it returns, so ISR time is counted against the code it
+// interrupted.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include <string.h>
+#include "myProfile.h"
+#include "myTelemetry.h"
+#include "myUart.h"
+
+#ifdef PROFILE
+
+//***** Global Variables ******************************************************
+volatile uint16_t profileCounts[ PROFILE_BUCKETS ];                             // Written by Profile_isr
+volatile uint32_t profileSamples = 0;
+volatile uint32_t profileOutside = 0;
+
+
+//*****************************************************************************
+// Profile_start()
+//
+// Schedules the first sample. Call it once Timer_0 is counting.
+//*****************************************************************************
+void Profile_start( void )
+{
+    TA0CCR1  = TA0R + PROFILE_PERIOD;
+    TA0CCTL1 = CCIE;
+}
+
+//*****************************************************************************
+// Profile_dump()
+//
+// Sends the histogram and the sample counts, clears them and starts
+// sampling again. Sampling is stopped meanwhile, so the dump doesn't
+// profile itself. Each frame waits for the UART to drain, so none are
+// dropped.
+//*****************************************************************************
+void Profile_dump( void )
+{
+    unsigned int first = 0;
+
+    TA0CCTL1 = 0;
+
+    while ( first < PROFILE_BUCKETS )
+    {
+        while ( Uart_busy() );
+        first = Telemetry_profile( (const uint16_t *)profileCounts, first );
+    }
+    while ( Uart_busy() );
+    Telemetry_counter( COUNTER_PROFILE_SAMPLES, profileSamples );
+    Telemetry_counter( COUNTER_PROFILE_OUTSIDE, profileOutside );
+
+    memset( (void *)profileCounts, 0, sizeof( profileCounts ) );
+    profileSamples = 0;
+    profileOutside = 0;
+    Profile_start();
+}
+
+#endif /* PROFILE */
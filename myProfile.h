@@ -0,0 +1,46 @@
+/*
+ * myProfile.h
+ *
+ */
+
+#ifndef MYPROFILE_H_
+#define MYPROFILE_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+// Define PROFILE in the project's predefined symbols (a Profile build
+// configuration) to sample the program counter. Without it the profiler
+// compiles to nothing. The settings below can be overridden there too.
+#ifndef PROFILE_PERIOD
+#define PROFILE_PERIOD              1999                                        // SMCLK counts between samples (about 1 kHz)
+#endif
+#ifndef PROFILE_BASE
+#define PROFILE_BASE                0x4400                                      // Start of the sampled code (FRAM)
+#endif
+#ifndef PROFILE_SHIFT
+#define PROFILE_SHIFT               6                                           // Bucket size, log2 of bytes
+#endif
+#ifndef PROFILE_BUCKETS
+#define PROFILE_BUCKETS             192                                         // Buckets in the histogram (at most 256)
+#endif
+
+#if PROFILE_BUCKETS > 256
+#error "PROFILE_BUCKETS must be at most 256"                                   // Sent as a byte
+#endif
+
+// The buckets cover PROFILE_BASE to PROFILE_BASE + ( PROFILE_BUCKETS <<
+// PROFILE_SHIFT ) - 1, 12K by default. Samples anywhere else (code above
+// 64K, or copied to RAM) are only counted, in profileOutside.
+
+//***** Prototypes ************************************************************
+void Profile_start( void );                                                     // Start sampling (after Timer_0 is running)
+void Profile_dump( void );                                                      // Send the histogram, then start over
+
+//***** Global Variables ******************************************************
+extern volatile uint16_t profileCounts[ PROFILE_BUCKETS ];                      // Samples per bucket, stop at 0xFFFF
+extern volatile uint32_t profileSamples;                                        // All samples taken
+extern volatile uint32_t profileOutside;                                        // Samples outside the buckets
+
+
+#endif /* MYPROFILE_H_ */
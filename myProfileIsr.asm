@@ -0,0 +1,58 @@
+;-------------------------------------------------------------------------------
+; myProfileIsr.asm  ('FR6989 Launchpad)
+;
+; Timer_0 CCR1 ISR of the profiler (see myProfile.c).
+;
+; It is written in assembly because it reads the program counter the
+; interrupt pushed: the CPU stacks PC 15:0 and then SR, with PC 19:16 in
+; the top four bits of the SR word, and a C ISR's prologue pushes an
+; unknown number of registers on top of them. Only R15 is used, saved in
+; full (20 bits), so the ISR is right for either code and data model.
+;
+; About 70 cycles a sample at the default bucket size, under 2% of a 4 MHz
+; MCLK at 1 kHz.
+;-------------------------------------------------------------------------------
+            .cdecls C, LIST, "msp430.h"
+            .cdecls C, LIST, "myProfile.h"
+
+            .if $isdefed("PROFILE")
+
+            .ref    profileCounts
+            .ref    profileSamples
+            .ref    profileOutside
+            .def    Profile_isr
+
+            .sect   ".text:_isr"                        ; ISRs must be below 64K
+Profile_isr:
+            pushm.a #1, R15                             ; Stack: R15, SR, PC
+            bic.w   #CCIFG, &TA0CCTL1
+            add.w   #PROFILE_PERIOD, &TA0CCR1           ; Next sample, without drift
+            add.w   #1, &profileSamples
+            adc.w   &profileSamples + 2
+
+            bit.w   #0xF000, 4(SP)                      ; PC 19:16: above 64K?
+            jnz     outside
+            mov.w   6(SP), R15                          ; PC 15:0
+            sub.w   #PROFILE_BASE, R15
+            jlo     outside                             ; Below the buckets
+            .loop   PROFILE_SHIFT
+            rrum.w  #1, R15
+            .endloop
+            cmp.w   #PROFILE_BUCKETS, R15
+            jhs     outside                             ; Above the buckets
+            rla.w   R15
+            add.w   #1, profileCounts(R15)
+            jnc     done
+            mov.w   #0xFFFF, profileCounts(R15)         ; Stop at 0xFFFF rather than wrap
+            jmp     done
+
+outside:    add.w   #1, &profileOutside
+            adc.w   &profileOutside + 2
+
+done:       popm.a  #1, R15
+            reti
+
+            .intvec TIMER0_A1_VECTOR, Profile_isr
+
+            .endif
+            .end
@@ -0,0 +1,172 @@
+// ----------------------------------------------------------------------------
+// myRandom.c  ('FR6989 Launchpad)
+//
+// Entropy pool and pseudo-random number generator for the game.
+//
+// The pool collects cheap, noisy samples while the game waits for the player:
+//    - Timer_0 (SMCLK from the DCO) jitter on every poll of the buttons
+//    - the beat between the LFXT crystal (ACLK, Timer_1) and the DCO
+//    - the exact moment the player presses a button
+//    - optionally, ADC noise from the internal temperature sensor
+//
+// Random_seed() folds the pool into the state of a 32-bit xorshift
+// generator, which then produces the game's random numbers.
+//
+// Random_at() is a counter-based generator: output k for a given seed is
+// computed directly, without stepping through outputs 0..k-1 and without
+// any state. The game uses it to regenerate any step of the sequence from
+// the seed alone, so a sequence of any length needs constant RAM.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myRandom.h"
+
+
+//***** Global Variables ******************************************************
+static uint16_t pool[ RANDOM_POOL_WORDS ];                                      // Entropy pool
+static uint16_t poolIndex = 0;                                                  // Next pool word to stir into
+static uint32_t state     = 0;                                                  // xorshift generator state
+
+
+//*****************************************************************************
+// Random_stir()
+//
+// Mixes one 16-bit sample into the entropy pool. Each sample is rotated into
+// the next pool word so that repeated samples do not cancel each other out.
+//
+// Arg 1: "sample" is the value to be mixed into the pool
+//*****************************************************************************
+void Random_stir( uint16_t sample )
+{
+    uint16_t word;
+
+    word = pool[ poolIndex ];
+    word = ( word << 5 ) | ( word >> 11 );                                      // Rotate left by 5
+    pool[ poolIndex ] = word ^ sample;
+    poolIndex = ( poolIndex + 1 ) & ( RANDOM_POOL_WORDS - 1 );
+}
+
+//*****************************************************************************
+// Random_sampleClockBeat()
+//
+// Timer_1 counts ACLK (LFXT crystal) while Timer_0 counts SMCLK (DCO). The
+// two oscillators are not locked to each other, so the number of DCO counts
+// between two ACLK edges jitters. This routine times RANDOM_BEAT_SAMPLES ACLK
+// edges and stirs the Timer_0 value at each edge into the pool.
+//
+// Timer_1 must already be running. This takes about 0.5ms.
+//*****************************************************************************
+void Random_sampleClockBeat( void )
+{
+    unsigned int i;
+    uint16_t edge;
+
+    for ( i = 0; i < RANDOM_BEAT_SAMPLES; i++ )
+    {
+        edge = TA1R;
+        while ( TA1R == edge );                                                 // Wait for the next ACLK edge
+        Random_stir( TA0R );                                                    // DCO counts at that edge
+    }
+}
+
+//*****************************************************************************
+// Random_sampleAdc()
+//
+// Converts the internal temperature sensor a few times and stirs the noisy
+// low bits of each result into the pool. The ADC is turned off again
+// afterwards. Does nothing unless RANDOM_USE_ADC is defined.
+//*****************************************************************************
+void Random_sampleAdc( void )
+{
+#ifdef RANDOM_USE_ADC
+    unsigned int i;
+
+    REFCTL0    |= REFON;                                                        // Temperature sensor needs the reference
+    ADC12CTL0   = ADC12SHT0_2 | ADC12ON;                                        // 16 cycle sample time, ADC on
+    ADC12CTL1   = ADC12SHP;                                                     // Use the sampling timer
+    ADC12CTL3   = ADC12TCMAP;                                                   // Map temperature sensor to channel 30
+    ADC12MCTL0  = ADC12INCH_30;
+
+    for ( i = 0; i < 4; i++ )
+    {
+        ADC12CTL0 |= ADC12ENC | ADC12SC;                                        // Start a conversion
+        while ( !( ADC12IFGR0 & ADC12IFG0 ) );                                  // Wait for it to finish
+        Random_stir( ADC12MEM0 ^ TA0R );                                        // Reading MEM0 clears the flag
+    }
+
+    ADC12CTL0 &= ~ADC12ENC;
+    ADC12CTL0 &= ~ADC12ON;                                                      // Turn the ADC back off
+    REFCTL0   &= ~REFON;
+#endif
+}
+
+//*****************************************************************************
+// Random_seed()
+//
+// Folds the entropy pool into the xorshift state. The pool words are run
+// through a 32-bit hash finalizer so that every pool bit affects every state
+// bit. The state is never left at 0, which xorshift cannot leave.
+//*****************************************************************************
+void Random_seed( void )
+{
+    uint32_t h;
+
+    h  = ( (uint32_t)pool[0] << 16 ) | pool[1];
+    h ^= ( (uint32_t)pool[2] << 16 ) | pool[3];
+    h ^= state;                                                                 // Keep anything left from an earlier game
+    h ^= h >> 16;
+    h *= 0x85EBCA6BUL;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35UL;
+    h ^= h >> 16;
+
+    if ( h == 0 )
+    {
+        h = 0x6D2B79F5UL;
+    }
+    state = h;
+}
+
+//*****************************************************************************
+// Random_next()
+//
+// Returns the next value of a 32-bit xorshift generator (shifts 13, 17, 5).
+// Random_seed() must be called first.
+//*****************************************************************************
+uint32_t Random_next( void )
+{
+    uint32_t x = state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+
+    return x;
+}
+
+//*****************************************************************************
+// Random_at()
+//
+// Returns output number "counter" of the counter-based generator for "seed".
+// The seed and counter are combined with a Weyl increment and then run
+// through the same 32-bit hash finalizer used by Random_seed(). Every call
+// costs the same regardless of the counter value.
+//
+// Arg 1: "seed" selects the sequence (usually taken from Random_next())
+// Arg 2: "counter" selects the output within that sequence
+//*****************************************************************************
+uint32_t Random_at( uint32_t seed, uint32_t counter )
+{
+    uint32_t h;
+
+    h  = seed + ( counter + 1 ) * 0x9E3779B9UL;                                 // Weyl sequence keeps counters apart
+    h ^= h >> 16;
+    h *= 0x85EBCA6BUL;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35UL;
+    h ^= h >> 16;
+
+    return h;
+}
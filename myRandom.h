@@ -0,0 +1,27 @@
+/*
+ * myRandom.h
+ *
+ */
+
+#ifndef MYRANDOM_H_
+#define MYRANDOM_H_
+
+#include <stdint.h>
+
+//***** Prototypes ************************************************************
+void     Random_stir( uint16_t );                                               // Mix one 16-bit sample into the entropy pool
+void     Random_sampleClockBeat( void );                                        // Mix in the LFXT (ACLK) vs. DCO (SMCLK) beat
+void     Random_sampleAdc( void );                                              // Mix in ADC noise (only with RANDOM_USE_ADC)
+void     Random_seed( void );                                                   // Fold the entropy pool into the generator state
+uint32_t Random_next( void );                                                   // Next 32-bit output of the xorshift generator
+uint32_t Random_at( uint32_t, uint32_t );                                       // Counter-based output number 'counter' for 'seed'
+
+//***** Defines ***************************************************************
+#define RANDOM_POOL_WORDS           4                                           // 16-bit words in the entropy pool
+#define RANDOM_BEAT_SAMPLES         16                                          // ACLK edges timed by Random_sampleClockBeat()
+
+// Define RANDOM_USE_ADC in the project's predefined symbols to also mix the
+// noise of the internal temperature sensor into the pool.
+
+
+#endif /* MYRANDOM_H_ */
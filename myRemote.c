@@ -0,0 +1,276 @@
+// ----------------------------------------------------------------------------
+// myRemote.c  ('FR6989 Launchpad)
+//
+// Remote control over the backchannel UART, for automated testing.
+//
+// A host can hold the buttons down, wait, and read back the LEDs and the LCD
+// memory. Held buttons are merged into BUTTONS_IN, so the game can't tell
+// them from real presses. Button and wait commands are timed in Timer_1
+// ticks (myTimer.h) and run from a timer that only runs while there is
+// something queued, so a board nobody talks to never wakes up for it.
+// tools/runner.c uses this to play scripted games, on a LaunchPad or on
+// the simulated board in tools/sim.
+//
+// Commands are COBS frames, like the telemetry going the other way, and are
+// decoded in the eUSCI_A1 receive interrupt. A frame that is too long or
+// malformed is ignored. Note that LPM4 stops the clocks the UART and Timer_1
+// run from, so the board can't be driven while it is in deep sleep.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myRemote.h"
+#include "myTelemetry.h"
+#include "myUart.h"
+#include "myTimer.h"
+#include "myStack.h"
+#include "myIsr.h"
+
+
+//***** Defines ***************************************************************
+#define RED_LED             0x0001      // P1.0 is the red LED
+#define GREEN_LED           0x0080      // P9.7 is the green LED
+#define QUEUE_MASK          ( REMOTE_QUEUE - 1 )
+
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint16_t ticks;                                                             // Ticks left before it runs
+    uint8_t  command;                                                           // REMOTE_BUTTONS or REMOTE_WAIT
+    uint8_t  buttons;                                                           // P1 button bits, for REMOTE_BUTTONS
+} RemoteEvent;
+
+
+//***** Global Variables ******************************************************
+volatile uint8_t remoteButtons = 0;
+volatile uint8_t remoteQueued  = 0;
+
+static RemoteEvent queue[ REMOTE_QUEUE ];
+static Timer       queueTimer;                                                  // Ticks while there are events
+static uint8_t     queueHead = 0;                                               // Next event to run
+
+static uint32_t    seedNext;                                                    // Seed for the next game
+static uint8_t     seedSet = 0;                                                 //  if set by REMOTE_SEED
+
+static uint8_t     rxFrame[ REMOTE_RX_BYTES ];
+static uint8_t     rxLength = 0;
+static uint8_t     rxOverflow = 0;                                              // Current frame is too long
+
+
+//***** Prototypes ************************************************************
+static int Remote_tick( Timer * );
+
+
+//*****************************************************************************
+// Remote_init()
+//
+// Enables the UART receive interrupt. Uart_init() (called by
+// Telemetry_init()) has already set up the port.
+//*****************************************************************************
+void Remote_init( void )
+{
+    UCA1IE |= UCRXIE;
+}
+
+//*****************************************************************************
+// Remote_seed()
+//
+// Replaces the seed of a new game with the one sent by REMOTE_SEED, if
+// there was one since the last game. A replay uses this to play a recorded
+// game again: with the same seed and the same button timing, the game goes
+// exactly the same way.
+//
+// Arg 1: "seed" is the seed the game picked, replaced if asked to
+//*****************************************************************************
+void Remote_seed( unsigned long *seed )
+{
+    uint16_t state;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    if ( seedSet )
+    {
+        *seed   = seedNext;
+        seedSet = 0;
+    }
+    __set_interrupt_state( state );
+}
+
+//*****************************************************************************
+// Remote_state()
+//
+// Replies with the LEDs, the buttons held by the host and the free room in
+// the queue.
+//*****************************************************************************
+static void Remote_state( void )
+{
+    uint8_t leds = 0;
+
+    if ( P1OUT & RED_LED )
+    {
+        leds |= 0x01;
+    }
+    if ( P9OUT & GREEN_LED )
+    {
+        leds |= 0x02;
+    }
+    Telemetry_state( leds, remoteButtons >> 1, REMOTE_QUEUE - remoteQueued );
+}
+
+//*****************************************************************************
+// Remote_command()
+//
+// Runs one decoded command frame, or queues it if it is timed. Called from
+// the receive interrupt.
+//
+// Arg 1: "frame" is the decoded frame
+// Arg 2: "length" is the number of bytes in it
+//*****************************************************************************
+static void Remote_command( const uint8_t *frame, unsigned int length )
+{
+    RemoteEvent *event;
+
+    switch ( frame[0] )
+    {
+    case REMOTE_STATE:
+        Remote_state();
+        break;
+
+    case REMOTE_LCD:
+        Telemetry_lcd();
+        break;
+
+    case REMOTE_STATS:
+        Telemetry_counter( COUNTER_STACK_USED, Stack_highWater() );
+        Telemetry_counter( COUNTER_STACK_SIZE, Stack_size() );
+#ifdef ISR_STATS
+        Isr_dump();
+#endif
+        break;
+
+    case REMOTE_SEED:
+        if ( length >= 5 )
+        {
+            seedNext = frame[1] | ( (uint32_t)frame[2] << 8 ) |
+                       ( (uint32_t)frame[3] << 16 ) | ( (uint32_t)frame[4] << 24 );
+            seedSet  = 1;
+        }
+        break;
+
+    case REMOTE_BUTTONS:
+    case REMOTE_WAIT:
+        if ( ( remoteQueued == REMOTE_QUEUE ) ||                                // Queue full: the host should have
+             ( length < ( frame[0] == REMOTE_BUTTONS ? 4 : 3 ) ) )              //  checked the free room
+        {
+            break;
+        }
+        event = &queue[ ( queueHead + remoteQueued ) & QUEUE_MASK ];
+        event->command = frame[0];
+        if ( frame[0] == REMOTE_BUTTONS )
+        {
+            event->buttons = ( frame[1] & ( REMOTE_S1 | REMOTE_S2 ) ) << 1;     // P1.1 and P1.2
+            event->ticks   = frame[2] | ( frame[3] << 8 );
+        }
+        else
+        {
+            event->ticks   = frame[1] | ( frame[2] << 8 );
+        }
+        if ( remoteQueued++ == 0 )
+        {
+            Timer_start( &queueTimer, 1, 1, Remote_tick );                      // Start ticking
+        }
+        break;
+    }
+}
+
+//*****************************************************************************
+// Remote_receive()
+//
+// Adds a received byte to the frame being read. A 0x00 ends the frame, and
+// runs its command.
+//
+// Arg 1: "byte" is the byte received
+//*****************************************************************************
+static void Remote_receive( uint8_t byte )
+{
+    unsigned int length;
+
+    if ( byte != 0 )
+    {
+        if ( rxLength < REMOTE_RX_BYTES )
+        {
+            rxFrame[ rxLength++ ] = byte;
+        }
+        else
+        {
+            rxOverflow = 1;
+        }
+        return;
+    }
+
+    if ( !rxOverflow && rxLength )                                              // End of a frame
+    {
+        length = Uart_decode( rxFrame, rxLength );
+        if ( length )
+        {
+            Remote_command( rxFrame, length );
+        }
+    }
+    rxLength   = 0;
+    rxOverflow = 0;
+}
+
+
+// eUSCI_A1 Interrupt Service Routine
+#pragma vector=USCI_A1_VECTOR
+__interrupt void USCI_A1_ISR (void)
+{
+    ISR_ENTER( ISR_UART );
+    if ( UCA1IV == USCI_UART_UCRXIFG )
+    {
+        Remote_receive( UCA1RXBUF );
+    }
+    ISR_EXIT( ISR_UART );
+}
+
+
+//*****************************************************************************
+// Remote_tick()
+//
+// Runs the timed commands due this tick. The callback of queueTimer, which
+// expires every tick while there is something queued.
+//
+// Returns 1 to wake the game if the host pressed a button.
+//*****************************************************************************
+static int Remote_tick( Timer *timer )
+{
+    RemoteEvent *event = &queue[ queueHead ];
+    uint8_t pressed = 0;                                                        // Buttons newly held down
+
+    if ( event->ticks )
+    {
+        event->ticks--;
+    }
+    while ( remoteQueued && ( event->ticks == 0 ) )                             // Run everything due this tick
+    {
+        if ( event->command == REMOTE_BUTTONS )
+        {
+            pressed      |= event->buttons & ~remoteButtons;
+            remoteButtons = event->buttons;
+        }
+        else
+        {
+            Remote_state();
+        }
+        queueHead = ( queueHead + 1 ) & QUEUE_MASK;
+        remoteQueued--;
+        event = &queue[ queueHead ];
+    }
+
+    if ( !remoteQueued )
+    {
+        Timer_stop( timer );                                                    // Nothing left: stop ticking
+    }
+    return pressed != 0;                                                        // Wake the game from standby, like
+}                                                                               //  the Port 1 ISR does
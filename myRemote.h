@@ -0,0 +1,48 @@
+/*
+ * myRemote.h
+ *
+ */
+
+#ifndef MYREMOTE_H_
+#define MYREMOTE_H_
+
+#include <stdint.h>
+#include <msp430.h>
+
+//***** Defines ***************************************************************
+#define REMOTE_QUEUE                16                                          // Timed commands that can wait (power of 2)
+#define REMOTE_RX_BYTES             16                                          // Longest command frame, COBS-encoded
+
+// Commands from the host. Each is one COBS frame that starts with the
+// command byte; the replies are telemetry frames (myTelemetry.h). Timed
+// commands are queued and run from the Timer_1 tick (about 12ms): each one
+// runs 'ticks' ticks after the command before it, or after it arrived if
+// the queue was empty, and never sooner than the next tick.
+// Keep tools/runner.c in step with this list.
+#define REMOTE_STATE                0                                           // Reply TELEMETRY_STATE now
+#define REMOTE_LCD                  1                                           // Reply TELEMETRY_LCD now
+#define REMOTE_BUTTONS              2                                           // buttons (u8), ticks (u16): hold these buttons down
+#define REMOTE_WAIT                 3                                           // ticks (u16): then reply TELEMETRY_STATE
+#define REMOTE_SEED                 4                                           // seed (u32): use it for the next game
+#define REMOTE_STATS                5                                           // Reply COUNTER_STACK_xxx and, with
+                                                                                //  ISR_STATS, TELEMETRY_ISR frames now
+
+#define REMOTE_S1                   0x01                                        // Button bits for REMOTE_BUTTONS
+#define REMOTE_S2                   0x02
+
+//***** Prototypes ************************************************************
+void Remote_init( void );                                                       // Start taking commands (after Telemetry_init)
+void Remote_seed( unsigned long * );                                            // Replace a new game's seed, if asked to
+
+//***** Global Variables ******************************************************
+extern volatile uint8_t remoteButtons;                                          // P1 button bits held down by the host
+extern volatile uint8_t remoteQueued;                                           // Timed commands waiting to run
+
+//***** Macros ****************************************************************
+// The buttons as the game sees them: P1IN with the buttons the host holds
+// down pulled low, just like a real press. Read the buttons through this
+// instead of P1IN.
+#define BUTTONS_IN                  ( P1IN & ~remoteButtons )
+
+
+#endif /* MYREMOTE_H_ */
@@ -0,0 +1,225 @@
+// ----------------------------------------------------------------------------
+// myScores.c  ('FR6989 Launchpad)
+//
+// High scores and play statistics kept in FRAM.
+//
+// The game works on a RAM copy of the store. Scores_recordGame() only
+// updates that copy and remembers which records changed; Scores_commit()
+// then writes just the changed records to FRAM in a single write window,
+// once per game.
+//
+// Every record carries a CRC. At boot, Scores_load() checks each FRAM
+// record and copies only the good ones; a corrupt record (for example one
+// cut short by a power loss) starts again from zero instead of being
+// trusted, and is rewritten on the next commit. A record that is all zeros
+// has never been written (FRAM starts out that way on a new board), so it
+// starts from zero too but isn't counted as corrupt.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <string.h>
+#include <stddef.h>
+#include "myScores.h"
+#include "myFram.h"
+
+
+//***** Defines ***************************************************************
+#define RECORD_GOOD                 0                                           // Results of Scores_loadRecord()
+#define RECORD_EMPTY                1
+#define RECORD_CORRUPT              2
+
+#define DIRTY_TOP                   0x01                                        // Bits of 'dirty', one per record
+#define DIRTY_LEVEL( l )            ( 0x02 << ( l ) )
+#define DIRTY_LIFETIME              0x10
+
+// Arguments describing one record to Scores_loadRecord()
+#define RECORD( field, type )       &scores.field, &scoresFram.field, offsetof( type, crc ), sizeof( type )
+
+
+//***** Global Variables ******************************************************
+#pragma PERSISTENT(scoresFram)
+ScoreStore scoresFram = { 0 };                                                  // Kept in FRAM
+
+ScoreStore scores;                                                              // RAM copy used by the game
+static uint8_t dirty = 0;                                                       // Records changed since the last commit
+
+
+//*****************************************************************************
+// Scores_loadRecord()
+//
+// Copies one record from FRAM to RAM if its CRC is good. Otherwise the RAM
+// copy is cleared. Returns RECORD_GOOD, RECORD_EMPTY if the record is all
+// zeros (never written), or RECORD_CORRUPT.
+//*****************************************************************************
+static int Scores_loadRecord( void *ram, const void *fram, unsigned int crcOffset, unsigned int bytes )
+{
+    const uint8_t *b = (const uint8_t *)fram;
+    unsigned int   k;
+
+    if ( Fram_crc( fram, crcOffset ) == *(const uint16_t *)( b + crcOffset ) )
+    {
+        memcpy( ram, fram, bytes );
+        return RECORD_GOOD;
+    }
+    memset( ram, 0, bytes );
+    for ( k = 0; k < bytes; k++ )
+    {
+        if ( b[k] )
+        {
+            return RECORD_CORRUPT;
+        }
+    }
+    return RECORD_EMPTY;
+}
+
+//*****************************************************************************
+// Scores_load()
+//
+// Loads the store from FRAM at boot. Only the CRCs and one copy of the
+// store are needed, which is a few hundred cycles. Only corrupt records
+// count in corruptLoads; empty ones are simply written on the first commit
+// that changes them.
+//*****************************************************************************
+void Scores_load( void )
+{
+    unsigned int l;
+    unsigned int corrupt = 0;
+
+    if ( Scores_loadRecord( RECORD( top, HighScoreRecord ) ) == RECORD_CORRUPT )
+    {
+        dirty |= DIRTY_TOP;
+        corrupt++;
+    }
+    for ( l = 0; l < DIFFICULTY_LEVELS; l++ )
+    {
+        if ( Scores_loadRecord( RECORD( level[l], LevelStatsRecord ) ) == RECORD_CORRUPT )
+        {
+            dirty |= DIRTY_LEVEL( l );
+            corrupt++;
+        }
+    }
+    if ( Scores_loadRecord( RECORD( lifetime, LifetimeRecord ) ) == RECORD_CORRUPT )
+    {
+        corrupt++;
+    }
+
+    if ( corrupt )
+    {
+        scores.lifetime.corruptLoads += corrupt;
+        dirty |= DIRTY_LIFETIME;
+    }
+}
+
+//*****************************************************************************
+// Scores_recordGame()
+//
+// Adds the results of one game to the RAM copy of the store. Nothing is
+// written to FRAM until Scores_commit().
+//
+// Returns the place of the score in the high score table (0 is the best),
+// or -1 if it didn't make the table.
+//
+// Arg 1: "score" is the number of rounds the user got right
+// Arg 2: "level" is the difficulty level the game was played on
+// Arg 3: "endless" is 1 for an endless game, 0 otherwise
+// Arg 4: "won" is 1 if the user won a normal game, 0 otherwise
+//*****************************************************************************
+int Scores_recordGame( unsigned int score, unsigned int level, int endless, int won )
+{
+    LevelStatsRecord *stats = &scores.level[ level ];
+    int place;
+    int i;
+
+    stats->games++;
+    stats->total += score;
+    if ( score > stats->best )
+    {
+        stats->best = score;
+    }
+    dirty |= DIRTY_LEVEL( level );
+
+    scores.lifetime.games++;
+    scores.lifetime.wins         += won ? 1 : 0;
+    scores.lifetime.endlessGames += endless ? 1 : 0;
+    dirty |= DIRTY_LIFETIME;
+
+    if ( score == 0 )
+    {
+        return -1;                                                              // Empty table places aren't filled with zeros
+    }
+    for ( place = 0; place < SCORES_TOP; place++ )
+    {
+        if ( score > scores.top.entry[ place ].score )
+        {
+            break;
+        }
+    }
+    if ( place == SCORES_TOP )
+    {
+        return -1;
+    }
+
+    for ( i = SCORES_TOP - 1; i > place; i-- )                                  // Move lower scores down one place
+    {
+        scores.top.entry[ i ] = scores.top.entry[ i - 1 ];
+    }
+    scores.top.entry[ place ].score   = score;
+    scores.top.entry[ place ].level   = level;
+    scores.top.entry[ place ].endless = endless;
+    dirty |= DIRTY_TOP;
+
+    return place;
+}
+
+//*****************************************************************************
+// Scores_commit()
+//
+// Updates the CRCs of the changed records and writes them to FRAM, all in
+// one FRAM write window.
+//*****************************************************************************
+void Scores_commit( void )
+{
+    unsigned int l;
+    uint16_t window;
+
+    if ( !dirty )
+    {
+        return;
+    }
+
+    if ( dirty & DIRTY_TOP )                                                    // CRCs first, to keep the window short
+    {
+        scores.top.crc = Fram_crc( &scores.top, offsetof( HighScoreRecord, crc ) );
+    }
+    for ( l = 0; l < DIFFICULTY_LEVELS; l++ )
+    {
+        if ( dirty & DIRTY_LEVEL( l ) )
+        {
+            scores.level[l].crc = Fram_crc( &scores.level[l], offsetof( LevelStatsRecord, crc ) );
+        }
+    }
+    if ( dirty & DIRTY_LIFETIME )
+    {
+        scores.lifetime.crc = Fram_crc( &scores.lifetime, offsetof( LifetimeRecord, crc ) );
+    }
+
+    window = Fram_open();
+    if ( dirty & DIRTY_TOP )
+    {
+        Fram_write( &scoresFram.top, &scores.top, sizeof( HighScoreRecord ) );
+    }
+    for ( l = 0; l < DIFFICULTY_LEVELS; l++ )
+    {
+        if ( dirty & DIRTY_LEVEL( l ) )
+        {
+            Fram_write( &scoresFram.level[l], &scores.level[l], sizeof( LevelStatsRecord ) );
+        }
+    }
+    if ( dirty & DIRTY_LIFETIME )
+    {
+        Fram_write( &scoresFram.lifetime, &scores.lifetime, sizeof( LifetimeRecord ) );
+    }
+    Fram_close( window );
+
+    dirty = 0;
+}
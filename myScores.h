@@ -0,0 +1,63 @@
+/*
+ * myScores.h
+ *
+ */
+
+#ifndef MYSCORES_H_
+#define MYSCORES_H_
+
+#include <stdint.h>
+#include "myDifficulty.h"
+
+//***** Defines ***************************************************************
+#define SCORES_TOP                  5                                           // High scores kept
+
+//***** Type Definitions ******************************************************
+// Every record ends with a CRC of the words before it, and has an even size.
+typedef struct
+{
+    uint16_t score;
+    uint8_t  level;                                                             // DIFFICULTY_xxx the score was made on
+    uint8_t  endless;                                                           // 1 if it was an endless game
+} HighScore;
+
+typedef struct
+{
+    HighScore entry[ SCORES_TOP ];                                              // Best first
+    uint16_t  crc;
+} HighScoreRecord;
+
+typedef struct
+{
+    uint16_t games;                                                             // Games played on this level
+    uint16_t best;                                                              // Best score on this level
+    uint32_t total;                                                             // Sum of all scores on this level
+    uint16_t crc;
+} LevelStatsRecord;
+
+typedef struct
+{
+    uint32_t games;                                                             // Games ever played
+    uint32_t wins;                                                              // Normal games won
+    uint32_t endlessGames;                                                      // Endless games played
+    uint16_t corruptLoads;                                                      // Records found corrupt at boot
+    uint16_t crc;
+} LifetimeRecord;
+
+typedef struct
+{
+    HighScoreRecord  top;
+    LevelStatsRecord level[ DIFFICULTY_LEVELS ];
+    LifetimeRecord   lifetime;
+} ScoreStore;
+
+//***** Prototypes ************************************************************
+void Scores_load( void );                                                       // Boot: load valid FRAM records into RAM
+int  Scores_recordGame( unsigned int, unsigned int, int, int );                 // Collect one game's results in RAM
+void Scores_commit( void );                                                     // Write changed records to FRAM
+
+//***** Global Variables ******************************************************
+extern ScoreStore scores;                                                       // RAM copy; read it, don't write it
+
+
+#endif /* MYSCORES_H_ */
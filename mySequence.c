@@ -0,0 +1,234 @@
+// ----------------------------------------------------------------------------
+// mySequence.c  ('FR6989 Launchpad)
+//
+// Packed store for the LED sequence of a game.
+//
+// Each step is stored with the minimum number of bits for the alphabet size
+// (SEQUENCE_BITS = 1, 2 or 3 bits for 2, 4 or 8 LEDs). The store lives in
+// FRAM, so a full SEQUENCE_MAX_STEPS sequence costs no RAM. Steps past the
+// end of the store (endless games) are regenerated from the seed with
+// Random_at(), so a sequence of any length still works. Like every other
+// FRAM write, filling the store goes through Fram_open(): the steps are
+// packed a few bytes at a time in RAM, so the window stays short.
+//
+// ShowSequence() and GetUserSequence() both walk the sequence with the same
+// iterator, so playback and input checking can never disagree.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "mySequence.h"
+#include "myRandom.h"
+#include "myFram.h"
+#include "myBench.h"
+
+
+//***** Defines ***************************************************************
+#define FILL_CHUNK                  16                                          // Bytes packed in RAM per FRAM write
+
+#if defined( BENCH ) && ( BENCH_RUNS * 3 + 7 ) / 8 + 1 > SEQUENCE_BYTES
+#error "BENCH_Sequence_extract() reads past the store"
+#endif
+
+
+//***** Global Variables ******************************************************
+#pragma PERSISTENT(store)
+SequenceStore store = { 0, { 0 } };                                             // Kept in FRAM
+
+
+//*****************************************************************************
+// Sequence_step()
+//
+// Generates step k of the sequence for a seed. The top SEQUENCE_BITS bits of
+// the counter-based generator are used, so a step has the same value whether
+// it is read from the store or regenerated.
+//*****************************************************************************
+static uint8_t Sequence_step( uint32_t seed, unsigned int k )
+{
+    return (uint8_t)( Random_at( seed, k ) >> ( 32 - SEQUENCE_BITS ) );
+}
+
+//*****************************************************************************
+// Sequence_write()
+//
+// Copies packed bytes into the FRAM store, in a write window of their own.
+//
+// Arg 1: "at" is the offset in the store's data
+// Arg 2: "bytes" is the packed bytes
+// Arg 3: "count" is the number of bytes
+//*****************************************************************************
+static void Sequence_write( unsigned int at, const uint8_t *bytes, unsigned int count )
+{
+    uint16_t window;
+
+    window = Fram_open();
+    Fram_write( &store.data[ at ], bytes, count );
+    Fram_close( window );
+}
+
+//*****************************************************************************
+// Sequence_fill()
+//
+// Generates the first SEQUENCE_MAX_STEPS steps of a new sequence and packs
+// them into the FRAM store, FILL_CHUNK bytes at a time. The seed is cleared
+// first and stored last, so a fill cut short by a power loss never looks
+// complete to Sequence_resume().
+//
+// Arg 1: "seed" is the seed the sequence is generated from
+//*****************************************************************************
+void Sequence_fill( uint32_t seed )
+{
+    uint8_t      chunk[ FILL_CHUNK ];
+    unsigned int count = 0;                                                     // Bytes in 'chunk'
+    unsigned int at = 0;                                                        // Where 'chunk' goes in the store
+    uint16_t     bits = 0;                                                      // Packed steps not in 'chunk' yet
+    unsigned int held = 0;                                                      //  and how many bits of them
+    unsigned int k;
+    uint16_t     window;
+
+    window = Fram_open();
+    store.seed = 0;
+    Fram_close( window );
+
+    for ( k = 0; at + count < SEQUENCE_BYTES; )
+    {
+        if ( k < SEQUENCE_MAX_STEPS )
+        {
+            bits |= (uint16_t)Sequence_step( seed, k ) << held;
+            held += SEQUENCE_BITS;
+            k++;
+        }
+        else
+        {
+            held = 8;                                                           // The last bits and the pad byte
+        }
+        if ( held >= 8 )
+        {
+            chunk[ count++ ] = (uint8_t)bits;
+            bits >>= 8;
+            held  -= 8;
+        }
+        if ( ( count == FILL_CHUNK ) || ( at + count == SEQUENCE_BYTES ) )
+        {
+            Sequence_write( at, chunk, count );
+            at   += count;
+            count = 0;
+        }
+    }
+
+    window = Fram_open();
+    store.seed = seed;
+    Fram_close( window );
+}
+
+//*****************************************************************************
+// Sequence_resume()
+//
+// Makes sure the FRAM store holds the sequence for a seed, after a reset.
+// The store survives power loss, so it is only refilled if it holds a
+// different sequence.
+//
+// Arg 1: "seed" is the seed of the game being resumed
+//*****************************************************************************
+void Sequence_resume( uint32_t seed )
+{
+    if ( store.seed != seed )
+    {
+        Sequence_fill( seed );
+    }
+}
+
+//*****************************************************************************
+// Sequence_extract()
+//
+// Reads one packed step. Two bytes are always read, so a step that straddles
+// a byte boundary costs the same as one that doesn't.
+//
+// Arg 1: "data" is the packed step buffer
+// Arg 2: "bitPos" is the bit offset of the step in the buffer
+// Arg 3: "bits" is the number of bits per step
+//*****************************************************************************
+uint8_t Sequence_extract( const uint8_t *data, unsigned int bitPos, unsigned int bits )
+{
+    uint16_t window;
+
+    data  += bitPos >> 3;
+    window = data[0] | ( (uint16_t)data[1] << 8 );
+
+    return (uint8_t)( ( window >> ( bitPos & 7 ) ) & ( ( 1 << bits ) - 1 ) );
+}
+
+//*****************************************************************************
+// Sequence_get()
+//
+// Returns step k of the current sequence without iterating.
+//
+// Arg 1: "k" is the index of the step, starting at 0
+//*****************************************************************************
+uint8_t Sequence_get( unsigned int k )
+{
+    if ( k < SEQUENCE_MAX_STEPS )
+    {
+        return Sequence_extract( store.data, k * SEQUENCE_BITS, SEQUENCE_BITS );
+    }
+    return Sequence_step( store.seed, k );
+}
+
+//*****************************************************************************
+// Sequence_begin()
+//
+// Starts an iteration over the current sequence at step 0.
+//
+// Arg 1: "it" is the iterator to initialize
+//*****************************************************************************
+void Sequence_begin( SequenceIter *it )
+{
+    it->data   = store.data;
+    it->bitPos = 0;
+    it->step   = 0;
+}
+
+//*****************************************************************************
+// Sequence_next()
+//
+// Returns the next step of the iteration and moves past it.
+//
+// Arg 1: "it" is the iterator started by Sequence_begin()
+//*****************************************************************************
+uint8_t Sequence_next( SequenceIter *it )
+{
+    uint8_t symbol;
+
+    if ( it->step < SEQUENCE_MAX_STEPS )
+    {
+        symbol = Sequence_extract( it->data, it->bitPos, SEQUENCE_BITS );
+        it->bitPos += SEQUENCE_BITS;
+    }
+    else
+    {
+        symbol = Sequence_step( store.seed, it->step );                         // Past the store: regenerate
+    }
+    it->step++;
+
+    return symbol;
+}
+
+#ifdef BENCH
+//*****************************************************************************
+// BENCH_Sequence_extract()
+//
+// Reads one step of the current store with Sequence_extract(), as steps of
+// 1, 2 or 3 bits (2, 4 or 8 LEDs). myBench.c times it for each size, and
+// sends the results with the display primitives.
+//
+// Arg 1: "bits" is the number of bits per step
+// Arg 2: "k" is the step to read, below BENCH_RUNS
+//*****************************************************************************
+void BENCH_Sequence_extract( unsigned int bits, unsigned int k )
+{
+    volatile uint8_t symbol;                                                    // volatile so the read isn't optimized away
+
+    symbol = Sequence_extract( store.data, k * bits, bits );
+    (void)symbol;
+}
+#endif /* BENCH */
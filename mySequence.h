@@ -0,0 +1,56 @@
+/*
+ * mySequence.h
+ *
+ */
+
+#ifndef MYSEQUENCE_H_
+#define MYSEQUENCE_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+// Number of different LEDs/buttons in a sequence. Must be 2, 4 or 8. The
+// LaunchPad only has two LEDs and two buttons; 4 and 8 are for the external
+// LED version of the game.
+#ifndef SEQUENCE_SYMBOLS
+#define SEQUENCE_SYMBOLS            2
+#endif
+
+#if   SEQUENCE_SYMBOLS == 2
+#define SEQUENCE_BITS               1                                           // Bits needed to store one step
+#elif SEQUENCE_SYMBOLS == 4
+#define SEQUENCE_BITS               2
+#elif SEQUENCE_SYMBOLS == 8
+#define SEQUENCE_BITS               3
+#else
+#error "SEQUENCE_SYMBOLS must be 2, 4 or 8"
+#endif
+
+#define SEQUENCE_MAX_STEPS          1024                                        // Steps kept in the FRAM store
+#define SEQUENCE_BYTES              ( ( SEQUENCE_MAX_STEPS * SEQUENCE_BITS + 7 ) / 8 + 1 )  // Plus one pad byte
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint32_t seed;                                                              // Seed the steps were generated from
+    uint8_t  data[ SEQUENCE_BYTES ];                                            // Packed steps, SEQUENCE_BITS each
+} SequenceStore;
+
+typedef struct
+{
+    const uint8_t *data;                                                        // Packed steps being read
+    unsigned int   bitPos;                                                      // Bit offset of the next step
+    unsigned int   step;                                                        // Index of the next step
+} SequenceIter;
+
+//***** Prototypes ************************************************************
+void    Sequence_fill( uint32_t );                                              // Generate and pack a new sequence from a seed
+void    Sequence_resume( uint32_t );                                            // Refill the store only if it holds another seed
+uint8_t Sequence_get( unsigned int );                                           // Step k of the current sequence
+void    Sequence_begin( SequenceIter * );                                       // Start iterating at step 0
+uint8_t Sequence_next( SequenceIter * );                                        // Next step of the iteration
+uint8_t Sequence_extract( const uint8_t *, unsigned int, unsigned int );        // Raw packed step extraction
+void    BENCH_Sequence_extract( unsigned int, unsigned int );               // One step of the store (BENCH builds only)
+
+
+#endif /* MYSEQUENCE_H_ */
@@ -0,0 +1,80 @@
+// ----------------------------------------------------------------------------
+// myStack.c  ('FR6989 Launchpad)
+//
+// Stack high-water mark, by painting.
+//
+// At boot, before interrupts are on, Stack_paint() fills every word of the
+// stack below the current stack pointer with STACK_PAINT. A word that has
+// been pushed to since no longer holds it, so the lowest word that doesn't
+// is as deep as the stack has ever gone, main() and every ISR included.
+// Stack_highWater() looks for it from the bottom up, which takes up to a
+// few hundred cycles.
+//
+// A word that happens to be pushed with the value STACK_PAINT would read
+// as unused, so the mark can be a word or two short, never long. If it is
+// Stack_size(), the stack reached its bottom and has probably overflowed
+// into .bss.
+//
+// The stack is the .stack section, sized by the project's --stack_size
+// option. Its first word is _stack (defined in the run-time library's
+// boot.c) and the linker sets __STACK_END just past its last one. The
+// simulated board has a stack array of its own that nothing runs on.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myStack.h"
+
+
+//***** Defines ***************************************************************
+#ifndef STACK_BOTTOM
+extern int _stack;                                                              // First word of .stack
+extern int __STACK_END;                                                         // Just past its last word
+#define STACK_BOTTOM        ( (uint16_t *)&_stack )
+#define STACK_END           ( (uint16_t *)&__STACK_END )
+#endif
+
+
+//*****************************************************************************
+// Stack_paint()
+//
+// Fills the stack below the stack pointer with STACK_PAINT. Call it first
+// thing in main(), while interrupts are still off: nothing then lives below
+// the stack pointer.
+//*****************************************************************************
+void Stack_paint( void )
+{
+    uint16_t *sp = (uint16_t *)__get_SP_register();
+    uint16_t *word;
+
+    for ( word = STACK_BOTTOM; word < sp; word++ )
+    {
+        *word = STACK_PAINT;
+    }
+}
+
+//*****************************************************************************
+// Stack_highWater()
+//
+// Returns the most bytes of stack in use at any time since Stack_paint().
+//*****************************************************************************
+uint16_t Stack_highWater( void )
+{
+    const uint16_t *word = STACK_BOTTOM;
+
+    while ( word < STACK_END && *word == STACK_PAINT )
+    {
+        word++;
+    }
+    return (uint16_t)( ( STACK_END - word ) * sizeof( uint16_t ) );
+}
+
+//*****************************************************************************
+// Stack_size()
+//
+// Returns the bytes the linker reserved for the stack.
+//*****************************************************************************
+uint16_t Stack_size( void )
+{
+    return (uint16_t)( ( STACK_END - STACK_BOTTOM ) * sizeof( uint16_t ) );
+}
@@ -0,0 +1,20 @@
+/*
+ * myStack.h
+ *
+ */
+
+#ifndef MYSTACK_H_
+#define MYSTACK_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define STACK_PAINT                 0xA5A5                                      // Fill of stack words never used
+
+//***** Prototypes ************************************************************
+void     Stack_paint( void );                                                   // Fill the unused stack, first thing in main()
+uint16_t Stack_highWater( void );                                               // Most bytes of stack used since then
+uint16_t Stack_size( void );                                                    // Bytes reserved for the stack (.stack)
+
+
+#endif /* MYSTACK_H_ */
@@ -0,0 +1,373 @@
+// ----------------------------------------------------------------------------
+// myTelemetry.c  ('FR6989 Launchpad)
+//
+// Telemetry frames sent over the backchannel UART: game results, reaction
+// times, trace records and timing counters. tools/telemetry.c decodes them
+// on the PC.
+//
+// Every call builds a small frame on the stack and hands it to
+// Uart_sendFrame(), which only queues it. Nothing here waits for the UART,
+// so telemetry costs the game a few hundred cycles per frame and never keeps
+// the CPU awake. Frames can be sent from ISRs too (myRemote.c replies from
+// its interrupts).
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include <string.h>
+#include "myTelemetry.h"
+#include "myUart.h"
+#include "myTrace.h"
+#include "myClocks.h"
+#include "myProfile.h"
+
+
+//***** Global Variables ******************************************************
+static uint8_t  sequence = 0;                                                   // Sequence number of the next frame
+static uint16_t traceSent = 0;                                                  // Next trace record to send (a count)
+
+
+//*****************************************************************************
+// Telemetry_put16()
+//
+// Stores a 16-bit value little-endian. Returns the byte after it.
+//*****************************************************************************
+static uint8_t *Telemetry_put16( uint8_t *p, uint16_t value )
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)( value >> 8 );
+    return p + 2;
+}
+
+//*****************************************************************************
+// Telemetry_put32()
+//
+// Stores a 32-bit value little-endian. Returns the byte after it.
+//*****************************************************************************
+static uint8_t *Telemetry_put32( uint8_t *p, uint32_t value )
+{
+    p = Telemetry_put16( p, (uint16_t)value );
+    return Telemetry_put16( p, (uint16_t)( value >> 16 ) );
+}
+
+//*****************************************************************************
+// Telemetry_send()
+//
+// Fills in the frame header and queues the frame. The sequence number moves
+// on even if the frame is dropped, so the reader sees the gap. Interrupts
+// are held off so that frames sent from ISRs keep their numbers in order.
+//
+// Arg 1: "frame" is the frame, with room for the header at the start
+// Arg 2: "type" is one of the TELEMETRY_xxx frame types
+// Arg 3: "length" is the length of the whole frame, header included
+//*****************************************************************************
+static int Telemetry_send( uint8_t *frame, uint8_t type, unsigned int length )
+{
+    uint16_t state;
+    int      sent;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    frame[0] = type;
+    frame[1] = sequence++;
+    sent = Uart_sendFrame( frame, length );
+    __set_interrupt_state( state );
+
+    return sent;
+}
+
+//*****************************************************************************
+// Telemetry_init()
+//
+// Starts the UART and sends a hello frame, so the reader knows the board
+// has reset. Call it after the clocks are initialized.
+//
+// Arg 1: "resetReason" is the SYSRSTIV value read at boot
+//*****************************************************************************
+void Telemetry_init( uint16_t resetReason )
+{
+    uint8_t frame[ 9 ];
+    uint8_t *p;
+
+    Uart_init();
+    traceSent = traceWritten;
+
+    frame[2] = TELEMETRY_VERSION;
+    p = Telemetry_put16( &frame[3], mySMCLK_FREQUENCY_IN_HZ / 1000 );
+    p = Telemetry_put16( p, resetReason );
+    Telemetry_put16( p, myMCLK_FREQUENCY_IN_HZ / 1000 );
+    Telemetry_send( frame, TELEMETRY_HELLO, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_game()
+//
+// Sends the result of a game.
+//
+// Arg 1: "score" is the final score
+// Arg 2: "level" is the DIFFICULTY_xxx level the game was played on
+// Arg 3: "endless" is 1 for an endless game
+// Arg 4: "place" is the place in the high score table, or -1
+//*****************************************************************************
+void Telemetry_game( unsigned int score, unsigned int level, int endless, int place )
+{
+    uint8_t frame[ 7 ];
+    uint8_t *p;
+
+    p = Telemetry_put16( &frame[2], score );
+    p[0] = level;
+    p[1] = endless;
+    p[2] = (uint8_t)place;
+    Telemetry_send( frame, TELEMETRY_GAME, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_press()
+//
+// Sends the reaction time of one button press. A timeout is sent as a wrong
+// press that took the whole timeout.
+//
+// Arg 1: "round" is the round of the game, starting at 0
+// Arg 2: "reactTicks" is the time from the end of the last press, in 10ms ticks
+// Arg 3: "correct" is 1 if the right button was pressed
+//*****************************************************************************
+void Telemetry_press( unsigned int round, unsigned int reactTicks, int correct )
+{
+    uint8_t frame[ 7 ];
+    uint8_t *p;
+
+    p = Telemetry_put16( &frame[2], round );
+    p = Telemetry_put16( p, reactTicks );
+    p[0] = correct;
+    Telemetry_send( frame, TELEMETRY_PRESS, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_trace()
+//
+// Sends the trace records logged since the last call, up to
+// TELEMETRY_TRACE_RECORDS per frame. If the trace ring wrapped past some of
+// them, a TRACE_LOST record goes first instead (Trace_catchUp()). If the
+// UART ring fills up, the rest are sent by the next call.
+//*****************************************************************************
+void Telemetry_trace( void )
+{
+    uint8_t      frame[ 2 + TELEMETRY_TRACE_RECORDS * sizeof( TraceRecord ) ];
+    uint16_t     from = traceSent;                                              // Start of the frame, to send it again
+    TraceRecord  lost;
+    int          gap = Trace_catchUp( &traceSent, &lost );
+    unsigned int count;
+
+    while ( gap || ( traceSent != traceWritten ) )
+    {
+        count = 0;
+        if ( gap )
+        {
+            memcpy( &frame[2], &lost, sizeof( TraceRecord ) );
+            count++;
+        }
+        while ( ( traceSent != traceWritten ) && ( count < TELEMETRY_TRACE_RECORDS ) )  // Records are already little-endian
+        {
+            memcpy( &frame[ 2 + count * sizeof( TraceRecord ) ],
+                    &traceLog.record[ traceSent & ( TRACE_RECORDS - 1 ) ], sizeof( TraceRecord ) );
+            traceSent = traceSent + 1;
+            count++;
+        }
+        if ( !Telemetry_send( frame, TELEMETRY_TRACE, 2 + count * sizeof( TraceRecord ) ) )
+        {
+            traceSent = from;                                                   // Ring full: try again next time (a
+            break;                                                              //  lost record is worked out again)
+        }
+        gap  = 0;
+        from = traceSent;
+    }
+}
+
+//*****************************************************************************
+// Telemetry_counter()
+//
+// Sends the value of a counter.
+//
+// Arg 1: "id" is one of the COUNTER_xxx IDs
+// Arg 2: "value" is the counter's value
+//*****************************************************************************
+void Telemetry_counter( uint8_t id, uint32_t value )
+{
+    uint8_t frame[ 7 ];
+    uint8_t *p;
+
+    frame[2] = id;
+    p = Telemetry_put16( &frame[3], (uint16_t)value );
+    Telemetry_put16( p, (uint16_t)( value >> 16 ) );
+    Telemetry_send( frame, TELEMETRY_COUNTER, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_seed()
+//
+// Sends the seed of a new game, so that the game can be replayed.
+//
+// Arg 1: "seed" is the seed the LED sequence is made from
+// Arg 2: "endless" is 1 for an endless game
+//*****************************************************************************
+void Telemetry_seed( uint32_t seed, int endless )
+{
+    uint8_t frame[ 7 ];
+    uint8_t *p;
+
+    p = Telemetry_put16( &frame[2], (uint16_t)seed );
+    p = Telemetry_put16( p, (uint16_t)( seed >> 16 ) );
+    p[0] = endless;
+    Telemetry_send( frame, TELEMETRY_SEED, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_bench()
+//
+// Sends the result of one benchmark of myBench.c.
+//
+// Arg 1: "id" is one of the BENCH_xxx IDs
+// Arg 2: "runs" is the number of times it was timed
+// Arg 3: "min" is the shortest time, in MCLK cycles
+// Arg 4: "median" is the median time
+// Arg 5: "max" is the longest time
+//*****************************************************************************
+void Telemetry_bench( uint8_t id, uint16_t runs, uint32_t min, uint32_t median, uint32_t max )
+{
+    uint8_t frame[ 17 ];
+    uint8_t *p;
+
+    frame[2] = id;
+    p = Telemetry_put16( &frame[3], runs );
+    p = Telemetry_put32( p, min );
+    p = Telemetry_put32( p, median );
+    Telemetry_put32( p, max );
+    Telemetry_send( frame, TELEMETRY_BENCH, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_isr()
+//
+// Sends the stats of one ISR (myIsr.c). Times are in Timer_0 counts.
+//
+// Arg 1: "id" is one of the ISR_xxx IDs
+// Arg 2: "nesting" is the most ISRs that were running at once
+// Arg 3: "runs" is the number of times it ran
+// Arg 4: "total" is the time spent in it, all runs
+// Arg 5: "longest" is its longest run
+// Arg 6: "latency" is its latest start after its event, 0 if not known
+//*****************************************************************************
+void Telemetry_isr( uint8_t id, uint8_t nesting, uint32_t runs, uint32_t total, uint16_t longest, uint16_t latency )
+{
+    uint8_t frame[ 16 ];
+    uint8_t *p;
+
+    frame[2] = id;
+    frame[3] = nesting;
+    p = Telemetry_put32( &frame[4], runs );
+    p = Telemetry_put32( p, total );
+    p = Telemetry_put16( p, longest );
+    Telemetry_put16( p, latency );
+    Telemetry_send( frame, TELEMETRY_ISR, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_race()
+//
+// Sends the result of a race against another board (myLink.c). Times are
+// in ACLK counts.
+//
+// Arg 1: "result" is one of the LINK_xxx results
+// Arg 2: "presses" is how many presses were right, all rounds
+// Arg 3: "theirs" is the same for the other board
+// Arg 4: "margin" is how much sooner our last right press was than theirs
+// Arg 5: "offset" is the other board's clock less ours
+// Arg 6: "roundTrip" is the round trip of the ping the offset is from
+//*****************************************************************************
+void Telemetry_race( uint8_t result, uint32_t presses, uint32_t theirs, int32_t margin, int32_t offset, uint16_t roundTrip )
+{
+    uint8_t frame[ 21 ];
+    uint8_t *p;
+
+    frame[2] = result;
+    p = Telemetry_put32( &frame[3], presses );
+    p = Telemetry_put32( p, theirs );
+    p = Telemetry_put32( p, (uint32_t)margin );
+    p = Telemetry_put32( p, (uint32_t)offset );
+    Telemetry_put16( p, roundTrip );
+    Telemetry_send( frame, TELEMETRY_RACE, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_profile()
+//
+// Sends the next buckets of the profiler's histogram that have samples, as
+// many as fit in one frame. Empty buckets are skipped, and nothing is sent
+// if there are no more.
+//
+// Arg 1: "counts" is the histogram, PROFILE_BUCKETS long
+// Arg 2: "first" is the first bucket to look at
+//
+// Returns the bucket to carry on from.
+//*****************************************************************************
+unsigned int Telemetry_profile( const uint16_t *counts, unsigned int first )
+{
+    uint8_t frame[ 5 + 3 * TELEMETRY_PROFILE_BUCKETS ];
+    uint8_t *p = &frame[5];
+    unsigned int sent = 0;
+
+    frame[2] = PROFILE_SHIFT;
+    Telemetry_put16( &frame[3], PROFILE_BASE );
+    for ( ; first < PROFILE_BUCKETS && sent < TELEMETRY_PROFILE_BUCKETS; first++ )
+    {
+        if ( counts[ first ] )
+        {
+            *p++ = (uint8_t)first;
+            p    = Telemetry_put16( p, counts[ first ] );
+            sent++;
+        }
+    }
+    if ( sent )
+    {
+        Telemetry_send( frame, TELEMETRY_PROFILE, p - frame );
+    }
+    return first;
+}
+
+//*****************************************************************************
+// Telemetry_state()
+//
+// Sends the state the remote control reports: LEDs, held buttons and free
+// queue entries, with the Timer_0 time it was taken at.
+//
+// Arg 1: "leds" has bit 0 set for the red LED, bit 1 for the green LED
+// Arg 2: "buttons" are the REMOTE_S1/REMOTE_S2 bits the host holds down
+// Arg 3: "queueFree" is the number of timed commands that can still be queued
+//*****************************************************************************
+void Telemetry_state( uint8_t leds, uint8_t buttons, uint8_t queueFree )
+{
+    uint8_t  frame[ 9 ];
+    uint8_t  *p;
+    uint16_t time, epoch;
+
+    frame[2] = leds;
+    frame[3] = buttons;
+    frame[4] = queueFree;
+    Trace_now( &time, &epoch );                                                 // Sent from the UART ISR
+    p = Telemetry_put16( &frame[5], time );
+    Telemetry_put16( p, epoch );
+    Telemetry_send( frame, TELEMETRY_STATE, sizeof( frame ) );
+}
+
+//*****************************************************************************
+// Telemetry_lcd()
+//
+// Sends a copy of the LCD memory, so a host can see what the LCD shows.
+//*****************************************************************************
+void Telemetry_lcd( void )
+{
+    uint8_t frame[ 2 + TELEMETRY_LCD_BYTES ];
+
+    memcpy( &frame[2], (const void *)LCDMEM, TELEMETRY_LCD_BYTES );
+    Telemetry_send( frame, TELEMETRY_LCD, sizeof( frame ) );
+}
@@ -0,0 +1,60 @@
+/*
+ * myTelemetry.h
+ *
+ */
+
+#ifndef MYTELEMETRY_H_
+#define MYTELEMETRY_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define TELEMETRY_VERSION           2                                           // Bump when a frame layout changes
+
+// Every frame starts with its type and a sequence number, so the reader can
+// tell when frames were dropped. All fields are little-endian.
+// Keep tools/telemetry.c in step with this list.
+#define TELEMETRY_HELLO             0                                           // version, SMCLK in kHz (u16), reset reason (u16),
+                                                                                //  MCLK in kHz (u16)
+#define TELEMETRY_GAME              1                                           // score (u16), level, endless, place (s8)
+#define TELEMETRY_PRESS             2                                           // round (u16), reaction ticks (u16), correct
+#define TELEMETRY_TRACE             3                                           // 1 to TELEMETRY_TRACE_RECORDS TraceRecords
+#define TELEMETRY_COUNTER           4                                           // counter ID, value (u32)
+#define TELEMETRY_STATE             5                                           // LEDs, held buttons, free queue, Timer_0 (u16), epoch (u16)
+#define TELEMETRY_LCD               6                                           // LCD memory LCDM1 to LCDM22
+#define TELEMETRY_SEED              7                                           // seed (u32), endless: a game has started
+#define TELEMETRY_BENCH             8                                           // BENCH_xxx ID, runs (u16), min, median, max (u32 cycles)
+#define TELEMETRY_PROFILE           9                                           // shift, base (u16), then bucket, count (u16) pairs
+#define TELEMETRY_ISR               10                                          // ISR_xxx ID, nesting, runs, total (u32), longest,
+                                                                                //  latency (u16 Timer_0 counts)
+#define TELEMETRY_RACE              11                                          // LINK_xxx result, presses, theirs (u32), margin,
+                                                                                //  clock offset (s32), round trip (u16 ACLK counts)
+
+#define TELEMETRY_TRACE_RECORDS     4                                           // Trace records per frame
+#define TELEMETRY_LCD_BYTES         22                                          // LCDM1-22 cover all segment pins (L0-L43)
+#define TELEMETRY_PROFILE_BUCKETS   19                                          // Bucket, count pairs per frame
+
+// Counter IDs
+#define COUNTER_CHECKPOINT_CYCLES   0                                           // checkpointCycles
+#define COUNTER_UART_DROPPED        1                                           // uartDropped
+#define COUNTER_PROFILE_SAMPLES     2                                           // profileSamples, sent after the histogram
+#define COUNTER_PROFILE_OUTSIDE     3                                           // profileOutside
+#define COUNTER_STACK_USED          4                                           // Stack_highWater(), in bytes
+#define COUNTER_STACK_SIZE          5                                           // Stack_size()
+
+//***** Prototypes ************************************************************
+void Telemetry_init( uint16_t );                                                // Start the UART and say hello
+void Telemetry_game( unsigned int, unsigned int, int, int );                    // Result of a game
+void Telemetry_press( unsigned int, unsigned int, int );                        // One button press (or timeout)
+void Telemetry_trace( void );                                                   // Send trace records logged since the last call
+void Telemetry_counter( uint8_t, uint32_t );                                    // Value of a counter
+void Telemetry_state( uint8_t, uint8_t, uint8_t );                              // Reply to a remote command
+void Telemetry_lcd( void );                                                     // Contents of the LCD memory
+void Telemetry_seed( uint32_t, int );                                           // Seed of a new game
+void Telemetry_bench( uint8_t, uint16_t, uint32_t, uint32_t, uint32_t );        // Result of a benchmark
+unsigned int Telemetry_profile( const uint16_t *, unsigned int );               // Part of the profiler's histogram
+void Telemetry_isr( uint8_t, uint8_t, uint32_t, uint32_t, uint16_t, uint16_t ); // Stats of one ISR
+void Telemetry_race( uint8_t, uint32_t, uint32_t, int32_t, int32_t, uint16_t );  // Result of a race (myLink.c)
+
+
+#endif /* MYTELEMETRY_H_ */
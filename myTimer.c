@@ -0,0 +1,310 @@
+// ----------------------------------------------------------------------------
+// myTimer.c  ('FR6989 Launchpad)
+//
+// Software timers, all run from Timer_1's CCR0.
+//
+// Timer_1 counts ACLK in continuous mode. Time is kept in ticks of
+// TIMER_TICK_COUNTS ACLK counts, the same tick the game's delays, tempos and
+// test commands have always been counted in. There is no periodic
+// interrupt: CCR0 is set for the tick of the earliest deadline, so the CPU
+// can sleep until then. Only when nothing is due for TIMER_MAX_SLEEP ticks
+// (about 2 seconds) does it wake up to move the compare on, since Timer_1
+// wraps every 65536 counts.
+//
+// The timers are kept in a hashed wheel: a timer due at tick t is in the
+// list of slot t % TIMER_SLOTS. Starting and stopping a timer is O(1). At a
+// tick the ISR only looks at that tick's slot, where timers due a few turns
+// of the wheel later are skipped. Finding the next deadline looks at the
+// slots in order and stops at the first one that has a timer due in it.
+//
+// Callbacks run in the ISR, with interrupts off. They can start and stop
+// timers, their own included. A Timer must start out zeroed (a static or
+// global), so it is known to be stopped.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include <stddef.h>
+#include "myTimer.h"
+#include "myIsr.h"
+
+
+//***** Defines ***************************************************************
+#define SLOT_MASK           ( TIMER_SLOTS - 1 )
+
+
+//***** Global Variables ******************************************************
+static Timer   *wheel[ TIMER_SLOTS ];                                           // Timers by deadline % TIMER_SLOTS
+static uint32_t now      = 0;                                                   // Last tick the ISR handled
+static uint16_t nowCount = 0;                                                   // Timer_1 count at that tick
+static uint32_t next     = 0;                                                   // Tick CCR0 is set for
+static uint32_t aligned  = 0;                                                   // Counts Timer_align() has moved the ticks by
+
+
+//*****************************************************************************
+// Timer_link(), Timer_unlink()
+//
+// Add a timer to the slot of its deadline, and take it out again.
+//*****************************************************************************
+static void Timer_link( Timer *timer )
+{
+    Timer **head = &wheel[ timer->deadline & SLOT_MASK ];
+
+    timer->next = *head;
+    if ( timer->next )
+    {
+        timer->next->pprev = &timer->next;
+    }
+    *head        = timer;
+    timer->pprev = head;
+}
+
+static void Timer_unlink( Timer *timer )
+{
+    *timer->pprev = timer->next;
+    if ( timer->next )
+    {
+        timer->next->pprev = timer->pprev;
+    }
+    timer->pprev = NULL;
+}
+
+//*****************************************************************************
+// Timer_read()
+//
+// Returns the Timer_1 count. ACLK isn't in step with MCLK, so a read just
+// as the count changes can return a mix of the old and new bits. Reads
+// until two in a row agree, the majority vote the family user's guide
+// asks for when the timer runs from an asynchronous clock.
+//*****************************************************************************
+static uint16_t Timer_read( void )
+{
+    uint16_t count;
+    uint16_t again = TA1R;
+
+    do
+    {
+        count = again;
+        again = TA1R;
+    } while ( again != count );
+
+    return count;
+}
+
+//*****************************************************************************
+// Timer_current()
+//
+// Returns the tick it is now, from the Timer_1 count. Call it with
+// interrupts off. CCR0 always fires within 65536 counts of 'now', so the
+// count can't have wrapped past it.
+//*****************************************************************************
+static uint32_t Timer_current( void )
+{
+    return now + (uint16_t)( Timer_read() - nowCount ) / TIMER_TICK_COUNTS;
+}
+
+//*****************************************************************************
+// Timer_schedule()
+//
+// Sets CCR0 for the earliest deadline, or TIMER_MAX_SLEEP ticks after
+// 'now' if that is sooner. Call it with interrupts off.
+//*****************************************************************************
+static void Timer_schedule( void )
+{
+    uint16_t soonest = TIMER_MAX_SLEEP;                                         // In ticks after 'now'
+    uint16_t counts;
+    unsigned int k;
+    Timer *timer;
+
+    for ( k = 1; k <= TIMER_SLOTS && k < soonest; k++ )                         // A slot holds the timers due at its
+    {                                                                           //  tick, and later turns of the wheel
+        for ( timer = wheel[ ( now + k ) & SLOT_MASK ]; timer; timer = timer->next )
+        {
+            if ( timer->deadline - now < soonest )
+            {
+                soonest = (uint16_t)( timer->deadline - now );
+            }
+        }
+    }
+
+    next     = now + soonest;
+    counts   = soonest * TIMER_TICK_COUNTS;
+    TA1CCR0  = nowCount + counts;
+    TA1CCTL0 = CCIE;                                                            // Clears any old CCIFG
+    if ( (uint16_t)( Timer_read() - nowCount ) >= counts )                      // Already past it: don't wait for the
+    {                                                                           //  count to come round again
+        TA1CCTL0 = CCIE | CCIFG;
+    }
+}
+
+//*****************************************************************************
+// Timer_init()
+//
+// Starts Timer_1 from 0 on ACLK, in continuous mode. Tick 0 is now.
+//*****************************************************************************
+void Timer_init( void )
+{
+    TA1CTL   = TASSEL_1 | MC_2 | TACLR;                                         // ACLK, continuous
+    now      = 0;
+    nowCount = 0;
+    aligned  = 0;
+    Timer_schedule();
+}
+
+//*****************************************************************************
+// Timer_start()
+//
+// Starts a timer, or restarts it if it is already running. It expires at
+// the 'ticks'th tick from now; the first one may come at any time, so the
+// wait is between ticks - 1 and ticks ticks long.
+//
+// Arg 1: "timer" is the timer
+// Arg 2: "ticks" is when it first expires, at least 1
+// Arg 3: "period" is the ticks between later expiries, or 0 for only one
+// Arg 4: "callback" is called each time it expires
+//*****************************************************************************
+void Timer_start( Timer *timer, uint16_t ticks, uint16_t period, TimerCallback callback )
+{
+    uint16_t state;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+
+    if ( timer->pprev )
+    {
+        Timer_unlink( timer );
+    }
+    timer->deadline = Timer_current() + ( ticks ? ticks : 1 );
+    timer->period   = period;
+    timer->callback = callback;
+    Timer_link( timer );
+    if ( timer->deadline - now < next - now )                                   // Sooner than CCR0 is set for
+    {
+        Timer_schedule();
+    }
+
+    __set_interrupt_state( state );
+}
+
+//*****************************************************************************
+// Timer_stop()
+//
+// Stops a timer. Nothing happens if it isn't running. CCR0 is left alone:
+// if it was set for this timer, the ISR finds nothing due and moves on.
+//*****************************************************************************
+void Timer_stop( Timer *timer )
+{
+    uint16_t state;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    if ( timer->pprev )
+    {
+        Timer_unlink( timer );
+    }
+    __set_interrupt_state( state );
+}
+
+//*****************************************************************************
+// Timer_running()
+//
+// Returns 1 if the timer is waiting to expire.
+//*****************************************************************************
+int Timer_running( const Timer *timer )
+{
+    return timer->pprev != NULL;
+}
+
+//*****************************************************************************
+// Timer_ticks()
+//
+// Returns the ticks since Timer_init(). They stop while ACLK does (LPM4).
+//*****************************************************************************
+uint32_t Timer_ticks( void )
+{
+    uint16_t state;
+    uint32_t ticks;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    ticks = Timer_current();
+    __set_interrupt_state( state );
+
+    return ticks;
+}
+
+//*****************************************************************************
+// Timer_counts()
+//
+// Returns the ACLK counts since Timer_init(), for timing finer than a tick.
+// They wrap after 36 hours, and stop while ACLK does (LPM4).
+//*****************************************************************************
+uint32_t Timer_counts( void )
+{
+    uint16_t state;
+    uint32_t counts;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    counts = aligned + now * TIMER_TICK_COUNTS + (uint16_t)( Timer_read() - nowCount );
+    __set_interrupt_state( state );
+
+    return counts;
+}
+
+//*****************************************************************************
+// Timer_align()
+//
+// Moves the ticks so that the current one starts now: every later tick
+// comes up to one tick later than it would have. Two boards that align
+// at the same moment then tick together. Deadlines are kept in ticks, so
+// no timer expires early or is missed, and Timer_counts() carries on
+// counting as before.
+//*****************************************************************************
+void Timer_align( void )
+{
+    uint16_t state;
+    uint16_t phase;                                                             // Counts into the current tick
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+    phase     = (uint16_t)( Timer_read() - nowCount ) % TIMER_TICK_COUNTS;
+    nowCount += phase;
+    aligned  += phase;
+    Timer_schedule();
+    __set_interrupt_state( state );
+}
+
+
+// Timer_1 Interrupt Service Routine
+#pragma vector=TIMER1_A0_VECTOR
+__interrupt void Timer_A1 (void)
+{
+    Timer *timer;
+    int wake = 0;
+
+    ISR_ENTER( ISR_TIMER1 );
+    now      = next;
+    nowCount = TA1CCR0;
+    do                                                                          // Look again after each callback,
+    {                                                                           //  which can change the list
+        for ( timer = wheel[ now & SLOT_MASK ]; timer && timer->deadline != now; timer = timer->next );
+        if ( timer )
+        {
+            Timer_unlink( timer );
+            if ( timer->period )
+            {
+                timer->deadline += timer->period;
+                Timer_link( timer );
+            }
+            wake |= timer->callback( timer );
+        }
+    } while ( timer );
+    Timer_schedule();
+
+    if ( wake )
+    {
+        __bic_SR_register_on_exit( LPM4_bits );                                 // Wake the CPU from any sleep
+    }
+    ISR_EXIT( ISR_TIMER1 );
+}
@@ -0,0 +1,45 @@
+/*
+ * myTimer.h
+ *
+ */
+
+#ifndef MYTIMER_H_
+#define MYTIMER_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define TIMER_TICK_COUNTS           401                                         // ACLK counts per tick (about 12.2ms)
+#define TIMER_SLOTS                 16                                          // Slots in the wheel (power of 2)
+#define TIMER_MAX_SLEEP             160                                         // Most ticks between compares (< 65536 counts)
+
+// Ticks in 'ms' milliseconds, rounded down
+#define TIMER_TICKS( ms )           ( (uint32_t)( ms ) * 32768 / ( 1000UL * TIMER_TICK_COUNTS ) )
+
+//***** Type Definitions ******************************************************
+struct Timer;
+
+// Called from the Timer_1 ISR when a timer expires. Return nonzero to wake
+// the CPU from a low power mode.
+typedef int ( *TimerCallback )( struct Timer * );
+
+typedef struct Timer
+{
+    struct Timer *next;                                                         // Next in the list of its slot
+    struct Timer **pprev;                                                       // What points to it, NULL if stopped
+    uint32_t      deadline;                                                     // Tick it expires at
+    uint16_t      period;                                                       // Ticks between expiries, 0 for one-shot
+    TimerCallback callback;
+} Timer;
+
+//***** Prototypes ************************************************************
+void     Timer_init( void );                                                    // Timer_1 counts ACLK, no timers running
+void     Timer_start( Timer *, uint16_t, uint16_t, TimerCallback );             // (Re)start a timer
+void     Timer_stop( Timer * );                                                 // Stop it, if it is running
+int      Timer_running( const Timer * );                                        // Is it waiting to expire?
+uint32_t Timer_ticks( void );                                                   // Ticks since Timer_init()
+uint32_t Timer_counts( void );                                                  // ACLK counts since Timer_init()
+void     Timer_align( void );                                                   // Start a tick now
+
+
+#endif /* MYTIMER_H_ */
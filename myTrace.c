@@ -0,0 +1,162 @@
+// ----------------------------------------------------------------------------
+// myTrace.c  ('FR6989 Launchpad)
+//
+// Event trace for finding out what happened on a unit in the field.
+//
+// TRACE() writes fixed-size binary records (time, event ID, 16-bit payload)
+// into a ring in RAM. The time is the Timer_0 count plus the number of times
+// Timer_0 has wrapped, which the Timer_0 ISR counts in traceEpoch. Timer_0
+// stops while the board is in standby, so sleeping time doesn't show.
+//
+// With TRACE_FRAM defined, Trace_spill() appends the records logged since
+// the last spill to a longer ring in FRAM, which survives resets.
+//
+// Readers of the RAM ring (Trace_spill(), Telemetry_trace()) keep their
+// place as a count of records, like traceWritten. When a reader falls more
+// than TRACE_RECORDS behind, the oldest records it hasn't read are gone:
+// Trace_catchUp() moves it on to the oldest one left and gives it a
+// TRACE_LOST record saying how many it missed.
+//
+// The log structures start with a small header, so a memory dump of
+// traceLog (or traceFram) can be decoded by tools/tracedump.c.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myTrace.h"
+#include "myFram.h"
+#include "myClocks.h"
+
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint16_t    magic;                                                          // Same header as TraceLog
+    uint16_t    records;
+    uint16_t    head;
+    uint16_t    smclkKhz;
+    TraceRecord record[ TRACE_FRAM_RECORDS ];
+} TraceFramLog;
+
+
+//***** Global Variables ******************************************************
+TraceLog          traceLog;
+volatile uint16_t traceEpoch = 0;
+uint16_t          traceWritten = 0;
+
+#ifdef TRACE_FRAM
+#pragma PERSISTENT(traceFram)
+TraceFramLog traceFram = { 0 };                                                 // Kept in FRAM
+
+static uint16_t spilled = 0;                                                    // Next RAM record to spill (a count)
+#endif
+
+
+//*****************************************************************************
+// Trace_init()
+//
+// Fills in the header of the RAM log (and the FRAM log, if it is new). The
+// records themselves start out empty (TRACE_NONE).
+//*****************************************************************************
+void Trace_init( void )
+{
+    traceLog.magic    = TRACE_MAGIC;
+    traceLog.records  = TRACE_RECORDS;
+    traceLog.head     = 0;
+    traceLog.smclkKhz = mySMCLK_FREQUENCY_IN_HZ / 1000;
+    traceWritten      = 0;
+
+#ifdef TRACE_FRAM
+    if ( traceFram.magic != TRACE_MAGIC )
+    {
+        uint16_t window = Fram_open();
+        traceFram.magic    = TRACE_MAGIC;
+        traceFram.records  = TRACE_FRAM_RECORDS;
+        traceFram.head     = 0;
+        traceFram.smclkKhz = mySMCLK_FREQUENCY_IN_HZ / 1000;
+        Fram_close( window );
+    }
+    spilled = 0;
+#endif
+}
+
+//*****************************************************************************
+// Trace_catchUp()
+//
+// Checks whether the RAM ring has wrapped past a reader. If it has, moves
+// the reader on to the oldest record left and fills in a TRACE_LOST record
+// for the ones it missed, stamped with the time of that oldest record.
+// Readers more than 65535 records behind can't be told apart from ones
+// that aren't, so read at least once per game. Call it from main context.
+//
+// Returns 1 if records were lost.
+//
+// Arg 1: "next" is the reader's next record, counted like traceWritten
+// Arg 2: "lost" is where the TRACE_LOST record goes
+//*****************************************************************************
+int Trace_catchUp( uint16_t *next, TraceRecord *lost )
+{
+    uint16_t behind = traceWritten - *next;
+
+    if ( behind <= TRACE_RECORDS )
+    {
+        return 0;
+    }
+    *next = traceWritten - TRACE_RECORDS;
+    *lost = traceLog.record[ *next & ( TRACE_RECORDS - 1 ) ];
+    lost->id      = TRACE_LOST;
+    lost->payload = behind - TRACE_RECORDS;
+    return 1;
+}
+
+//*****************************************************************************
+// Trace_now()
+//
+// Reads the Timer_0 count and epoch as TRACE() stamps them, from main
+// context or an ISR. With interrupts off the Timer_0 ISR can't count a
+// wrap, so a pending CCIFG with a small count means it has just wrapped.
+//
+// Arg 1: "time" is where the Timer_0 count goes
+// Arg 2: "epoch" is where the number of wraps goes
+//*****************************************************************************
+void Trace_now( uint16_t *time, uint16_t *epoch )
+{
+    do
+    {
+        *epoch = traceEpoch;
+        *time  = TA0R;
+    } while ( *epoch != traceEpoch );
+    if ( ( TA0CCTL0 & CCIFG ) && ( *time < 0x8000 ) )                           // Wrapped, not counted yet
+    {
+        *epoch = *epoch + 1;
+    }
+}
+
+//*****************************************************************************
+// Trace_spill()
+//
+// Appends the RAM records logged since the last spill to the FRAM ring,
+// after a TRACE_LOST record if the RAM ring wrapped past some of them.
+// Call it about once per round. Does nothing unless TRACE_FRAM is defined.
+//*****************************************************************************
+void Trace_spill( void )
+{
+#ifdef TRACE_FRAM
+    uint16_t    window;
+    TraceRecord lost;
+
+    window = Fram_open();
+    if ( Trace_catchUp( &spilled, &lost ) )
+    {
+        traceFram.record[ traceFram.head ] = lost;
+        traceFram.head = ( traceFram.head + 1 ) & ( TRACE_FRAM_RECORDS - 1 );
+    }
+    while ( spilled != traceWritten )
+    {
+        traceFram.record[ traceFram.head ] = traceLog.record[ spilled & ( TRACE_RECORDS - 1 ) ];
+        traceFram.head = ( traceFram.head + 1 ) & ( TRACE_FRAM_RECORDS - 1 );
+        spilled = spilled + 1;
+    }
+    Fram_close( window );
+#endif
+}
@@ -0,0 +1,106 @@
+/*
+ * myTrace.h
+ *
+ */
+
+#ifndef MYTRACE_H_
+#define MYTRACE_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define TRACE_RECORDS               64                                          // Records in the RAM ring (power of 2)
+#define TRACE_FRAM_RECORDS          1024                                        // Records in the FRAM ring (power of 2)
+#define TRACE_MAGIC                 0x5254                                      // "TR", marks the start of a dumped log
+
+// Define TRACE_FRAM in the project's predefined symbols to keep a longer
+// history in FRAM: Trace_spill() copies new RAM records there. Define
+// TRACE_DISABLE to compile all tracing out.
+
+//***** Event IDs *************************************************************
+// Keep tools/tracedump.c in step with this list.
+#define TRACE_NONE                  0                                           // Empty record
+#define TRACE_BOOT                  1                                           // payload: reset reason (SYSRSTIV)
+#define TRACE_CLOCKS                2                                           // payload: MCLK in kHz
+#define TRACE_GAME_START            3                                           // payload: level | endless << 8 | adaptive << 9
+#define TRACE_RESUME                4                                           // payload: round
+#define TRACE_ROUND                 5                                           // payload: round
+#define TRACE_LED                   6                                           // payload: symbol shown
+#define TRACE_BUTTON_DOWN           7                                           // payload: button (1 or 2)
+#define TRACE_BUTTON_UP             8                                           // payload: button (1 or 2)
+#define TRACE_TIMEOUT               9                                           // payload: round
+#define TRACE_GAME_OVER             10                                          // payload: score
+#define TRACE_LCD_WORD              11                                          // payload: first two characters
+#define TRACE_LCD_NUMBER            12                                          // payload: number (low 16 bits)
+#define TRACE_LCD_SCROLL            13                                          // payload: scroll offset
+#define TRACE_SLEEP                 14                                          // payload: 3 = LPM3, 4 = LPM4
+#define TRACE_WAKE                  15                                          // payload: 1 = button, 0 = timeout
+#define TRACE_PHASE                 16                                          // payload: TRACE_PHASE_xxx, what the game does next
+#define TRACE_STACK                 17                                          // payload: most bytes of stack used so far
+#define TRACE_ISR_TIME              18                                          // payload: ISR_xxx << 12 | longest run (Timer_0 counts)
+#define TRACE_ISR_LATENCY           19                                          // payload: ISR_xxx << 12 | latest start (Timer_0 counts)
+#define TRACE_LOST                  20                                          // payload: records written over before they were read
+
+// Payloads of TRACE_PHASE. Together they cover the whole main loop, so the
+// time (and, on the simulated board, the charge) can be split between them.
+#define TRACE_PHASE_START           0                                           // "PRESS S1 OR S2" scrolls by
+#define TRACE_PHASE_WAIT            1                                           // GetRandomSequence() polls the buttons
+#define TRACE_PHASE_LEVEL           2                                           // GetDifficultyLevel()
+#define TRACE_PHASE_INTRO           3                                           // Round intro, "ROUND" and its number
+#define TRACE_PHASE_PLAYBACK        4                                           // ShowSequence()
+#define TRACE_PHASE_INPUT           5                                           // GetUserSequence()
+#define TRACE_PHASE_GAME_OVER       6                                           // GameOverMessage()
+
+//***** Type Definitions ******************************************************
+typedef struct
+{
+    uint16_t time;                                                              // Timer_0 count (SMCLK)
+    uint16_t epoch;                                                             // Timer_0 wraps (every 32.768ms)
+    uint16_t id;                                                                // TRACE_xxx
+    uint16_t payload;
+} TraceRecord;
+
+typedef struct
+{
+    uint16_t    magic;                                                          // TRACE_MAGIC
+    uint16_t    records;                                                        // Size of the ring
+    uint16_t    head;                                                           // Next record to write
+    uint16_t    smclkKhz;                                                       // Timer_0 rate, for the decoder
+    TraceRecord record[ TRACE_RECORDS ];
+} TraceLog;
+
+//***** Prototypes ************************************************************
+void Trace_init( void );                                                        // Set up the log header
+void Trace_spill( void );                                                       // Copy new records to FRAM (TRACE_FRAM only)
+int  Trace_catchUp( uint16_t *, TraceRecord * );                                // Move a reader past records written over
+void Trace_now( uint16_t *, uint16_t * );                                       // Timer_0 count and epoch, from anywhere
+
+//***** Global Variables ******************************************************
+extern TraceLog          traceLog;
+extern volatile uint16_t traceEpoch;                                            // Counted by the Timer_0 ISR
+extern uint16_t          traceWritten;                                          // Records logged, wraps at 65536
+
+//***** Macros ****************************************************************
+// Logs one event. It is a macro so it costs only the four stores and the
+// ring index update. Only call it from main context, not from ISRs: the
+// epoch is read again after TA0R, and the count read again if Timer_0
+// wrapped in between, which takes the Timer_0 ISR running.
+#ifndef TRACE_DISABLE
+#define TRACE( event, value )                                                   \
+    do {                                                                        \
+        TraceRecord *rec_ = &traceLog.record[ traceLog.head ];                  \
+        do {                                                                    \
+            rec_->epoch = traceEpoch;                                           \
+            rec_->time  = TA0R;                                                 \
+        } while ( rec_->epoch != traceEpoch );                                  \
+        rec_->id      = ( event );                                              \
+        rec_->payload = ( value );                                              \
+        traceWritten  = traceWritten + 1;                                       \
+        traceLog.head = traceWritten & ( TRACE_RECORDS - 1 );                   \
+    } while ( 0 )
+#else
+#define TRACE( event, value )       do { } while ( 0 )
+#endif
+
+
+#endif /* MYTRACE_H_ */
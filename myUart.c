@@ -0,0 +1,254 @@
+// ----------------------------------------------------------------------------
+// myUart.c  ('FR6989 Launchpad)
+//
+// Transmit side of the LaunchPad's backchannel UART (eUSCI_A1 on P3.4 and
+// P3.5, which the eZ-FET shows on the PC as a virtual COM port).
+//
+// Uart_sendFrame() never waits. It COBS-encodes a frame straight into a ring
+// in RAM and returns; if the ring is full the frame is dropped and counted in
+// uartDropped. DMA channel 0 moves the ring to the UART one byte per UCTXIFG,
+// so the CPU only wakes up once per contiguous chunk of the ring, in the DMA
+// ISR. The eUSCI keeps requesting SMCLK while it is sending, so a frame still
+// goes out while the game sleeps in LPM0 to LPM3.
+//
+// COBS (Consistent Overhead Byte Stuffing) removes every 0x00 from a frame
+// at the cost of one byte, so 0x00 can mark the end of each frame. A reader
+// that starts in the middle of the stream is back in step at the next 0x00.
+// ----------------------------------------------------------------------------
+
+//***** Header Files **********************************************************
+#include <driverlib.h>
+#include "myUart.h"
+#include "myIsr.h"
+
+
+//***** Defines ***************************************************************
+#define UART_TXD            0x10        // P3.4 is UCA1TXD
+#define UART_RXD            0x20        // P3.5 is UCA1RXD
+#define TX_MASK             ( UART_TX_BYTES - 1 )
+
+
+//***** Global Variables ******************************************************
+static uint8_t           txRing[ UART_TX_BYTES ];
+static volatile uint16_t txHead  = 0;                                           // Next byte to queue
+static volatile uint16_t txTail  = 0;                                           // Next byte for the DMA
+static volatile uint16_t txChunk = 0;                                           // Bytes in the current DMA block
+static volatile int      txBusy  = 0;                                           // Is a DMA block in flight?
+
+volatile uint16_t uartDropped = 0;
+
+
+//*****************************************************************************
+// Uart_startDma()
+//
+// Starts DMA channel 0 on the bytes from the tail up to the head, or up to
+// the end of the ring if the queued bytes wrap around. Interrupts must be
+// off and the ring must not be empty.
+//*****************************************************************************
+static void Uart_startDma( void )
+{
+    uint16_t end = ( txHead > txTail ) ? txHead : UART_TX_BYTES;
+
+    txChunk = end - txTail;
+    __data16_write_addr( (unsigned short)&DMA0SA, (unsigned long)&txRing[ txTail ] );
+    DMA0SZ  = txChunk;
+    DMA0CTL = DMADT_0 | DMASRCINCR_3 | DMADSTINCR_0 |                           // Single transfers, source increments
+              DMASRCBYTE | DMADSTBYTE | DMAIE | DMAEN;
+    txBusy  = 1;
+
+    UCA1IFG &= ~UCTXIFG;                                                        // The DMA triggers on a rising edge of
+    UCA1IFG |=  UCTXIFG;                                                        //  UCTXIFG, so make one for the first byte
+}
+
+//*****************************************************************************
+// Uart_init()
+//
+// Sets up eUSCI_A1 for 115200 baud, 8N1, from the 2MHz SMCLK, and routes
+// its transmit flag to DMA channel 0.
+//*****************************************************************************
+void Uart_init( void )
+{
+    P3SEL0 |=  ( UART_TXD | UART_RXD );                                         // Primary function: eUSCI_A1
+    P3SEL1 &= ~( UART_TXD | UART_RXD );
+
+    UCA1CTLW0  = UCSWRST;                                                       // Hold the eUSCI in reset to configure it
+    UCA1CTLW0 |= UCSSEL__SMCLK;
+    UCA1BRW    = 1;                                                             // 2MHz / 115200 = 17.36: oversample by 16,
+    UCA1MCTLW  = UCOS16 | UCBRF_1 | 0x4A00;                                     //  BR = 1, BRF = 1, BRS = 0x4A (SLAU367 table)
+    UCA1CTLW0 &= ~UCSWRST;
+
+    DMACTL0 = ( DMACTL0 & 0xFF00 ) | DMA0TSEL__UCA1TXIFG;                       // Channel 0 follows UCA1TXIFG
+    DMACTL4 = DMARMWDIS;                                                        // Don't split the CPU's read-modify-writes
+    __data16_write_addr( (unsigned short)&DMA0DA, (unsigned long)&UCA1TXBUF );  // Every byte goes to the UART
+}
+
+//*****************************************************************************
+// Uart_sendFrame()
+//
+// COBS-encodes a frame into the transmit ring, followed by the 0x00
+// delimiter, and starts the DMA if it is idle. The frame is dropped if it
+// doesn't fit. Frames are at most UART_FRAME_MAX bytes, well under the 254
+// byte run where COBS would need an extra code byte. Interrupts are held
+// off while the frame is encoded (a few hundred cycles at most), so frames
+// can be sent from ISRs as well as from main context.
+//
+// Returns 1 if the frame was queued, 0 if it was dropped.
+//
+// Arg 1: "data" is the frame
+// Arg 2: "length" is the number of bytes in the frame
+//*****************************************************************************
+int Uart_sendFrame( const uint8_t *data, unsigned int length )
+{
+    uint16_t     head;
+    uint16_t     code;                                                          // Where the current run's code byte goes
+    uint8_t      run  = 1;                                                      // Code byte: run length + 1
+    unsigned int k;
+    uint16_t     state;
+
+    state = __get_interrupt_state();
+    __disable_interrupt();
+
+    head = txHead;
+    if ( ( length > UART_FRAME_MAX ) ||
+         ( ( ( txTail - head - 1 ) & TX_MASK ) < length + 2 ) )                 // Code byte + data + delimiter
+    {
+        uartDropped = uartDropped + 1;
+        __set_interrupt_state( state );
+        return 0;
+    }
+
+    code = head;
+    head = ( head + 1 ) & TX_MASK;
+    for ( k = 0; k < length; k++ )
+    {
+        if ( data[ k ] == 0 )                                                   // A zero ends the run
+        {
+            txRing[ code ] = run;
+            code = head;
+            run  = 1;
+        }
+        else
+        {
+            txRing[ head ] = data[ k ];
+            run++;
+        }
+        head = ( head + 1 ) & TX_MASK;
+    }
+    txRing[ code ] = run;
+    txRing[ head ] = 0;                                                         // End of frame
+    head = ( head + 1 ) & TX_MASK;
+
+    txHead = head;
+    if ( !txBusy )
+    {
+        Uart_startDma();
+    }
+    __set_interrupt_state( state );
+
+    return 1;
+}
+
+//*****************************************************************************
+// Uart_encode()
+//
+// COBS-encodes a frame, followed by the 0x00 delimiter, for a UART that
+// doesn't go through the ring. The output takes at most length + 2 bytes.
+//
+// Returns the number of bytes written.
+//
+// Arg 1: "data" is the frame, at most UART_FRAME_MAX bytes
+// Arg 2: "length" is the number of bytes in the frame
+// Arg 3: "out" is where the encoded frame goes
+//*****************************************************************************
+unsigned int Uart_encode( const uint8_t *data, unsigned int length, uint8_t *out )
+{
+    unsigned int code = 0;                                                      // Where the current run's code byte goes
+    unsigned int n    = 1;
+    uint8_t      run  = 1;                                                      // Code byte: run length + 1
+    unsigned int k;
+
+    for ( k = 0; k < length; k++ )
+    {
+        if ( data[ k ] == 0 )                                                   // A zero ends the run
+        {
+            out[ code ] = run;
+            code = n;
+            run  = 1;
+        }
+        else
+        {
+            out[ n ] = data[ k ];
+            run++;
+        }
+        n++;
+    }
+    out[ code ] = run;
+    out[ n++ ]  = 0;                                                            // End of frame
+    return n;
+}
+
+//*****************************************************************************
+// Uart_decode()
+//
+// Decodes a COBS frame (without its 0x00) in place. Returns its length, or
+// 0 if it is malformed.
+//
+// Arg 1: "frame" is the frame as received
+// Arg 2: "length" is the number of bytes received
+//*****************************************************************************
+unsigned int Uart_decode( uint8_t *frame, unsigned int length )
+{
+    unsigned int in = 0;
+    unsigned int out = 0;
+    unsigned int code;
+
+    while ( in < length )
+    {
+        code = frame[ in++ ];
+        if ( in + code - 1 > length )
+        {
+            return 0;
+        }
+        while ( --code )
+        {
+            frame[ out++ ] = frame[ in++ ];
+        }
+        if ( in < length )                                                      // Runs are < 254 bytes, so each one
+        {                                                                       //  but the last ended in a zero
+            frame[ out++ ] = 0;
+        }
+    }
+    return out;
+}
+
+//*****************************************************************************
+// Uart_busy()
+//
+// Returns 1 until every queued byte has left the UART's shift register.
+// Check it before a sleep mode that stops SMCLK (LPM4).
+//*****************************************************************************
+int Uart_busy( void )
+{
+    return txBusy || ( UCA1STATW & UCBUSY );
+}
+
+
+// DMA Interrupt Service Routine
+#pragma vector=DMA_VECTOR
+__interrupt void DMA_ISR (void)
+{
+    ISR_ENTER( ISR_DMA );
+    if ( DMAIV == DMAIV_DMA0IFG )                                               // Channel 0 finished a block
+    {
+        txTail = ( txTail + txChunk ) & TX_MASK;
+        if ( txTail != txHead )                                                 // More was queued meanwhile
+        {
+            Uart_startDma();
+        }
+        else
+        {
+            txBusy = 0;
+        }
+    }
+    ISR_EXIT( ISR_DMA );
+}
@@ -0,0 +1,26 @@
+/*
+ * myUart.h
+ *
+ */
+
+#ifndef MYUART_H_
+#define MYUART_H_
+
+#include <stdint.h>
+
+//***** Defines ***************************************************************
+#define UART_TX_BYTES               512                                         // Size of the transmit ring (power of 2)
+#define UART_FRAME_MAX              64                                          // Longest frame before COBS encoding
+
+//***** Prototypes ************************************************************
+void Uart_init( void );                                                         // eUSCI_A1 at 115200 baud, DMA channel 0
+int  Uart_sendFrame( const uint8_t *, unsigned int );                           // Queue one COBS frame, 0 if it was dropped
+int  Uart_busy( void );                                                         // Is the DMA still sending?
+unsigned int Uart_encode( const uint8_t *, unsigned int, uint8_t * );           // COBS-encode a frame and its 0x00
+unsigned int Uart_decode( uint8_t *, unsigned int );                            // Decode a COBS frame in place
+
+//***** Global Variables ******************************************************
+extern volatile uint16_t uartDropped;                                           // Frames dropped because the ring was full
+
+
+#endif /* MYUART_H_ */
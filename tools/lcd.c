@@ -0,0 +1,168 @@
+// ----------------------------------------------------------------------------
+// lcd.c  (host tool)
+//
+// Prints the LCD frames saved by the simulated board, and checks them
+// against a golden run.
+//
+//    cc -O2 -o lcd tools/lcd.c
+//    ./simboard --lockstep --lcd run.lcd &
+//    ./lcd run.lcd                       (one line per frame)
+//    ./lcd -a run.lcd                    (and each frame as segment art)
+//    ./lcd -d golden.lcd run.lcd         (compare with a golden run)
+//
+// A frame is printed as its Timer_1 tick, the six characters (see lcd.h:
+// '#' is a position with every segment on, '?' any other pattern that isn't
+// a character) and the icons that are on.
+//
+// With -d, the frames of the two runs must match one for one, in time and
+// in every bit of LCD memory. The files are mapped and compared whole, so
+// checking a long run costs little more than reading it; only where they
+// differ are frames decoded, and the first difference is printed with the
+// frames on both sides. Record a golden run with a lockstep simboard and a
+// fixed runner seed (or a replay), then check later builds against it.
+//
+// The exit status is 1 if any frame had a glitch or, with -d, if the runs
+// differ.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lcd.h"
+
+static int art = 0;                                                             // -a: segment art too
+
+
+// Maps a frame file. Returns its frames and their number in *count, or
+// NULL after printing why not.
+static const LcdFrame *mapFrames( const char *name, size_t *count )
+{
+    const LcdFileHeader *h;
+    struct stat st;
+    int fd = open( name, O_RDONLY );
+
+    if ( fd < 0 || fstat( fd, &st ) != 0 )
+    {
+        perror( name );
+        return NULL;
+    }
+    h = ( st.st_size >= (off_t)sizeof( *h ) ) ? mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 ) : MAP_FAILED;
+    close( fd );
+    if ( h == MAP_FAILED || h->magic != LCD_FRAME_MAGIC || h->version != LCD_FRAME_VERSION ||
+         h->frameBytes != sizeof( LcdFrame ) )
+    {
+        fprintf( stderr, "%s: not an LCD frame file\n", name );
+        return NULL;
+    }
+    *count = ( st.st_size - sizeof( *h ) ) / sizeof( LcdFrame );
+    return (const LcdFrame *)( h + 1 );
+}
+
+// Prints one frame. Returns its glitches.
+static int printFrame( const char *label, const LcdFrame *f )
+{
+    LcdText text;
+    int     glitches = lcdDecode( f->mem, &text );
+
+    printf( "%s%10lu  %s \"%s\"", label, (unsigned long)f->tick, f->on ? "on " : "off", text.text );
+    lcdPrintIcons( stdout, text.icons );
+    printf( "%s\n", glitches ? "  GLITCH" : "" );
+    if ( art )
+    {
+        lcdPrintArt( stdout, f->mem, "              " );
+    }
+    return glitches;
+}
+
+static int list( const LcdFrame *frames, size_t count )
+{
+    size_t k, glitches = 0;
+
+    for ( k = 0; k < count; k++ )
+    {
+        glitches += printFrame( "", &frames[k] ) != 0;
+    }
+    printf( "%lu frames, %lu with glitches\n", (unsigned long)count, (unsigned long)glitches );
+    return glitches != 0;
+}
+
+static int compare( const LcdFrame *golden, size_t goldenCount, const LcdFrame *frames, size_t count )
+{
+    size_t  same = ( count < goldenCount ) ? count : goldenCount;
+    size_t  first, k, differ = 0, glitches = 0;
+    LcdText text;
+
+    if ( count == goldenCount && memcmp( golden, frames, count * sizeof( LcdFrame ) ) == 0 )
+    {
+        for ( k = 0; k < count; k++ )                                           // Same as the golden run, which may
+        {                                                                       //  have glitches of its own
+            glitches += lcdDecode( frames[k].mem, &text ) != 0;
+        }
+        printf( "%lu frames, the same as the golden run, %lu with glitches\n", (unsigned long)count,
+                (unsigned long)glitches );
+        return glitches != 0;
+    }
+
+    for ( first = 0; first < same && memcmp( &golden[ first ], &frames[ first ], sizeof( LcdFrame ) ) == 0; first++ );
+    for ( k = first; k < same; k++ )
+    {
+        differ += memcmp( &golden[k], &frames[k], sizeof( LcdFrame ) ) != 0;
+    }
+    printf( "frame %lu is the first that differs (of %lu and %lu in the golden run):\n",
+            (unsigned long)first, (unsigned long)count, (unsigned long)goldenCount );
+    for ( k = ( first > 2 ) ? first - 2 : 0; k < first; k++ )
+    {
+        printFrame( "      both  ", &frames[k] );
+    }
+    if ( first < goldenCount )
+    {
+        printFrame( "    golden  ", &golden[ first ] );
+    }
+    if ( first < count )
+    {
+        printFrame( "      this  ", &frames[ first ] );
+    }
+    printf( "%lu of the %lu frames in both differ\n", (unsigned long)differ, (unsigned long)same );
+    return 1;
+}
+
+int main( int argc, char *argv[] )
+{
+    const LcdFrame *frames, *golden = NULL;
+    size_t count, goldenCount = 0;
+    const char *goldenName = NULL;
+
+    while ( argc > 2 && argv[1][0] == '-' )
+    {
+        if ( strcmp( argv[1], "-a" ) == 0 )
+        {
+            art = 1;
+        }
+        else if ( strcmp( argv[1], "-d" ) == 0 && argc > 3 )
+        {
+            goldenName = argv[2];
+            argc--;
+            argv++;
+        }
+        else
+        {
+            break;
+        }
+        argc--;
+        argv++;
+    }
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s [-a] [-d golden.lcd] frames.lcd\n", argv[0] );
+        return 2;
+    }
+    if ( !( frames = mapFrames( argv[1], &count ) ) || ( goldenName && !( golden = mapFrames( goldenName, &goldenCount ) ) ) )
+    {
+        return 1;
+    }
+    return golden ? compare( golden, goldenCount, frames, count ) : list( frames, count );
+}
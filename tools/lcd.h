@@ -0,0 +1,217 @@
+/*
+ * lcd.h  (host tools)
+ *
+ * Turns the LaunchPad's LCD memory back into what the display shows: the
+ * characters at its six positions, the icons, and, as text art, every
+ * segment. Shared by the runner, the telemetry reader, the simulated board
+ * and tools/lcd.c.
+ *
+ * The memory is LCDM1 to LCDM22, as in a TELEMETRY_LCD frame. Each
+ * position is two bytes of it, the four nibbles listed in SegmentLoc in
+ * myLcd.c. The first byte holds segments a-f, g and m, the second h, j, k,
+ * p, q and n, plus two bits that belong to icons (the decimal points, the
+ * colons and a few symbols). Characters are matched against the digit and
+ * alphabetBig patterns without those two bits.
+ *
+ * myLCD_showChar() turns every segment of a position on for a character it
+ * has no pattern for. That is never meant to be seen, so lcdDecode() flags
+ * it as a glitch.
+ *
+ * Also defines the frame file the simulated board writes with --lcd: an
+ * LcdFileHeader, then one LcdFrame for each change of the display, read in
+ * place like a replay file (see replay.h).
+ */
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LCD_MEM_BYTES       22                                                  // LCDM1-22 cover all segment pins
+#define LCD_POSITIONS       6
+#define LCD_ICONS           24
+
+#define LCD_GLITCH_CHAR     '#'                                                 // All segments on
+#define LCD_UNKNOWN_CHAR    '?'                                                 // Any other pattern that isn't a character
+
+#define LCD_FRAME_MAGIC     0x4644434C                                          // "LCDF"
+#define LCD_FRAME_VERSION   1
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t frameBytes;                                                        // sizeof( LcdFrame )
+} LcdFileHeader;
+
+typedef struct
+{
+    uint32_t tick;                                                              // Timer_1 ticks since reset
+    uint8_t  on;                                                                // LCD_C_on() rather than LCD_C_off()
+    uint8_t  reserved;
+    uint8_t  mem[ LCD_MEM_BYTES ];                                              // LCDM1 to LCDM22
+} LcdFrame;
+
+typedef struct
+{
+    char     text[ LCD_POSITIONS + 1 ];                                         // Positions 1-6, and a 0
+    uint32_t icons;                                                             // Bit n for icon n, as numbered in myLcd.h
+    uint8_t  glitches;                                                          // Bit p for position p+1 with all segments on
+} LcdText;
+
+// Keep in step with myLcd.c and myLcd.h
+static const uint8_t lcdSegmentLoc[ LCD_POSITIONS ][ 4 ] =
+{
+    { 18, 19, 20, 21 }, { 10, 11, 12, 13 }, {  6,  7,  8,  9 },
+    { 36, 37, 38, 39 }, { 28, 29, 30, 31 }, { 14, 15, 16, 17 }
+};
+static const uint8_t lcdDigit[10][2] =
+{
+    { 0xFC, 0x28 }, { 0x60, 0x20 }, { 0xDB, 0x00 }, { 0xF3, 0x00 }, { 0x67, 0x00 },
+    { 0xB7, 0x00 }, { 0xBF, 0x00 }, { 0xE4, 0x00 }, { 0xFF, 0x00 }, { 0xF7, 0x00 }
+};
+static const uint8_t lcdLetter[26][2] =
+{
+    { 0xEF, 0x00 }, { 0xF1, 0x50 }, { 0x9C, 0x00 }, { 0xF0, 0x50 }, { 0x9F, 0x00 },
+    { 0x8F, 0x00 }, { 0xBD, 0x00 }, { 0x6F, 0x00 }, { 0x90, 0x50 }, { 0x78, 0x00 },
+    { 0x0E, 0x22 }, { 0x1C, 0x00 }, { 0x6C, 0xA0 }, { 0x6C, 0x82 }, { 0xFC, 0x00 },
+    { 0xCF, 0x00 }, { 0xFC, 0x02 }, { 0xCF, 0x02 }, { 0xB7, 0x00 }, { 0x80, 0x50 },
+    { 0x7C, 0x00 }, { 0x0C, 0x28 }, { 0x6C, 0x0A }, { 0x00, 0xAA }, { 0x00, 0xB0 },
+    { 0x90, 0x28 }
+};
+static const struct { uint8_t idx; uint8_t bit; const char *name; } lcdIcon[ LCD_ICONS ] =
+{
+    {  3, 0x08, "TMR" },  {  3, 0x04, "HRT" },  {  3, 0x02, "REC" },  {  3, 0x01, "!" },
+    { 18, 0x10, "[]" },   { 14, 0x10, "BATT" }, { 18, 0x20, "B1" },   { 14, 0x20, "B2" },
+    { 18, 0x40, "B3" },   { 14, 0x40, "B4" },   { 18, 0x80, "B5" },   { 14, 0x80, "B6" },
+    {  5, 0x04, "ANT" },  {  9, 0x04, "TX" },   {  9, 0x01, "RX" },   { 11, 0x04, "NEG" },
+    { 16, 0x04, "DEG" },  { 11, 0x01, "A1DP" }, {  7, 0x01, "A2DP" }, {  5, 0x01, "A3DP" },
+    { 20, 0x01, "A4DP" }, { 16, 0x01, "A5DP" }, {  7, 0x04, "A2COL" },{ 20, 0x04, "A4COL" }
+};
+static const uint8_t lcdPointIcon[ LCD_POSITIONS ] = { 17, 18, 19, 20, 21, 0xFF };   // Decimal point after each position
+static const uint8_t lcdColonIcon[ LCD_POSITIONS ] = { 0xFF, 22, 0xFF, 23, 0xFF, 0xFF };
+
+#define LCD_ICON_BITS       0x05                                                // In a position's second byte
+
+static uint8_t lcdChar[ 65536 ];                                                // Character for each pair of bytes
+static int     lcdReady = 0;
+
+
+static inline void lcdInit( void )
+{
+    unsigned int k;
+
+    for ( k = 0; k < 65536; k++ )
+    {
+        lcdChar[k] = ( k & ~LCD_ICON_BITS ) ? LCD_UNKNOWN_CHAR : ' ';
+    }
+    for ( k = 0; k < 10; k++ )
+    {
+        lcdChar[ ( lcdDigit[k][0] << 8 ) | lcdDigit[k][1] ] = '0' + k;
+    }
+    for ( k = 0; k < 26; k++ )                                                  // After the digits: 'S' is also '5'
+    {
+        lcdChar[ ( lcdLetter[k][0] << 8 ) | lcdLetter[k][1] ] = 'A' + k;
+    }
+    lcdChar[ 0xFFFF & ~LCD_ICON_BITS ] = LCD_GLITCH_CHAR;
+    for ( k = 0; k < 65536; k++ )                                               // The icon bits don't change the character
+    {
+        lcdChar[k] = lcdChar[ k & ~LCD_ICON_BITS ];
+    }
+    lcdReady = 1;
+}
+
+static inline int lcdIconOn( const uint8_t *mem, unsigned int icon )
+{
+    return icon < LCD_ICONS && ( mem[ lcdIcon[ icon ].idx - 1 ] & lcdIcon[ icon ].bit );
+}
+
+// The two bytes of a position: first a-f/g/m, then h/j/k/p/q/n and icons
+static inline unsigned int lcdPair( const uint8_t *mem, int pos )
+{
+    return ( mem[ lcdSegmentLoc[pos][0] / 2 ] << 8 ) | mem[ lcdSegmentLoc[pos][2] / 2 ];
+}
+
+// Decodes the LCD memory 'mem' (LCDM1-22) into 'out'. Returns the glitches.
+static inline int lcdDecode( const uint8_t *mem, LcdText *out )
+{
+    int pos, k;
+
+    if ( !lcdReady )
+    {
+        lcdInit();
+    }
+    out->glitches = 0;
+    for ( pos = 0; pos < LCD_POSITIONS; pos++ )
+    {
+        out->text[ pos ] = (char)lcdChar[ lcdPair( mem, pos ) ];
+        out->glitches   |= ( out->text[ pos ] == LCD_GLITCH_CHAR ) << pos;
+    }
+    out->text[ LCD_POSITIONS ] = 0;
+
+    out->icons = 0;
+    for ( k = 0; k < LCD_ICONS; k++ )
+    {
+        out->icons |= (uint32_t)( lcdIconOn( mem, k ) != 0 ) << k;
+    }
+    return out->glitches;
+}
+
+// Prints the names of the icons that are on, each after a space.
+static inline void lcdPrintIcons( FILE *f, uint32_t icons )
+{
+    int k;
+
+    for ( k = 0; k < LCD_ICONS; k++ )
+    {
+        if ( icons & ( 1UL << k ) )
+        {
+            fprintf( f, " %s", lcdIcon[k].name );
+        }
+    }
+}
+
+// Prints the display as five lines of text art, each segment a character,
+// with the decimal points and colons between the positions.
+static inline void lcdPrintArt( FILE *f, const uint8_t *mem, const char *indent )
+{
+    int row, pos;
+
+    for ( row = 0; row < 5; row++ )
+    {
+        fputs( indent, f );
+        for ( pos = 0; pos < LCD_POSITIONS; pos++ )
+        {
+            unsigned int s = lcdPair( mem, pos );
+
+            switch ( row )
+            {
+            case 0:                                                             // a
+                fputs( s & 0x8000 ? " --- " : "     ", f );
+                break;
+            case 1:                                                             // f h j k b
+                fprintf( f, "%c%c%c%c%c", s & 0x0400 ? '|' : ' ', s & 0x0080 ? '\\' : ' ', s & 0x0040 ? '|' : ' ',
+                         s & 0x0020 ? '/' : ' ', s & 0x4000 ? '|' : ' ' );
+                break;
+            case 2:                                                             // g m
+                fprintf( f, "%s %s", s & 0x0200 ? "--" : "  ", s & 0x0100 ? "--" : "  " );
+                break;
+            case 3:                                                             // e q p n c
+                fprintf( f, "%c%c%c%c%c", s & 0x0800 ? '|' : ' ', s & 0x0008 ? '/' : ' ', s & 0x0010 ? '|' : ' ',
+                         s & 0x0002 ? '\\' : ' ', s & 0x2000 ? '|' : ' ' );
+                break;
+            case 4:                                                             // d
+                fputs( s & 0x1000 ? " --- " : "     ", f );
+                break;
+            }
+            fputc( ( row == 2 && lcdIconOn( mem, lcdColonIcon[ pos ] ) ) ? ':' :
+                   ( row == 4 && lcdIconOn( mem, lcdPointIcon[ pos ] ) ) ? '.' : ' ', f );
+        }
+        fputc( '\n', f );
+    }
+}
+
+
+#endif /* LCD_H_ */
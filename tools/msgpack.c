@@ -0,0 +1,317 @@
+// ----------------------------------------------------------------------------
+// msgpack.c  (host tool)
+//
+// Packs the messages the game scrolls across the LCD (tools/messages.txt)
+// into the tables myMessage.c reads, and writes them out as C.
+//
+//    cc -O2 -o msgpack tools/msgpack.c
+//    ./msgpack tools/messages.txt myMessageData
+//
+// writes myMessageData.c and myMessageData.h. Run it again after changing
+// the messages, and check in all three files.
+//
+// Each line of the message file is an ID and the text, such as
+//
+//    MSG_YOU_WIN         YOU WIN
+//
+// and '#' starts a comment line. The text can use A-Z, 0-9 and spaces.
+//
+// The messages share one dictionary of LCD segment patterns, the two bytes
+// of a position (from lcd.h, which matches myLcd.c), with the blank first.
+// Characters that look alike ('S' and '5') share an entry. A message is a
+// string of 4-bit codes, two to a byte, low nibble first: a code below
+// MESSAGE_ESCAPE is that entry of the dictionary, and MESSAGE_ESCAPE adds
+// the code after it, for entries MESSAGE_ESCAPE to 2 * MESSAGE_ESCAPE. The
+// patterns are numbered by how often they are used, so most characters
+// take one nibble and none more than two. Messages start at any nibble and
+// follow on from each other.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lcd.h"
+
+#define MESSAGES_MAX    64
+#define TEXT_MAX        250                                                     // As ScrollWords() takes
+#define ID_MAX          40
+#define GLYPHS_MAX      256
+#define CODE_MAX        8192                                                    // Nibbles
+
+#define ESCAPE          15                                                      // MESSAGE_ESCAPE in myMessage.h
+#define ENTRIES_MAX     ( 2 * ESCAPE + 1 )                                      // Dictionary entries a code can reach
+
+typedef struct
+{
+    char         id[ ID_MAX ];
+    char         text[ TEXT_MAX + 1 ];
+    unsigned int start;                                                         // First nibble of its code
+} Message;
+
+typedef struct
+{
+    uint8_t      bytes[2];                                                      // The segment pattern
+    char         chars[ 40 ];                                                   // The characters it shows
+    unsigned int uses;
+    unsigned int first;                                                         // Where it is first used, to break ties
+} Glyph;
+
+static Message      messages[ MESSAGES_MAX ];
+static int          messageCount = 0;
+static Glyph        glyphs[ GLYPHS_MAX ];
+static int          glyphCount = 0;
+static uint8_t      code[ CODE_MAX ];
+static unsigned int nibbles = 0;
+
+
+// The segment pattern of a character, as myLCD_showChar() draws it
+static const uint8_t *pattern( char c )
+{
+    static const uint8_t blank[2] = { 0, 0 };
+
+    if ( c >= '0' && c <= '9' )
+    {
+        return lcdDigit[ c - '0' ];
+    }
+    if ( c >= 'A' && c <= 'Z' )
+    {
+        return lcdLetter[ c - 'A' ];
+    }
+    return c == ' ' ? blank : NULL;
+}
+
+// Returns the dictionary entry with the pattern of 'c', adding it if it's new.
+static int glyph( char c, unsigned int at )
+{
+    const uint8_t *p = pattern( c );
+    int k;
+
+    for ( k = 0; k < glyphCount && memcmp( glyphs[k].bytes, p, 2 ) != 0; k++ );
+    if ( k == glyphCount )
+    {
+        memcpy( glyphs[k].bytes, p, 2 );
+        glyphs[k].first = at;
+        glyphCount++;
+    }
+    if ( !strchr( glyphs[k].chars, c ) && strlen( glyphs[k].chars ) + 1 < sizeof( glyphs[k].chars ) )
+    {
+        glyphs[k].chars[ strlen( glyphs[k].chars ) ] = c;
+    }
+    return k;
+}
+
+static int byUses( const void *a, const void *b )
+{
+    const Glyph *x = a, *y = b;
+    int xBlank = !x->bytes[0] && !x->bytes[1], yBlank = !y->bytes[0] && !y->bytes[1];
+
+    if ( xBlank != yBlank )                                                     // The blank is always entry 0
+    {
+        return yBlank - xBlank;
+    }
+    if ( x->uses != y->uses )
+    {
+        return ( x->uses < y->uses ) - ( x->uses > y->uses );
+    }
+    return ( x->first > y->first ) - ( x->first < y->first );
+}
+
+static void putNibble( unsigned int value )
+{
+    code[ nibbles / 2 ] |= (uint8_t)( value << ( nibbles & 1 ? 4 : 0 ) );
+    nibbles++;
+}
+
+static int readMessages( const char *file )
+{
+    FILE *f = fopen( file, "r" );
+    char  line[ 512 ];
+    int   lineNumber = 0, n;
+    unsigned int at = 0;
+
+    if ( !f )
+    {
+        perror( file );
+        return 0;
+    }
+    while ( fgets( line, sizeof( line ), f ) )
+    {
+        Message *m = &messages[ messageCount ];
+        char    *c;
+
+        lineNumber++;
+        line[ strcspn( line, "\r\n" ) ] = 0;
+        if ( line[0] == '#' || sscanf( line, "%39s %n", m->id, &n ) != 1 )
+        {
+            continue;
+        }
+        if ( messageCount == MESSAGES_MAX || strlen( line + n ) == 0 || strlen( line + n ) > TEXT_MAX )
+        {
+            fprintf( stderr, "%s:%d: no text, too long, or too many messages\n", file, lineNumber );
+            return 0;
+        }
+        strcpy( m->text, line + n );
+        for ( c = m->text; *c; c++ )
+        {
+            if ( !pattern( *c ) )
+            {
+                fprintf( stderr, "%s:%d: the LCD can't show '%c'\n", file, lineNumber, *c );
+                return 0;
+            }
+            glyphs[ glyph( *c, at++ ) ].uses++;
+        }
+        messageCount++;
+    }
+    fclose( f );
+    return messageCount > 0;
+}
+
+static void pack( void )
+{
+    int k, g;
+    char *c;
+
+    qsort( glyphs, glyphCount, sizeof( Glyph ), byUses );
+    for ( k = 0; k < messageCount; k++ )
+    {
+        messages[k].start = nibbles;
+        for ( c = messages[k].text; *c; c++ )
+        {
+            for ( g = 0; memcmp( glyphs[g].bytes, pattern( *c ), 2 ) != 0; g++ );
+            if ( g < ESCAPE )
+            {
+                putNibble( g );
+            }
+            else
+            {
+                putNibble( ESCAPE );
+                putNibble( g - ESCAPE );
+            }
+        }
+    }
+}
+
+// Writes 'text' and, from column 81, the comment '// note'
+static void line( FILE *f, const char *note, const char *format, ... )
+{
+    char    text[ 256 ];
+    va_list args;
+
+    va_start( args, format );
+    vsnprintf( text, sizeof( text ), format, args );
+    va_end( args );
+    fprintf( f, "%-80s// %s\n", text, note );
+}
+
+static FILE *create( const char *base, const char *extension, char *name )
+{
+    FILE *f;
+
+    sprintf( name, "%s%s", base, extension );
+    f = fopen( name, "w" );
+    if ( !f )
+    {
+        perror( name );
+        exit( 1 );
+    }
+    return f;
+}
+
+static void writeFiles( const char *base, const char *input )
+{
+    char        name[ 512 ], guard[ 512 ];
+    char        note[ 128 ];
+    const char *file;
+    FILE       *f;
+    int         k;
+    unsigned int bytes = ( nibbles + 1 ) / 2, characters = 0;
+
+    f = create( base, ".h", name );
+    file = strrchr( name, '/' ) ? strrchr( name, '/' ) + 1 : name;
+    for ( k = 0; file[k] && k < (int)sizeof( guard ) - 3; k++ )
+    {
+        guard[k] = ( file[k] >= 'a' && file[k] <= 'z' ) ? file[k] - 'a' + 'A' : file[k] == '.' ? '_' : file[k];
+    }
+    strcpy( guard + k, "_" );
+
+    fprintf( f, "/*\n * %s\n *\n * Made by tools/msgpack.c from %s. Don't edit it: change the\n"
+                " * messages and run the tool again.\n */\n\n", file, input );
+    fprintf( f, "#ifndef %s\n#define %s\n\n#include <stdint.h>\n\n", guard, guard );
+    fprintf( f, "//***** Defines ***************************************************************\n" );
+    for ( k = 0; k < messageCount; k++ )
+    {
+        snprintf( note, sizeof( note ), "\"%s\"", messages[k].text );
+        line( f, note, "#define %-27s %d", messages[k].id, k );
+        characters += strlen( messages[k].text );
+    }
+    fprintf( f, "#define %-27s %d\n", "MESSAGE_COUNT", messageCount );
+    fprintf( f, "#define %-27s %d\n\n", "MESSAGE_GLYPHS", glyphCount );
+    fprintf( f, "//***** Global Variables ******************************************************\n" );
+    line( f, "Segment patterns, blank first", "extern const uint8_t  messageGlyph[ MESSAGE_GLYPHS ][ 2 ];" );
+    line( f, "Characters in each message", "extern const uint8_t  messageLength[ MESSAGE_COUNT ];" );
+    line( f, "Nibble its code starts at", "extern const uint16_t messageStart[ MESSAGE_COUNT ];" );
+    line( f, "Codes, low nibble first", "extern const uint8_t  messageCode[ %u ];", bytes );
+    fprintf( f, "\n\n#endif /* %s */\n", guard );
+    fclose( f );
+
+    f = create( base, ".c", name );
+    file = strrchr( name, '/' ) ? strrchr( name, '/' ) + 1 : name;
+    fprintf( f, "// ----------------------------------------------------------------------------\n"
+                "// %s  ('FR6989 Launchpad)\n//\n"
+                "// The messages of %s, packed by tools/msgpack.c. Don't edit\n"
+                "// it: change the messages and run the tool again. See myMessage.c.\n//\n"
+                "// %d messages, %u characters: %u bytes of code and %d of patterns.\n"
+                "// ----------------------------------------------------------------------------\n\n",
+             file, input, messageCount, characters, bytes, 2 * glyphCount );
+    fprintf( f, "#include \"%.*s.h\"\n\n", (int)( strlen( file ) - 2 ), file );
+
+    fprintf( f, "const uint8_t messageGlyph[ MESSAGE_GLYPHS ][ 2 ] =\n{\n" );
+    for ( k = 0; k < glyphCount; k++ )
+    {
+        snprintf( note, sizeof( note ), "%2d: \"%s\", used %u time%s", k, glyphs[k].chars, glyphs[k].uses,
+                  glyphs[k].uses == 1 ? "" : "s" );
+        line( f, note, "    { 0x%02X, 0x%02X }%s", glyphs[k].bytes[0], glyphs[k].bytes[1], k + 1 < glyphCount ? "," : "" );
+    }
+    fprintf( f, "};\n\nconst uint8_t messageLength[ MESSAGE_COUNT ] =\n{\n" );
+    for ( k = 0; k < messageCount; k++ )
+    {
+        line( f, messages[k].id, "    %u%s", (unsigned int)strlen( messages[k].text ), k + 1 < messageCount ? "," : "" );
+    }
+    fprintf( f, "};\n\nconst uint16_t messageStart[ MESSAGE_COUNT ] =\n{\n" );
+    for ( k = 0; k < messageCount; k++ )
+    {
+        line( f, messages[k].id, "    %u%s", messages[k].start, k + 1 < messageCount ? "," : "" );
+    }
+    fprintf( f, "};\n\nconst uint8_t messageCode[ %u ] =\n{", bytes );
+    for ( k = 0; k < (int)bytes; k++ )
+    {
+        fprintf( f, "%s0x%02X%s", k % 12 ? " " : "\n    ", code[k], k + 1 < (int)bytes ? "," : "" );
+    }
+    fprintf( f, "\n};\n" );
+    fclose( f );
+
+    printf( "%d messages, %u characters: %u bytes of code and %d of patterns, against %u bytes of strings\n",
+            messageCount, characters, bytes, 2 * glyphCount, characters + messageCount );
+}
+
+int main( int argc, char *argv[] )
+{
+    if ( argc != 3 )
+    {
+        fprintf( stderr, "usage: %s messages.txt output (writes output.c and output.h)\n", argv[0] );
+        return 2;
+    }
+    if ( !readMessages( argv[1] ) )
+    {
+        return 1;
+    }
+    if ( glyphCount > ENTRIES_MAX )
+    {
+        fprintf( stderr, "%s: %d patterns, but the code can only reach %d\n", argv[1], glyphCount, ENTRIES_MAX );
+        return 1;
+    }
+    pack();
+    writeFiles( argv[2], argv[1] );
+    return 0;
+}
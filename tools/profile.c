@@ -0,0 +1,297 @@
+// ----------------------------------------------------------------------------
+// profile.c  (host tool)
+//
+// Matches the profiler's histogram (see myProfile.c) with the functions in
+// the firmware's ELF file, to show where the time goes.
+//
+//    cc -O2 -o profile tools/profile.c
+//    ./telemetry /dev/ttyACM1 | ./profile Profile/Flashing-LEDs-Game.out
+//    ./profile Profile/Flashing-LEDs-Game.out < saved-telemetry.txt
+//
+// It reads the output of tools/telemetry.c and passes it through. After
+// each game's dump (its "profile outside" counter) it prints the share of
+// every function and the hottest buckets, over all the games read so far.
+//
+// A bucket is PROFILE_SHIFT bits of address, 64 bytes by default, so it
+// can hold the end of one function and the start of the next. Its samples
+// are then split between them by how many of its bytes each one has: a
+// smaller PROFILE_SHIFT makes that guess matter less. The bucket list shows
+// hot spots inside a function, such as a polling loop.
+//
+// Functions are the STT_FUNC symbols in .symtab; a symbol without a size
+// (an assembly routine) runs to the next one. Build the profiled firmware
+// from the same sources as the ELF file, or the addresses won't match.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <elf.h>
+
+#define BUCKETS_MAX     65536                                                   // Address range of the histogram
+#define HOT_BUCKETS     10                                                      // Buckets listed
+
+typedef struct
+{
+    const char   *name;
+    unsigned long start, end;                                                   // [start, end)
+    double        samples;
+} Function;
+
+static Function      *functions = NULL;
+static int            functionCount = 0;
+
+static unsigned long  counts[ BUCKETS_MAX ];                                    // Samples by bucket address
+static unsigned int   bucketBytes = 0;
+static unsigned long  samples = 0, outside = 0;
+
+
+static int byStart( const void *a, const void *b )
+{
+    const Function *x = a, *y = b;
+
+    return ( x->start > y->start ) - ( x->start < y->start );
+}
+
+static int bySamples( const void *a, const void *b )
+{
+    const Function *x = a, *y = b;
+
+    return ( x->samples < y->samples ) - ( x->samples > y->samples );
+}
+
+// Reads the function symbols of a 32-bit little-endian ELF file.
+static int loadElf( const char *name )
+{
+    FILE       *f = fopen( name, "rb" );
+    Elf32_Ehdr  eh;
+    Elf32_Shdr *sh = NULL;
+    Elf32_Sym  *sym = NULL;
+    char       *strtab = NULL;
+    int         k, symbols = 0;
+
+    if ( !f )
+    {
+        perror( name );
+        return 0;
+    }
+    if ( fread( &eh, sizeof( eh ), 1, f ) != 1 || memcmp( eh.e_ident, ELFMAG, SELFMAG ) != 0 ||
+         eh.e_ident[ EI_CLASS ] != ELFCLASS32 || eh.e_ident[ EI_DATA ] != ELFDATA2LSB ||
+         eh.e_shentsize != sizeof( Elf32_Shdr ) )
+    {
+        fprintf( stderr, "%s: not a 32-bit little-endian ELF file\n", name );
+        fclose( f );
+        return 0;
+    }
+    sh = calloc( eh.e_shnum, sizeof( *sh ) );
+    fseek( f, eh.e_shoff, SEEK_SET );
+    if ( !sh || fread( sh, sizeof( *sh ), eh.e_shnum, f ) != eh.e_shnum )
+    {
+        fprintf( stderr, "%s: can't read the section headers\n", name );
+        fclose( f );
+        return 0;
+    }
+
+    for ( k = 0; k < eh.e_shnum; k++ )
+    {
+        if ( sh[k].sh_type == SHT_SYMTAB && sh[k].sh_link < eh.e_shnum )
+        {
+            const Elf32_Shdr *st = &sh[ sh[k].sh_link ];
+
+            symbols = sh[k].sh_size / sizeof( Elf32_Sym );
+            sym     = malloc( sh[k].sh_size );
+            strtab  = malloc( st->sh_size + 1 );
+            fseek( f, sh[k].sh_offset, SEEK_SET );
+            if ( !sym || fread( sym, sizeof( Elf32_Sym ), symbols, f ) != (size_t)symbols )
+            {
+                symbols = 0;
+            }
+            fseek( f, st->sh_offset, SEEK_SET );
+            if ( !strtab || fread( strtab, 1, st->sh_size, f ) != st->sh_size )
+            {
+                symbols = 0;
+            }
+            else
+            {
+                strtab[ st->sh_size ] = 0;
+            }
+            break;
+        }
+    }
+    fclose( f );
+    free( sh );
+    if ( symbols == 0 )
+    {
+        fprintf( stderr, "%s: no symbol table\n", name );
+        return 0;
+    }
+
+    functions = calloc( symbols, sizeof( Function ) );
+    for ( k = 0; k < symbols; k++ )
+    {
+        if ( ELF32_ST_TYPE( sym[k].st_info ) == STT_FUNC && sym[k].st_shndx != SHN_UNDEF )
+        {
+            functions[ functionCount ].name  = strdup( strtab + sym[k].st_name );
+            functions[ functionCount ].start = sym[k].st_value;
+            functions[ functionCount ].end   = sym[k].st_value + sym[k].st_size;
+            functionCount++;
+        }
+    }
+    qsort( functions, functionCount, sizeof( Function ), byStart );
+    for ( k = 0; k < functionCount; k++ )                                       // No size: up to the next symbol
+    {
+        if ( functions[k].end == functions[k].start && k + 1 < functionCount )
+        {
+            functions[k].end = functions[ k + 1 ].start;
+        }
+    }
+    free( sym );
+    free( strtab );
+    return 1;
+}
+
+// Splits the samples of the bucket at 'address' between the functions that
+// overlap it. Returns the bytes of the bucket no function covers.
+static unsigned int share( unsigned long address, double count, int print )
+{
+    unsigned long end = address + bucketBytes;
+    unsigned int  covered = 0;
+    int           k, named = 0;
+
+    for ( k = 0; k < functionCount; k++ )
+    {
+        unsigned long from = functions[k].start > address ? functions[k].start : address;
+        unsigned long to   = functions[k].end < end ? functions[k].end : end;
+
+        if ( from < to )
+        {
+            covered += to - from;
+            if ( print )
+            {
+                printf( "%s%s", named++ ? ", " : "  ", functions[k].name );
+            }
+            else
+            {
+                functions[k].samples += count * ( to - from ) / bucketBytes;
+            }
+        }
+    }
+    return bucketBytes - ( covered < bucketBytes ? covered : bucketBytes );
+}
+
+static void report( void )
+{
+    unsigned long address, hot[ HOT_BUCKETS ] = { 0 };
+    double        unknown = 0, inBuckets = samples - outside;
+    int           k;
+
+    for ( k = 0; k < functionCount; k++ )
+    {
+        functions[k].samples = 0;
+    }
+    for ( address = 0; address < BUCKETS_MAX; address++ )
+    {
+        if ( counts[ address ] )
+        {
+            unknown += (double)counts[ address ] * share( address, counts[ address ], 0 ) / bucketBytes;
+            for ( k = 0; k < HOT_BUCKETS && counts[ hot[k] ] >= counts[ address ]; k++ );
+            if ( k < HOT_BUCKETS )
+            {
+                memmove( &hot[ k + 1 ], &hot[k], ( HOT_BUCKETS - 1 - k ) * sizeof( hot[0] ) );
+                hot[k] = address;
+            }
+        }
+    }
+    qsort( functions, functionCount, sizeof( Function ), bySamples );
+
+    printf( "profile: %lu samples, %lu (%.1f%%) outside the buckets\n", samples, outside,
+            samples ? 100.0 * outside / samples : 0 );
+    printf( "  %6s %9s  %s\n", "%", "samples", "function" );
+    for ( k = 0; k < functionCount && functions[k].samples >= 0.5; k++ )
+    {
+        printf( "  %6.2f %9.0f  %s\n", 100 * functions[k].samples / inBuckets, functions[k].samples,
+                functions[k].name );
+    }
+    if ( unknown >= 0.5 )
+    {
+        printf( "  %6.2f %9.0f  (no symbol)\n", 100 * unknown / inBuckets, unknown );
+    }
+    printf( "  hottest buckets\n" );
+    for ( k = 0; k < HOT_BUCKETS && counts[ hot[k] ]; k++ )
+    {
+        printf( "  %6.2f %9lu  0x%04lX-0x%04lX", 100.0 * counts[ hot[k] ] / inBuckets, counts[ hot[k] ], hot[k],
+                hot[k] + bucketBytes - 1 );
+        share( hot[k], 0, 1 );
+        printf( "\n" );
+    }
+    qsort( functions, functionCount, sizeof( Function ), byStart );             // Back in address order
+    fflush( stdout );
+}
+
+// Adds one PROFILE line of tools/telemetry.c: "buckets of N bytes:", then
+// address and count pairs.
+static void addLine( const char *line )
+{
+    unsigned long address, count;
+    unsigned int  bytes;
+    int           used;
+
+    if ( sscanf( line, " buckets of %u bytes:%n", &bytes, &used ) != 1 || bytes == 0 || bytes > BUCKETS_MAX )
+    {
+        return;
+    }
+    if ( bucketBytes && bytes != bucketBytes )
+    {
+        fprintf( stderr, "profile: the bucket size changed, starting over\n" );
+        memset( counts, 0, sizeof( counts ) );
+        samples = outside = 0;
+    }
+    bucketBytes = bytes;
+    line += used;
+    while ( sscanf( line, " %lx %lu%n", &address, &count, &used ) == 2 )
+    {
+        if ( address < BUCKETS_MAX )
+        {
+            counts[ address ] += count;
+        }
+        line += used;
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    char          line[ 1024 ];
+    unsigned long value;
+
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s firmware.out < telemetry output\n", argv[0] );
+        return 2;
+    }
+    if ( !loadElf( argv[1] ) )
+    {
+        return 1;
+    }
+
+    while ( fgets( line, sizeof( line ), stdin ) )
+    {
+        fputs( line, stdout );
+        if ( strncmp( line, "PROFILE ", 8 ) == 0 )
+        {
+            addLine( line + 8 );
+        }
+        else if ( sscanf( line, "COUNTER profile samples = %lu", &value ) == 1 )
+        {
+            samples += value;
+        }
+        else if ( sscanf( line, "COUNTER profile outside = %lu", &value ) == 1 )
+        {
+            outside += value;                                                   // The last line of a dump
+            if ( bucketBytes )
+            {
+                report();
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// replay.c  (host tool)
+//
+// Lists the games in replay files recorded by "runner --record", or the
+// button events of one game.
+//
+//    cc -O2 -o replay tools/replay.c
+//    ./replay games.rpl [more.rpl ...]           (every game)
+//    ./replay -s 12 games.rpl                    (games that scored 12)
+//    ./replay -S 0x1234ABCD games.rpl            (games with this seed)
+//    ./replay -g 7 games.rpl                     (the events of game 7)
+//
+// The files are mapped into memory and read in place (see replay.h), so
+// scanning a large collection of games costs little more than the disk
+// reads.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+
+static const char *levelName[] = { "EASY", "NORMAL", "HARD" };
+static const char *buttonsName[] = { "-", "S1", "S2", "S1 S2" };
+
+
+static void printEvents( const ReplayHeader *h, const ReplayGame *g )
+{
+    const ReplayEvent *e = REPLAY_EVENTS( h ) + g->firstEvent;
+    uint32_t last = 0;
+    int k;
+
+    printf( "%10s %8s  %s\n", "tick", "delta", "buttons" );
+    for ( k = 0; k < g->events; k++ )
+    {
+        printf( "%10lu %8lu  %s\n", (unsigned long)e[k].tick, (unsigned long)( e[k].tick - last ),
+                buttonsName[ e[k].buttons & 3 ] );
+        last = e[k].tick;
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    long score = -1, gameIndex = -1;
+    unsigned long seed = 0;
+    int  bySeed = 0, shown = 0, i;
+    uint32_t n;
+
+    while ( argc > 3 && argv[1][0] == '-' && strchr( "sSg", argv[1][1] ) && argv[1][2] == 0 )
+    {
+        switch ( argv[1][1] )
+        {
+        case 's': score     = strtol( argv[2], NULL, 0 );                       break;
+        case 'S': seed      = strtoul( argv[2], NULL, 0 ); bySeed = 1;          break;
+        case 'g': gameIndex = strtol( argv[2], NULL, 0 );                       break;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+    if ( argc < 2 || argv[1][0] == '-' )
+    {
+        fprintf( stderr, "usage: %s [-s score] [-S seed] [-g game] file.rpl ...\n", argv[0] );
+        return 2;
+    }
+
+    printf( "%-16s %6s  %-10s %-6s %-8s %7s %5s %6s  %s\n",
+            "file", "game", "seed", "level", "mode", "mistake", "score", "events", "digest" );
+    for ( i = 1; i < argc; i++ )
+    {
+        const ReplayHeader *h = replayMap( argv[i] );
+
+        if ( !h )
+        {
+            return 1;
+        }
+        for ( n = 0; n < h->games; n++ )
+        {
+            const ReplayGame *g = REPLAY_GAMES( h ) + n;
+
+            if ( ( score >= 0 && g->score != score ) || ( bySeed && g->seed != seed ) ||
+                 ( gameIndex >= 0 && n != gameIndex ) )
+            {
+                continue;
+            }
+            printf( "%-16s %6lu  0x%08lX %-6s %-8s %7d %5u %6u  %08lX\n", argv[i], (unsigned long)n,
+                    (unsigned long)g->seed, g->level < 3 ? levelName[ g->level ] : "?",
+                    g->endless ? "endless" : "normal", g->mistake, g->score, g->events, (unsigned long)g->digest );
+            if ( gameIndex >= 0 && (uint64_t)g->firstEvent + g->events <= h->events )
+            {
+                printEvents( h, g );
+            }
+            shown++;
+        }
+    }
+    printf( "%d games\n", shown );
+    return 0;
+}
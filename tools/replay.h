@@ -0,0 +1,104 @@
+/*
+ * replay.h  (host tools)
+ *
+ * Layout of a replay file, written by "runner --record" and read by
+ * "runner --replay" and tools/replay.c.
+ *
+ * A replay file holds any number of recorded games. Each game is its seed
+ * and the button events the runner sent, timed in Timer_1 ticks from the
+ * start of the game. Played back with the same seed and timing, a game
+ * goes exactly the same way, which the digest of its PRESS and GAME frames
+ * confirms.
+ *
+ * The file is three tables of fixed-size little-endian records, with no
+ * padding inside them, so it can be mapped into memory and used in place:
+ *
+ *    ReplayHeader   at offset 0
+ *    ReplayGame     games of them, at sizeof( ReplayHeader )
+ *    ReplayEvent    events of them, after the games
+ *
+ * A game's events are events[ firstEvent ] to events[ firstEvent + events
+ * - 1 ], in time order. Tick 0 is when the game was started: the runner
+ * presses the start button one tick later.
+ */
+
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define REPLAY_MAGIC        0x59504C52                                          // "RLPY"
+#define REPLAY_VERSION      1
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t games;                                                             // Entries in the game table
+    uint32_t events;                                                            // Entries in the event table
+} ReplayHeader;
+
+typedef struct
+{
+    uint32_t seed;                                                              // From the game's TELEMETRY_SEED frame
+    uint32_t firstEvent;                                                        // Index of its first event
+    uint32_t digest;                                                            // CRC-32 of its PRESS and GAME frames
+    uint16_t events;                                                            // Number of events
+    uint16_t score;                                                             // Final score
+    uint8_t  level;                                                             // DIFFICULTY_xxx
+    uint8_t  endless;
+    int8_t   mistake;                                                           // Round with the wrong press, or -1
+    uint8_t  reserved;
+} ReplayGame;
+
+typedef struct
+{
+    uint32_t tick;                                                              // Timer_1 ticks since the start of the game
+    uint8_t  buttons;                                                           // REMOTE_S1/REMOTE_S2 held from then on
+    uint8_t  reserved[3];
+} ReplayEvent;
+
+typedef char ReplayGameSize[ sizeof( ReplayGame ) == 20 ? 1 : -1 ];             // Sizes are part of the format
+typedef char ReplayEventSize[ sizeof( ReplayEvent ) == 8 ? 1 : -1 ];
+
+#define REPLAY_GAMES( h )   ( (const ReplayGame *)( (h) + 1 ) )
+#define REPLAY_EVENTS( h )  ( (const ReplayEvent *)( REPLAY_GAMES( h ) + (h)->games ) )
+
+
+// Maps a replay file into memory, read-only, and checks that its tables
+// fit. Returns its header, or NULL after printing why not.
+static const ReplayHeader *replayMap( const char *name )
+{
+    const ReplayHeader *h;
+    struct stat st;
+    int fd = open( name, O_RDONLY );
+
+    if ( fd < 0 || fstat( fd, &st ) != 0 )
+    {
+        perror( name );
+        return NULL;
+    }
+    h = ( st.st_size >= (off_t)sizeof( *h ) ) ? mmap( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 ) : MAP_FAILED;
+    close( fd );
+    if ( h == MAP_FAILED || h->magic != REPLAY_MAGIC || h->version != REPLAY_VERSION )
+    {
+        fprintf( stderr, "%s: not a replay file\n", name );
+        return NULL;
+    }
+    if ( (uint64_t)st.st_size < sizeof( *h ) + (uint64_t)h->games * sizeof( ReplayGame ) +
+                                (uint64_t)h->events * sizeof( ReplayEvent ) )
+    {
+        fprintf( stderr, "%s: file is shorter than its %u games\n", name, h->games );
+        return NULL;
+    }
+    return h;
+}
+
+
+#endif /* REPLAY_H_ */
@@ -0,0 +1,765 @@
+// ----------------------------------------------------------------------------
+// runner.c  (host tool)
+//
+// Plays scripted games on the board through the remote control commands in
+// myRemote.h, and checks every final score. It can also record the games
+// it plays, and replay them.
+//
+//    cc -O2 -o runner tools/runner.c
+//    ./runner /dev/ttyACM1 [games] [seed]        (a LaunchPad)
+//    ./simboard --lockstep &                     (or the simulated board,
+//    ./runner /dev/pts/N [games] [seed]           see tools/sim/sim.c)
+//
+//    ./runner --record games.rpl PORT [games] [seed]
+//    ./runner --replay games.rpl PORT
+//
+//    ./simboard --pair &                         (a LINK build: two boards
+//    ./runner --race /dev/pts/A [games] [seed] &  racing each other, see
+//    ./runner --join /dev/pts/B [games] [seed]    myLink.c)
+//
+// The runner watches the LEDs the way a player does: it samples them every
+// other Timer_1 tick, learns the sequence from the blinks, and presses the
+// buttons back. Each game picks a level, normal or endless, and a round in
+// which to press one wrong button (or none, for a normal game that is won).
+// The expected score follows from that, and is compared with the score in
+// the game's TELEMETRY_GAME frame.
+//
+// Start it while the board scrolls "PRESS S1 OR S2": after a reset, or at
+// the end of the runner's previous run. Against the simulated board in
+// lockstep mode, runs are repeatable and as fast as the PC allows.
+//
+// A recording (see replay.h) keeps each game's seed, from its
+// TELEMETRY_SEED frame, and every button event, timed in ticks from the
+// start of the game. Recorded games start from the idle start screen, once
+// "PRESS S1 OR S2" has scrolled by. A replay sends the seed with
+// REMOTE_SEED, queues the events at their ticks, and compares the score
+// and a CRC of the game's PRESS and GAME frames with the recording. The
+// board's command queue times the events to the tick, so a replay is exact
+// as long as the runner keeps the queue from running dry: always on the
+// simulated board in lockstep mode, and on a LaunchPad unless the PC
+// stalls.
+//
+// With --race the runner starts each game as usual, once the LCD has been
+// still for a few seconds so the other board is back at its start screen,
+// and the board invites the other one to race. With --join it presses
+// nothing to start: it waits for the other board's invitation, and plays
+// the game it is given, with a mistake in one of the first 16 rounds. Both
+// check that the game was a race, and print its TELEMETRY_RACE frame.
+// ----------------------------------------------------------------------------
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include "lcd.h"
+#include "replay.h"
+
+#define FRAME_MAX       256
+#define QUEUE           16                                                      // REMOTE_QUEUE on the board
+#define PIPELINE        8                                                       // LED samples in flight
+#define SAMPLE_TICKS    2                                                       // Ticks between LED samples
+#define STEPS_MAX       64
+#define RACE_TICKS      400                                                     // Time for the other board to get to its
+                                                                                //  start screen (about 5s)
+#define TIMEOUT_MS      30000                                                   // The board has stopped answering (the
+                                                                                //  longest wait is about 12s)
+
+// Keep in step with myRemote.h and myTelemetry.h
+enum { REMOTE_STATE, REMOTE_LCD, REMOTE_BUTTONS, REMOTE_WAIT, REMOTE_SEED, REMOTE_STATS };
+enum { S1 = 0x01, S2 = 0x02 };
+enum { T_HELLO, T_GAME, T_PRESS, T_TRACE, T_COUNTER, T_STATE, T_LCD, T_SEED, T_BENCH, T_PROFILE, T_ISR, T_RACE };
+enum { COUNTER_STACK_USED = 4, COUNTER_STACK_SIZE };
+enum { EASY, NORMAL, HARD };
+enum { SOLO, RACE, JOIN };                                                      // --race, --join
+
+static const char *levelName[] = { "EASY", "NORMAL", "HARD" };
+static const char *raceName[]  = { "no race", "won", "lost", "tied" };           // LINK_xxx in myLink.h
+static const int   levelButtons[] = { S1, S1 | S2, S2 };                        // As GetDifficultyLevel() reads them
+
+static int      port;
+static uint32_t random32 = 1;
+
+static unsigned int sent = 0;                                                   // Timed commands sent
+static unsigned int done = 0;                                                   // Timed commands known to have run
+static unsigned int waitAt[ QUEUE ];                                            // Command number of each WAIT in flight
+static unsigned int waits = 0;
+static uint32_t hostTick = 0;                                                   // Ticks of all the timed commands sent
+
+static uint8_t  lcd[ LCD_MEM_BYTES ];
+static int      lcdFresh = 0;
+static int      gameScore = -1;                                                 // From the last TELEMETRY_GAME frame
+static uint32_t gameSeed;                                                       // From the last TELEMETRY_SEED frame
+static uint32_t digest;                                                         // CRC of the game's PRESS and GAME frames
+static long     stackUsed = -1, stackSize = -1;                                 // From the COUNTER_STACK_xxx frames
+static int      mode = SOLO;
+static int      raceResult = -1;                                                // From the last TELEMETRY_RACE frame
+static char     raceText[ 128 ];
+
+static FILE        *recordFile = NULL;                                          // Recording, kept in memory until the end
+static ReplayGame  *recGames = NULL;
+static ReplayEvent *recEvents = NULL;
+static uint32_t     recGameCount = 0, recEventCount = 0;
+static int          recording = 0;                                              // Recording this game's events
+static uint32_t     origin;                                                     // hostTick at the start of the game
+
+
+static uint32_t nextRandom( void )                                              // xorshift32
+{
+    random32 ^= random32 << 13;
+    random32 ^= random32 >> 17;
+    random32 ^= random32 << 5;
+    return random32;
+}
+
+static uint32_t crc32( uint32_t crc, const uint8_t *data, int length )         // As in zlib
+{
+    int k;
+
+    crc = ~crc;
+    while ( length-- > 0 )
+    {
+        crc ^= *data++;
+        for ( k = 0; k < 8; k++ )
+        {
+            crc = ( crc >> 1 ) ^ ( 0xEDB88320 & -( crc & 1 ) );
+        }
+    }
+    return ~crc;
+}
+
+//*****************************************************************************
+// Frames
+//*****************************************************************************
+static void sendFrame( const uint8_t *data, int length )
+{
+    uint8_t out[ FRAME_MAX ];
+    int     code = 0, n = 1, k;
+
+    for ( k = 0; k < length; k++ )                                              // COBS, as in myUart.c
+    {
+        if ( data[k] == 0 )
+        {
+            out[ code ] = (uint8_t)( n - code );
+            code = n++;
+        }
+        else
+        {
+            out[ n++ ] = data[k];
+        }
+    }
+    out[ code ] = (uint8_t)( n - code );
+    out[ n++ ]  = 0;
+    if ( write( port, out, n ) != n )
+    {
+        perror( "write" );
+        exit( 1 );
+    }
+}
+
+// Decodes a COBS frame (without its 0x00) in place. Returns the decoded
+// length, or -1 if the frame is malformed.
+static int cobsDecode( uint8_t *buf, int length )
+{
+    int in = 0, out = 0;
+
+    while ( in < length )
+    {
+        int code = buf[in++];
+        int k;
+
+        if ( code == 0 || in + code - 1 > length )
+        {
+            return -1;
+        }
+        for ( k = 1; k < code; k++ )
+        {
+            buf[out++] = buf[in++];
+        }
+        if ( code < 0xFF && in < length )
+        {
+            buf[out++] = 0;
+        }
+    }
+    return out;
+}
+
+// Reads the next frame from the board and notes what it says. Returns the
+// frame type, and the LED bits in *leds for a TELEMETRY_STATE frame.
+static int readFrame( int *leds )
+{
+    static uint8_t buf[ 256 ];
+    static int     have = 0, next = 0;
+    uint8_t frame[ FRAME_MAX ];
+    int     length = 0;
+
+    for ( ;; )
+    {
+        struct pollfd p = { port, POLLIN, 0 };
+        uint8_t byte;
+
+        if ( next == have )
+        {
+            if ( poll( &p, 1, TIMEOUT_MS ) <= 0 || ( have = read( port, buf, sizeof( buf ) ) ) <= 0 )
+            {
+                fprintf( stderr, "the board stopped answering\n" );
+                exit( 1 );
+            }
+            next = 0;
+        }
+        byte = buf[ next++ ];
+        if ( byte != 0 )
+        {
+            if ( length < FRAME_MAX )
+            {
+                frame[ length++ ] = byte;
+            }
+            continue;
+        }
+        if ( ( length = cobsDecode( frame, length ) ) < 2 )                     // Not a whole frame: start again
+        {
+            length = 0;
+            continue;
+        }
+
+        switch ( frame[0] )
+        {
+        case T_STATE:
+            *leds = frame[2];
+            break;
+        case T_PRESS:                                                           // Round, reaction time, right
+            digest = crc32( digest, &frame[2], 5 );
+            break;
+        case T_SEED:
+            gameSeed = frame[2] | ( frame[3] << 8 ) | ( (uint32_t)frame[4] << 16 ) | ( (uint32_t)frame[5] << 24 );
+            break;
+        case T_LCD:
+            memcpy( lcd, &frame[2], length - 2 < (int)sizeof( lcd ) ? length - 2 : (int)sizeof( lcd ) );
+            lcdFresh = 1;
+            break;
+        case T_COUNTER:
+            if ( frame[2] == COUNTER_STACK_USED || frame[2] == COUNTER_STACK_SIZE )
+            {
+                *( frame[2] == COUNTER_STACK_USED ? &stackUsed : &stackSize ) =
+                    frame[3] | ( frame[4] << 8 ) | ( (long)frame[5] << 16 ) | ( (long)frame[6] << 24 );
+            }
+            break;
+        case T_RACE:                                                            // Sent before the game's GAME frame
+            raceResult = frame[2];
+            snprintf( raceText, sizeof( raceText ),
+                      "race: %s, %lu to %lu presses, margin %.1f ms, offset %.1f ms, round trip %.2f ms",
+                      frame[2] < 4 ? raceName[ frame[2] ] : "?",
+                      (unsigned long)( frame[3] | ( frame[4] << 8 ) | ( (uint32_t)frame[5] << 16 ) |
+                                       ( (uint32_t)frame[6] << 24 ) ),
+                      (unsigned long)( frame[7] | ( frame[8] << 8 ) | ( (uint32_t)frame[9] << 16 ) |
+                                       ( (uint32_t)frame[10] << 24 ) ),
+                      1000.0 * (int32_t)( frame[11] | ( frame[12] << 8 ) | ( (uint32_t)frame[13] << 16 ) |
+                                          ( (uint32_t)frame[14] << 24 ) ) / 32768,
+                      1000.0 * (int32_t)( frame[15] | ( frame[16] << 8 ) | ( (uint32_t)frame[17] << 16 ) |
+                                          ( (uint32_t)frame[18] << 24 ) ) / 32768,
+                      1000.0 * ( frame[19] | ( frame[20] << 8 ) ) / 32768 );
+            break;
+        case T_GAME:                                                            // Score, level, endless: not the place,
+            digest    = crc32( digest, &frame[2], 4 );                          //  which depends on the high scores
+            gameScore = frame[2] | ( frame[3] << 8 );
+            break;
+        }
+        return frame[0];
+    }
+}
+
+//*****************************************************************************
+// Commands
+//*****************************************************************************
+
+// Waits for the reply to the oldest WAIT in flight, and returns the LEDs.
+static int reply( void )
+{
+    int leds = 0;
+
+    while ( readFrame( &leds ) != T_STATE );
+    done = waitAt[0] + 1;
+    memmove( waitAt, waitAt + 1, --waits * sizeof( waitAt[0] ) );
+    return leds;
+}
+
+static void queue( uint8_t command, int buttons, unsigned int ticks )
+{
+    uint8_t frame[4];
+    int     length = 0;
+
+    frame[ length++ ] = command;
+    if ( command == REMOTE_BUTTONS )
+    {
+        frame[ length++ ] = (uint8_t)buttons;
+    }
+    frame[ length++ ] = (uint8_t)ticks;
+    frame[ length++ ] = (uint8_t)( ticks >> 8 );
+    sendFrame( frame, length );
+
+    if ( command == REMOTE_WAIT )
+    {
+        waitAt[ waits++ ] = sent;
+    }
+    sent++;
+    hostTick += ticks;
+}
+
+// Waits until 'slots' more timed commands fit in the board's queue. This
+// needs a WAIT in flight to say how far the board has got.
+static void makeRoom( unsigned int slots )
+{
+    while ( sent - done > QUEUE - slots )
+    {
+        if ( !waits )
+        {
+            fprintf( stderr, "the board's queue is full of button events\n" );
+            exit( 1 );
+        }
+        reply();
+    }
+}
+
+// Sends a timed command. The runner never uses 0 ticks: that would run in
+// the same tick as the command before it only if it reached the board while
+// that one was still queued, so lockstep runs would depend on the PC.
+static void timed( uint8_t command, int buttons, unsigned int ticks )
+{
+    if ( sent - done >= QUEUE - 1 )                                             // The board's queue is nearly full:
+    {                                                                           //  let it catch up, through a WAIT
+        if ( !waits || waitAt[ waits - 1 ] != sent - 1 )                        //  in the slot kept for it
+        {
+            queue( REMOTE_WAIT, 0, 1 );
+        }
+        while ( sent - done >= QUEUE - 1 )
+        {
+            reply();
+        }
+    }
+    queue( command, buttons, ticks );
+}
+
+static void press( int buttons, unsigned int ticks )                           // Hold 'buttons' from 'ticks' from now
+{
+    timed( REMOTE_BUTTONS, buttons, ticks );
+
+    if ( recording )
+    {
+        if ( ( recEventCount & 1023 ) == 0 )
+        {
+            recEvents = realloc( recEvents, ( recEventCount + 1024 ) * sizeof( *recEvents ) );
+        }
+        memset( &recEvents[ recEventCount ], 0, sizeof( *recEvents ) );
+        recEvents[ recEventCount ].tick    = hostTick - origin;
+        recEvents[ recEventCount ].buttons = (uint8_t)buttons;
+        recEventCount++;
+    }
+}
+
+// Holds 'buttons' from 'tick' ticks after the start of the game. Each event
+// with a gap before it gets a WAIT too, whose reply keeps the queue fed.
+static void pressAt( uint32_t tick, int buttons )
+{
+    uint32_t gap = origin + tick - hostTick;
+
+    if ( gap < 1 || gap > 0x10000 )
+    {
+        fprintf( stderr, "replay event at tick %lu is out of order\n", (unsigned long)tick );
+        exit( 1 );
+    }
+    if ( gap > 1 )
+    {
+        makeRoom( 2 );
+        queue( REMOTE_WAIT, 0, gap - 1 );
+    }
+    makeRoom( 1 );
+    queue( REMOTE_BUTTONS, buttons, 1 );
+}
+
+static void settle( unsigned int ticks )                                        // Waits until everything queued has run
+{
+    timed( REMOTE_WAIT, 0, ticks );
+    while ( waits )
+    {
+        reply();
+    }
+}
+
+static int sample( void )                                                       // The LEDs, SAMPLE_TICKS after the last sample
+{
+    while ( waits < PIPELINE )
+    {
+        timed( REMOTE_WAIT, 0, SAMPLE_TICKS );
+    }
+    return reply();
+}
+
+//*****************************************************************************
+// The LCD
+//*****************************************************************************
+static void lcdRead( void )
+{
+    uint8_t wanted = REMOTE_LCD;
+    int     leds;
+
+    lcdFresh = 0;
+    sendFrame( &wanted, 1 );
+    while ( !lcdFresh )
+    {
+        readFrame( &leds );
+    }
+}
+
+static void lcdText( char text[7] )
+{
+    LcdText decoded;
+
+    lcdRead();
+    lcdDecode( lcd, &decoded );
+    memcpy( text, decoded.text, sizeof( decoded.text ) );
+}
+
+static void waitForStill( void )                                                // Until the LCD stays the same for 50 ticks
+{
+    uint8_t before[ sizeof( lcd ) ];
+
+    lcdRead();
+    do
+    {
+        memcpy( before, lcd, sizeof( lcd ) );
+        settle( 50 );
+        lcdRead();
+    } while ( memcmp( before, lcd, sizeof( lcd ) ) != 0 );
+}
+
+// Waits for the game over messages to finish (they scroll every 200ms, then
+// the LCD stays the same), and presses both buttons to start a new game.
+static void endGame( void )
+{
+    waitForStill();
+    press( S1 | S2, 1 );
+    press( 0, 5 );
+    settle( 1 );
+}
+
+//*****************************************************************************
+// A game
+//*****************************************************************************
+
+// Plays one game. 'mistake' is the round with the wrong press, or -1.
+// Returns 1 if the board's score was the expected one (and, racing, if
+// there was a race). Joining, 'level' and 'endless' are the other board's.
+static int play( int level, int endless, int mistake )
+{
+    uint8_t steps[ STEPS_MAX ];
+    int     known = 0;                                                          // Steps seen so far
+    int     expected = ( mistake < 0 ) ? 16 : mistake;
+    int     round, k, leds, last, shown, wrong;
+    char    text[7];
+
+    if ( recordFile )                                                           // A recorded game starts at a known
+    {                                                                           //  point: the idle start screen
+        waitForStill();
+        origin    = hostTick;
+        digest    = 0;
+        recording = 1;
+    }
+    gameScore  = -1;
+    raceResult = -1;
+
+    if ( mode == RACE )
+    {
+        waitForStill();
+        settle( RACE_TICKS );
+    }
+    if ( mode != JOIN )
+    {
+        press( endless ? S2 : S1, 1 );                                          // Hold the start button until the
+        do                                                                      //  level menu is up
+        {
+            settle( 10 );
+            lcdText( text );
+        } while ( strcmp( text, "LEVEL " ) != 0 );
+        press( 0, 1 );
+        press( levelButtons[ level ], 5 );                                      // Less than a second: not adaptive
+        press( 0, 20 );
+        settle( 1 );
+    }
+
+    for ( round = 0; gameScore < 0; round++ )
+    {
+        last  = -1;                                                             // Wait for the LEDs to go off, then
+        shown = 0;                                                              //  count the blinks
+        while ( shown <= round && gameScore < 0 )
+        {
+            leds = sample();
+            if ( last == 0 && leds != 0 )
+            {
+                if ( shown < known && steps[ shown ] != leds )
+                {
+                    fprintf( stderr, "round %d: step %d changed\n", round + 1, shown + 1 );
+                }
+                if ( shown < STEPS_MAX )
+                {
+                    steps[ shown ] = leds;
+                }
+                shown++;
+            }
+            last = ( last < 0 && leds != 0 ) ? -1 : leds;
+        }
+        while ( last != 0 && gameScore < 0 )                                    // The end of the last blink
+        {
+            last = sample();
+        }
+        known = shown;
+        while ( waits )
+        {
+            reply();
+        }
+        if ( gameScore >= 0 )                                                   // The game ended on its own
+        {
+            break;
+        }
+
+        wrong = ( round == mistake ) ? (int)( nextRandom() % ( round + 1 ) ) : -1;
+        for ( k = 0; k <= round && k < STEPS_MAX; k++ )                         // Press the sequence back, up to the
+        {                                                                       //  wrong button in the mistake round
+            press( ( k == wrong ) ? steps[k] ^ ( S1 | S2 ) : steps[k], 4 );
+            press( 0, 4 );                                                      // Longer than the 30ms debounce
+            if ( k == wrong )
+            {
+                break;
+            }
+        }
+        settle( 6 );
+
+        if ( round == mistake || ( !endless && round == 15 ) )
+        {
+            while ( gameScore < 0 )
+            {
+                settle( 10 );
+            }
+        }
+    }
+
+
+    if ( recording )
+    {
+        ReplayGame *g;
+
+        recording = 0;
+        if ( ( recGameCount & 255 ) == 0 )
+        {
+            recGames = realloc( recGames, ( recGameCount + 256 ) * sizeof( *recGames ) );
+        }
+        g = &recGames[ recGameCount++ ];
+        memset( g, 0, sizeof( *g ) );
+        g->seed       = gameSeed;
+        g->digest     = digest;
+        g->score      = (uint16_t)gameScore;
+        g->level      = (uint8_t)level;
+        g->endless    = (uint8_t)endless;
+        g->mistake    = (int8_t)mistake;
+        g->firstEvent = ( recGameCount > 1 ) ? g[-1].firstEvent + g[-1].events : 0;
+        g->events     = (uint16_t)( recEventCount - g->firstEvent );
+    }
+    endGame();
+
+    if ( mode == SOLO )
+    {
+        printf( "%-6s %-8s mistake %3d: score %3d %s\n", levelName[ level ], endless ? "endless" : "normal",
+                mistake, gameScore, gameScore == expected ? "ok" : "WRONG" );
+        fflush( stdout );
+        return gameScore == expected;
+    }
+    printf( "%-6s %-8s mistake %3d: score %3d %s, %s\n", mode == JOIN ? "joined" : levelName[ level ],
+            mode == JOIN ? "" : endless ? "endless" : "normal", mistake, gameScore,
+            gameScore == expected && raceResult > 0 ? "ok" : "WRONG", raceResult >= 0 ? raceText : "no RACE frame" );
+    fflush( stdout );
+    return gameScore == expected && raceResult > 0;
+}
+
+// Plays a recorded game again. Returns 1 if the score and the digest of
+// its frames were the recorded ones.
+static int replay( const ReplayGame *g, const ReplayEvent *events )
+{
+    uint8_t frame[5];
+    int     k;
+
+    waitForStill();
+    origin    = hostTick;
+    digest    = 0;
+    gameScore = -1;
+
+    frame[0] = REMOTE_SEED;                                                     // Used by the next game to start
+    frame[1] = (uint8_t)g->seed;
+    frame[2] = (uint8_t)( g->seed >> 8 );
+    frame[3] = (uint8_t)( g->seed >> 16 );
+    frame[4] = (uint8_t)( g->seed >> 24 );
+    sendFrame( frame, sizeof( frame ) );
+
+    for ( k = 0; k < g->events; k++ )
+    {
+        pressAt( events[k].tick, events[k].buttons );
+    }
+    while ( gameScore < 0 )
+    {
+        settle( 10 );
+    }
+    endGame();
+
+    printf( "seed 0x%08lX %-6s %-8s: score %3d %s\n", (unsigned long)g->seed,
+            g->level < 3 ? levelName[ g->level ] : "?", g->endless ? "endless" : "normal", gameScore,
+            ( gameScore == g->score && digest == g->digest ) ? "same" : "DIFFERENT" );
+    fflush( stdout );
+    return gameScore == g->score && digest == g->digest;
+}
+
+// Asks for the stack counters (REMOTE_STATS) and prints how much of the
+// stack the games have used.
+static void printStack( void )
+{
+    uint8_t command = REMOTE_STATS;
+    int     leds;
+
+    stackSize = -1;
+    sendFrame( &command, 1 );
+    while ( stackSize < 0 )                                                     // Sent after COUNTER_STACK_USED
+    {
+        readFrame( &leds );
+    }
+    printf( "stack: %ld of %ld bytes used\n", stackUsed, stackSize );
+}
+
+static void saveRecording( const char *name )
+{
+    ReplayHeader h;
+
+    memset( &h, 0, sizeof( h ) );
+    h.magic   = REPLAY_MAGIC;
+    h.version = REPLAY_VERSION;
+    h.games   = recGameCount;
+    h.events  = recEventCount;
+    if ( fwrite( &h, sizeof( h ), 1, recordFile ) != 1 ||
+         fwrite( recGames, sizeof( *recGames ), recGameCount, recordFile ) != recGameCount ||
+         fwrite( recEvents, sizeof( *recEvents ), recEventCount, recordFile ) != recEventCount ||
+         fclose( recordFile ) != 0 )
+    {
+        perror( name );
+        exit( 1 );
+    }
+    printf( "%lu games, %lu events recorded in %s\n", (unsigned long)recGameCount, (unsigned long)recEventCount, name );
+}
+
+static int openPort( const char *name )
+{
+    struct termios tio;
+    int fd = open( name, O_RDWR | O_NOCTTY );
+
+    if ( fd < 0 )
+    {
+        perror( name );
+        exit( 1 );
+    }
+    if ( tcgetattr( fd, &tio ) == 0 )                                           // Raw 8N1 at 115200 baud
+    {
+        cfmakeraw( &tio );
+        cfsetispeed( &tio, B115200 );
+        cfsetospeed( &tio, B115200 );
+        tcsetattr( fd, TCSANOW, &tio );
+    }
+    return fd;
+}
+
+int main( int argc, char *argv[] )
+{
+    const char *recordName = NULL, *replayName = NULL;
+    int games = 10, passed = 0, game;
+
+    while ( argc > 2 && ( strcmp( argv[1], "--race" ) == 0 || strcmp( argv[1], "--join" ) == 0 ) )
+    {
+        mode = strcmp( argv[1], "--race" ) == 0 ? RACE : JOIN;
+        argc--;
+        argv++;
+    }
+    while ( argc > 2 && ( strcmp( argv[1], "--record" ) == 0 || strcmp( argv[1], "--replay" ) == 0 ) )
+    {
+        if ( strcmp( argv[1], "--record" ) == 0 )
+        {
+            recordName = argv[2];
+        }
+        else
+        {
+            replayName = argv[2];
+        }
+        argc -= 2;
+        argv += 2;
+    }
+    if ( argc < 2 || argc > 4 || ( recordName && replayName ) || ( replayName && argc > 2 ) ||
+         ( mode != SOLO && ( recordName || replayName ) ) )
+    {
+        fprintf( stderr, "usage: %s [--record FILE] /dev/ttyXXX [games] [seed]\n"
+                         "       %s --replay FILE /dev/ttyXXX\n"
+                         "       %s --race|--join /dev/ttyXXX [games] [seed]\n", argv[0], argv[0], argv[0] );
+        return 2;
+    }
+
+    if ( replayName )
+    {
+        const ReplayHeader *h = replayMap( replayName );
+        const ReplayGame   *g;
+
+        if ( !h )
+        {
+            return 1;
+        }
+        port = openPort( argv[1] );
+        for ( g = REPLAY_GAMES( h ); g < REPLAY_GAMES( h ) + h->games; g++ )
+        {
+            if ( (uint64_t)g->firstEvent + g->events > h->events )
+            {
+                fprintf( stderr, "%s: game %d has events past the end\n", replayName, (int)( g - REPLAY_GAMES( h ) ) );
+                return 1;
+            }
+            passed += replay( g, REPLAY_EVENTS( h ) + g->firstEvent );
+        }
+        printStack();
+        printf( "%d of %lu games replayed the same\n", passed, (unsigned long)h->games );
+        return passed == (int)h->games ? 0 : 1;
+    }
+    if ( recordName && !( recordFile = fopen( recordName, "wb" ) ) )
+    {
+        perror( recordName );
+        return 1;
+    }
+
+    port     = openPort( argv[1] );
+    games    = ( argc > 2 ) ? atoi( argv[2] ) : games;
+    random32 = ( argc > 3 ) ? (uint32_t)strtoul( argv[3], NULL, 0 ) : (uint32_t)time( NULL );
+    random32 = random32 ? random32 : 1;
+
+    for ( game = 0; game < games; game++ )
+    {
+        int level   = nextRandom() % 3;
+        int endless = ( nextRandom() % 4 ) == 0;
+        int mistake = endless ? (int)( nextRandom() % 20 ) : (int)( nextRandom() % 17 );
+
+        if ( mode == JOIN )                                                     // Ends in 16 rounds, endless or not
+        {
+            mistake = (int)( nextRandom() % 16 );
+        }
+        passed += play( level, endless, ( !endless && mistake == 16 ) ? -1 : mistake );   // Round 16: a win
+    }
+    printStack();
+    printf( "%d of %d games scored as expected\n", passed, games );
+    if ( recordFile )
+    {
+        saveRecording( recordName );
+    }
+    return passed == games ? 0 : 1;
+}
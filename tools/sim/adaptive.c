@@ -0,0 +1,191 @@
+// ----------------------------------------------------------------------------
+// adaptive.c  (simulated board)
+//
+// Plays the adaptive mode's controller (myAdaptive.c) against a population
+// of simulated players, to check that it settles each of them near the
+// target success rate:
+//
+//    ./simboard --adaptive
+//
+// Each player plays PLAYER_GAMES normal games in a row on every level, with
+// the board's own tempo table and controller. A player gets each step of a
+// sequence wrong with a chance that grows as the LEDs get faster: LAPSE,
+// plus 10% when the LED is on and off for a total of the player's "pace"
+// ticks, rising with the square of how much faster than that it goes. Each
+// press takes the player's reaction time, give or take half, and a press
+// slower than the level's timeout is a timeout. Paces are spread evenly
+// between PACE_MIN and PACE_MAX ticks and reaction times between
+// REACT_MIN and REACT_MAX, so players reach both ends of the controller's
+// range, and the players' dice come from Random_at(), so every run is the
+// same.
+//
+// For each level it prints, over the last SETTLED_GAMES games of each
+// player, how many players got between 80% and 97% of their presses right,
+// the median success rate, how many ended up at the fastest or slowest
+// playback, and how far the controller output still moved from one game
+// to the next. It exits with 1 if fewer than SETTLED_SHARE of the players
+// that the controller can reach settled in that band on any level.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../../myAdaptive.h"
+#include "../../myDifficulty.h"
+#include "../../myGame.h"
+#include "../../myRandom.h"
+
+#define PLAYERS             1000
+#define PLAYER_GAMES        300
+#define SETTLED_GAMES       100                                                 // Last games of each player that are scored
+#define PACE_MIN            10                                                  // On + off ticks of a player's 10% mistakes
+#define PACE_MAX            110
+#define REACT_MIN           20                                                  // Mean reaction time, ticks
+#define REACT_MAX           120
+#define LAPSE               0.01                                                // Mistakes at any tempo
+#define BAND_LOW            0.80
+#define BAND_HIGH           0.97
+#define SETTLED_SHARE       0.95
+#define CHANCE( u )         ( (double)( u ) / 4294967296.0 )                    // A Random_at() output as [0, 1)
+
+typedef struct
+{
+    double         pace;                                                        // On + off ticks with 10% mistakes
+    double         react;                                                       // Mean reaction time, ticks
+    uint32_t       seed, dice;                                                  // Random_at() seed and counter
+} Player;
+
+typedef struct
+{
+    double         success;                                                     // Share of presses right
+    double         scale;                                                       // Mean controller output
+    double         drift;                                                       // Mean change of it from game to game
+    int            pinned;                                                      // -1 at the fastest, 1 at the slowest
+} Settled;
+
+
+static double roll( Player *p )
+{
+    return CHANCE( Random_at( p->seed, p->dice++ ) );
+}
+
+//*****************************************************************************
+// playGame()
+//
+// Plays one normal game, press by press, and counts the presses and the
+// right ones. Returns when the player makes a mistake or wins.
+//*****************************************************************************
+static void playGame( Player *p, unsigned int level, unsigned long *presses, unsigned long *right )
+{
+    const Tempo *tempo;
+    unsigned int round, step;
+    double       shown, wrong, react;
+    uint16_t     ticks;
+    int          correct;
+
+    for ( round = 0; round < GAME_ROUNDS; round++ )
+    {
+        tempo = Difficulty_tempo( level, round );
+        shown = Adaptive_ticks( tempo->onTicks ) + Adaptive_ticks( tempo->offTicks );
+        wrong = LAPSE + 0.1 * ( p->pace / shown ) * ( p->pace / shown );
+        wrong = wrong > 0.95 ? 0.95 : wrong;
+        for ( step = 0; step <= round; step++ )
+        {
+            react   = p->react * ( 0.5 + roll( p ) );
+            correct = roll( p ) >= wrong && react < tempo->timeoutTicks;
+            ticks   = react < tempo->timeoutTicks ? (uint16_t)react : tempo->timeoutTicks;
+            Adaptive_press( ticks, correct );
+            *presses += 1;
+            *right   += correct;
+            if ( !correct )
+            {
+                return;
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+// playPlayer()
+//
+// Plays all of one player's games on a level, from a fresh controller, and
+// sums up the last SETTLED_GAMES of them.
+//*****************************************************************************
+static void playPlayer( Player *p, unsigned int level, Settled *s )
+{
+    unsigned long presses = 0, right = 0;
+    unsigned int  g;
+    uint16_t      timeout = Difficulty_tempo( level, 0 )->timeoutTicks;
+    double        scale, last = 0, sum = 0, drift = 0;
+
+    Adaptive_start( 1, ( level + 1 ) % DIFFICULTY_LEVELS, timeout );            // Another level first, for a fresh controller
+    for ( g = 0; g < PLAYER_GAMES; g++ )
+    {
+        Adaptive_start( 1, level, timeout );
+        scale = Adaptive_ticks( ADAPTIVE_ONE );                                 // The controller output itself
+        if ( g == PLAYER_GAMES - SETTLED_GAMES )
+        {
+            presses = right = 0;
+        }
+        if ( g >= PLAYER_GAMES - SETTLED_GAMES )
+        {
+            sum   += scale;
+            drift += g > PLAYER_GAMES - SETTLED_GAMES ? abs( (int)( scale - last ) ) : 0;
+        }
+        last = scale;
+        playGame( p, level, &presses, &right );
+    }
+    s->success = (double)right / presses;
+    s->scale   = sum / SETTLED_GAMES;
+    s->drift   = drift / ( SETTLED_GAMES - 1 );
+    s->pinned  = s->scale < ADAPTIVE_SCALE_MIN + 4 ? -1 : s->scale > ADAPTIVE_SCALE_MAX - 4 ? 1 : 0;
+}
+
+static int bySuccess( const void *a, const void *b )
+{
+    double x = ( (const Settled *)a )->success, y = ( (const Settled *)b )->success;
+
+    return x < y ? -1 : x > y;
+}
+
+int simAdaptive( void )
+{
+    static Settled settled[ PLAYERS ];
+    Player         player;
+    unsigned int   level, k, band, reached, fast, slow;
+    double         drift;
+    int            ok = 1;
+
+    printf( "adaptive: %u players, %u games each, scored over the last %u\n",
+            PLAYERS, PLAYER_GAMES, SETTLED_GAMES );
+    for ( level = 0; level < DIFFICULTY_LEVELS; level++ )
+    {
+        band = reached = fast = slow = 0;
+        drift = 0;
+        for ( k = 0; k < PLAYERS; k++ )
+        {
+            player.pace  = PACE_MIN + ( PACE_MAX - PACE_MIN ) * ( k + 0.5 ) / PLAYERS;
+            player.seed  = Random_at( 0x5EED, k );
+            player.dice  = 0;
+            player.react = REACT_MIN + ( REACT_MAX - REACT_MIN ) * CHANCE( Random_at( player.seed, 0xFFFFFFFFUL ) );
+            playPlayer( &player, level, &settled[k] );
+
+            fast  += settled[k].pinned < 0;
+            slow  += settled[k].pinned > 0;
+            drift += settled[k].drift;
+            if ( !settled[k].pinned )
+            {
+                reached++;
+                band += settled[k].success >= BAND_LOW && settled[k].success <= BAND_HIGH;
+            }
+        }
+        qsort( settled, PLAYERS, sizeof( Settled ), bySuccess );
+        printf( "%-7s %4u of %4u players in reach settled at %2.0f%% to %2.0f%% right, median %4.1f%%,"
+                " %3u at the fastest, %3u at the slowest, output moves %.1f/256 a game\n",
+                difficultyName[ level ], band, reached, BAND_LOW * 100, BAND_HIGH * 100,
+                settled[ PLAYERS / 2 ].success * 100, fast, slow, drift / PLAYERS );
+        ok &= band >= SETTLED_SHARE * reached;
+    }
+    printf( "adaptive: %s\n", ok ? "settled" : "FAILED" );
+
+    return ok ? 0 : 1;
+}
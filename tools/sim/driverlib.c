@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// driverlib.c  (simulated board)
+//
+// Host versions of the DriverLib calls the game makes. The clock calls
+// only keep track of the DCO and MCLK settings, for the energy model: the
+// simulation's time base stays at the rates initClocks() sets up (MCLK
+// 4MHz, SMCLK 2MHz, ACLK 32768Hz). LCD_C_setMemory() works like the real
+// one in 4-mux mode: segment pin n is a nibble of LCDM(n/2 + 1).
+// ----------------------------------------------------------------------------
+
+#include <string.h>
+#include "driverlib.h"
+
+int      simLcdOn  = 0;
+uint32_t simMclkHz = 1000000;                                                   // DCO at reset: 1MHz
+static uint32_t dcoHz    = 1000000;
+static uint32_t smclkHz  = 1000000;
+
+static const uint32_t dcoTable[2][8] =                                          // By DCORSEL, DCOFSEL (datasheet)
+{
+    { 1000000, 2670000, 3330000, 4000000, 5330000, 6670000, 8000000, 8000000 },
+    { 1000000, 5330000, 6670000, 8000000, 16000000, 21000000, 24000000, 24000000 }
+};
+
+
+void     CS_setExternalClockSource( uint32_t lf, uint32_t hf )   { (void)lf; (void)hf; }
+uint32_t CS_getACLK( void )                                      { return 32768; }
+uint32_t CS_getSMCLK( void )                                     { return smclkHz; }
+uint32_t CS_getMCLK( void )                                      { return simMclkHz; }
+bool     CS_turnOnLFXTWithTimeout( uint16_t d, uint32_t t )      { (void)d; (void)t; return STATUS_SUCCESS; }
+bool     CS_turnOnHFXTWithTimeout( uint16_t d, uint32_t t )      { (void)d; (void)t; return STATUS_SUCCESS; }
+
+void CS_setDCOFreq( uint16_t range, uint16_t freq )
+{
+    dcoHz = dcoTable[ ( range & CS_DCORSEL_1 ) != 0 ][ ( freq >> 1 ) & 7 ];
+}
+
+void CS_initClockSignal( uint8_t clock, uint16_t source, uint16_t divider )
+{
+    uint32_t hz = ( ( source == CS_DCOCLK_SELECT ) ? dcoHz : 32768 ) >> ( divider & 7 );
+
+    if ( clock == CS_MCLK )
+    {
+        simMclkHz = hz;
+    }
+    else if ( clock == CS_SMCLK )
+    {
+        smclkHz = hz;
+    }
+}
+
+void FRAMCtl_configureWaitStateControl( uint8_t waitState )
+{
+    (void)waitState;                                                            // Simulated code takes no time
+}
+
+void GPIO_setAsPeripheralModuleFunctionInputPin( uint8_t port, uint16_t pins, uint8_t mode )
+{
+    (void)port; (void)pins; (void)mode;
+}
+
+void LCD_C_init( uint16_t base, LCD_C_initParam *p )                            { (void)base; (void)p; }
+void LCD_C_on( uint16_t base )                                                  { (void)base; simLcdOn = 1; }
+void LCD_C_off( uint16_t base )                                                 { (void)base; simLcdOn = 0; }
+void LCD_C_setPinAsLCDFunctionEx( uint16_t base, uint8_t a, uint8_t b )         { (void)base; (void)a; (void)b; }
+void LCD_C_setVLCDSource( uint16_t base, uint16_t a, uint16_t b, uint16_t c )   { (void)base; (void)a; (void)b; (void)c; }
+void LCD_C_setVLCDVoltage( uint16_t base, uint16_t v )                          { (void)base; (void)v; }
+void LCD_C_enableChargePump( uint16_t base )                                    { (void)base; }
+void LCD_C_selectChargePumpReference( uint16_t base, uint16_t r )               { (void)base; (void)r; }
+void LCD_C_configChargePump( uint16_t base, uint16_t s, uint16_t m )            { (void)base; (void)s; (void)m; }
+void LCD_C_selectDisplayMemory( uint16_t base, uint16_t m )                     { (void)base; (void)m; }
+void LCD_C_setBlinkingControl( uint16_t base, uint8_t a, uint8_t b, uint8_t c ) { (void)base; (void)a; (void)b; (void)c; }
+
+void LCD_C_clearMemory( uint16_t base )
+{
+    (void)base;
+    memset( (void *)LCDMEM, 0, sizeof( LCDMEM ) );
+}
+
+void LCD_C_clearBlinkingMemory( uint16_t base )
+{
+    (void)base;
+    memset( (void *)LCDBMEM, 0, sizeof( LCDBMEM ) );
+}
+
+void LCD_C_setMemory( uint16_t base, uint8_t pin, uint8_t value )
+{
+    (void)base;
+    if ( pin & 1 )
+    {
+        LCDMEM[ pin / 2 ] = ( LCDMEM[ pin / 2 ] & 0x0F ) | ( ( value & 0x0F ) << 4 );
+    }
+    else
+    {
+        LCDMEM[ pin / 2 ] = ( LCDMEM[ pin / 2 ] & 0xF0 ) | ( value & 0x0F );
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * driverlib.h  (simulated board)
+ *
+ * The parts of TI's DriverLib the game calls, for the host build in
+ * tools/sim. The clock calls only note the MCLK rate and the GPIO calls do
+ * nothing; the LCD_C calls work on the simulated LCD memory. See
+ * driverlib.c.
+ */
+
+#ifndef SIM_DRIVERLIB_H_
+#define SIM_DRIVERLIB_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp430.h"
+
+#define STATUS_SUCCESS                                          0x01
+#define STATUS_FAIL                                             0x00
+
+//***** CS ********************************************************************
+#define CS_ACLK                                                 0x01
+#define CS_MCLK                                                 0x02
+#define CS_SMCLK                                                0x04
+#define CS_LFXTCLK_SELECT                                       0x0000
+#define CS_DCOCLK_SELECT                                        0x0003
+#define CS_CLOCK_DIVIDER_1                                      0x0000
+#define CS_CLOCK_DIVIDER_2                                      0x0001
+#define CS_CLOCK_DIVIDER_8                                      0x0003
+#define CS_DCORSEL_0                                            0x0000
+#define CS_DCORSEL_1                                            0x0040
+#define CS_DCOFSEL_3                                            0x0006
+#define CS_DCOFSEL_4                                            0x0008
+#define CS_LFXT_DRIVE_0                                         0x0000
+#define CS_HFXTDRIVE_4MHZ_8MHZ                                  0x0000
+
+void     CS_setExternalClockSource( uint32_t, uint32_t );
+uint32_t CS_getACLK( void );
+uint32_t CS_getSMCLK( void );
+uint32_t CS_getMCLK( void );
+bool     CS_turnOnLFXTWithTimeout( uint16_t, uint32_t );
+bool     CS_turnOnHFXTWithTimeout( uint16_t, uint32_t );
+void     CS_setDCOFreq( uint16_t, uint16_t );
+void     CS_initClockSignal( uint8_t, uint16_t, uint16_t );
+
+//***** FRAMCtl ***************************************************************
+#define FRAMCTL_ACCESS_TIME_CYCLES_1                            0x0010
+
+void     FRAMCtl_configureWaitStateControl( uint8_t );
+
+//***** GPIO ******************************************************************
+#define GPIO_PORT_PJ                                            13
+#define GPIO_PIN4                                               0x0010
+#define GPIO_PIN5                                               0x0020
+#define GPIO_PRIMARY_MODULE_FUNCTION                            0x01
+
+void GPIO_setAsPeripheralModuleFunctionInputPin( uint8_t, uint16_t, uint8_t );
+
+//***** LCD_C *****************************************************************
+#define LCD_C_BASE                                              0x0A00
+
+#define LCD_C_CLOCKSOURCE_ACLK                                  0x0000
+#define LCD_C_CLOCKDIVIDER_1                                    0x0000
+#define LCD_C_CLOCKPRESCALAR_16                                 0x0400
+#define LCD_C_STATIC                                            0x0000
+#define LCD_C_2_MUX                                             0x0008
+#define LCD_C_3_MUX                                             0x0010
+#define LCD_C_4_MUX                                             0x0018
+#define LCD_C_LOW_POWER_WAVEFORMS                               0x0020
+#define LCD_C_SEGMENTS_ENABLED                                  0x0080
+#define LCD_C_SEGMENT_LINE_0                                    0
+#define LCD_C_SEGMENT_LINE_21                                   21
+#define LCD_C_SEGMENT_LINE_26                                   26
+#define LCD_C_SEGMENT_LINE_43                                   43
+#define LCD_C_VLCD_GENERATED_INTERNALLY                         0x0000
+#define LCD_C_V2V3V4_GENERATED_INTERNALLY_NOT_SWITCHED_TO_PINS  0x0000
+#define LCD_C_V5_VSS                                            0x0000
+#define LCD_C_CHARGEPUMP_VOLTAGE_3_02V_OR_2_52VREF              0x1E00
+#define LCD_C_INTERNAL_REFERENCE_VOLTAGE                        0x0000
+#define LCD_C_SYNCHRONIZATION_ENABLED                           0x8000
+#define LCD_C_DISPLAYSOURCE_MEMORY                              0x0000
+#define LCD_C_DISPLAYSOURCE_BLINKINGMEMORY                      0x0008
+#define LCD_C_BLINK_MODE_DISABLED                               0x0000
+#define LCDBLKPRE1                                              0x0010
+#define LCDBLKPRE2                                              0x0020
+
+typedef struct LCD_C_initParam
+{
+    uint16_t clockSource;
+    uint16_t clockDivider;
+    uint16_t clockPrescalar;
+    uint16_t muxRate;
+    uint16_t waveforms;
+    uint16_t segments;
+} LCD_C_initParam;
+
+void LCD_C_init( uint16_t, LCD_C_initParam * );
+void LCD_C_on( uint16_t );
+void LCD_C_off( uint16_t );
+void LCD_C_setPinAsLCDFunctionEx( uint16_t, uint8_t, uint8_t );
+void LCD_C_setVLCDSource( uint16_t, uint16_t, uint16_t, uint16_t );
+void LCD_C_setVLCDVoltage( uint16_t, uint16_t );
+void LCD_C_enableChargePump( uint16_t );
+void LCD_C_selectChargePumpReference( uint16_t, uint16_t );
+void LCD_C_configChargePump( uint16_t, uint16_t, uint16_t );
+void LCD_C_clearMemory( uint16_t );
+void LCD_C_clearBlinkingMemory( uint16_t );
+void LCD_C_selectDisplayMemory( uint16_t, uint16_t );
+void LCD_C_setBlinkingControl( uint16_t, uint8_t, uint8_t, uint8_t );
+void LCD_C_setMemory( uint16_t, uint8_t, uint8_t );
+
+extern int      simLcdOn;                                                       // Set by LCD_C_on(), cleared by LCD_C_off()
+extern uint32_t simMclkHz;                                                      // MCLK as set up by the CS calls
+
+
+#endif /* SIM_DRIVERLIB_H_ */
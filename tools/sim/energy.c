@@ -0,0 +1,272 @@
+// ----------------------------------------------------------------------------
+// energy.c  (simulated board)
+//
+// Estimates the charge the board draws, from the time it spends in each
+// state: the CPU in active mode at its MCLK rate or in a low power mode,
+// the LCD on or off, and each LED on or off. sim.c reports every stretch of
+// time with simEnergy().
+//
+// The time is also split by what the game is doing, from the TRACE_PHASE
+// events in the firmware's trace log (see myTrace.h), and by game, from
+// TRACE_GAME_START to TRACE_GAME_OVER. With --energy the simulated board
+// prints a line per game and, when it exits, the totals and the battery
+// life they come to.
+//
+// sim.c also reports every interrupt taken while the CPU sleeps with
+// simWakeup(), and the phases show how often the board woke up in them.
+// Each wakeup costs the time its ISR runs for, which is already counted as
+// active time; the rate is there to see what keeps waking an idle board.
+//
+// The currents are typical figures at 3V and 25C, rounded from the
+// MSP430FR6989 datasheet; the LEDs are estimated for the LaunchPad's
+// resistors. They are a baseline for comparing changes, not a measurement:
+// check them against the datasheet revision and the board in use.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "msp430.h"
+#include "driverlib.h"
+#include "../../myTrace.h"
+
+#define MODES               8                                                   // Rows of the CPU table
+
+// Active mode, FRAM with about 75% cache hits, by MCLK
+static const struct { double mhz, ua; } activeUa[] =
+{
+    { 1, 170 }, { 4, 430 }, { 8, 780 }, { 16, 1500 }, { 24, 2200 }
+};
+#define LPM0_UA_PER_MHZ     17.0                                                // Plus LPM0_UA: clocks on, CPU off
+#define LPM0_UA             55.0
+#define LPM3_UA             0.9                                                 // LFXT on, no RTC
+#define LPM4_UA             0.5
+#define LCD_UA              3.0                                                 // LCD_C, 4-mux, charge pump, no glass
+#define RED_LED_UA          3000.0                                              // LED1 on P1.0
+#define GREEN_LED_UA        2500.0                                              // LED2 on P9.7
+
+static const char *phaseName[] =                                                // TRACE_PHASE_xxx, then before the first
+{                                                                               //  phase
+    "start screen", "wait for start", "level menu", "round intro", "playback", "input", "game over", "boot"
+};
+#define PHASES              ( sizeof( phaseName ) / sizeof( phaseName[0] ) )
+#define PHASE_BOOT          ( PHASES - 1 )
+
+typedef struct
+{
+    double seconds;
+    double uc;                                                                  // Charge, in microcoulombs
+    unsigned long wakeups;                                                      // Interrupts taken while asleep
+} Tally;
+
+static int      report = 0;
+static double   batteryMah;
+
+static Tally    total;
+static Tally    phase[ PHASES ];
+static Tally    mode[ MODES ];
+static char     modeName[ MODES ][ 24 ];
+static Tally    lcd, red, green;
+static unsigned int phaseNow = PHASE_BOOT;
+static unsigned long games = 0;                                                 // Stays 0 with TRACE_DISABLE
+
+#ifndef TRACE_DISABLE
+static uint16_t traceHead = 0;                                                  // Next trace record to read (a count)
+static Tally    gameStart;                                                      // 'total' at TRACE_GAME_START
+static int      inGame = 0;
+#endif
+
+
+static void add( Tally *t, double seconds, double ua )
+{
+    t->seconds += seconds;
+    t->uc      += seconds * ua;
+}
+
+static double activeCurrent( double mhz )                                       // Interpolated in activeUa[]
+{
+    unsigned int k;
+
+    for ( k = 1; k < sizeof( activeUa ) / sizeof( activeUa[0] ) - 1 && mhz > activeUa[k].mhz; k++ );
+    return activeUa[k - 1].ua + ( mhz - activeUa[k - 1].mhz ) *
+           ( activeUa[k].ua - activeUa[k - 1].ua ) / ( activeUa[k].mhz - activeUa[k - 1].mhz );
+}
+
+static Tally *modeTally( const char *name )
+{
+    int k;
+
+    for ( k = 0; k < MODES - 1 && modeName[k][0] && strcmp( modeName[k], name ) != 0; k++ );
+    if ( !modeName[k][0] )
+    {
+        strcpy( modeName[k], name );
+    }
+    return &mode[k];
+}
+
+// Follows the trace log, for the phase and the start and end of each game.
+static void readTrace( void )
+{
+#ifndef TRACE_DISABLE
+    while ( traceHead != traceWritten )                                         // Read after every record: none are lost
+    {
+        const TraceRecord *r = &traceLog.record[ traceHead & ( TRACE_RECORDS - 1 ) ];
+
+        traceHead = traceHead + 1;
+        if ( r->id == TRACE_PHASE && r->payload < PHASE_BOOT )
+        {
+            phaseNow = r->payload;
+        }
+        else if ( r->id == TRACE_GAME_START )
+        {
+            gameStart = total;
+            inGame    = 1;
+        }
+        else if ( r->id == TRACE_GAME_OVER && inGame )
+        {
+            double seconds = total.seconds - gameStart.seconds;
+            double uc      = total.uc - gameStart.uc;
+
+            inGame = 0;
+            games++;
+            if ( report )
+            {
+                fprintf( stderr, "energy: game %lu, score %u: %.1f s, %.3f mC, %.1f uA average\n",
+                         games, r->payload, seconds, uc / 1000, seconds > 0 ? uc / seconds : 0 );
+            }
+        }
+    }
+#endif
+}
+
+//*****************************************************************************
+// simEnergy()
+//
+// Adds a stretch of time in the board's present state. Without --energy
+// nothing is counted, since nothing would be printed.
+//
+// Arg 1: "seconds" is how long
+// Arg 2: "sr" is the status register bits the CPU sleeps with, or 0
+//*****************************************************************************
+void simEnergy( double seconds, uint16_t sr )
+{
+    double mhz = simMclkHz / 1e6;
+    double cpu, ua;
+    char   name[ 24 ];
+
+    if ( !report )
+    {
+        return;
+    }
+    readTrace();
+
+    if ( !( sr & CPUOFF ) )
+    {
+        cpu = activeCurrent( mhz );
+        snprintf( name, sizeof( name ), "active, %.2g MHz", mhz );
+    }
+    else if ( !( sr & SCG1 ) )
+    {
+        cpu = LPM0_UA + LPM0_UA_PER_MHZ * mhz;
+        snprintf( name, sizeof( name ), "LPM0, %.2g MHz", mhz );
+    }
+    else
+    {
+        cpu = ( sr & OSCOFF ) ? LPM4_UA : LPM3_UA;
+        snprintf( name, sizeof( name ), ( sr & OSCOFF ) ? "LPM4" : "LPM3" );
+    }
+    add( modeTally( name ), seconds, cpu );
+
+    ua = cpu;
+    if ( simLcdOn )
+    {
+        add( &lcd, seconds, LCD_UA );
+        ua += LCD_UA;
+    }
+    if ( P1OUT & 0x01 )
+    {
+        add( &red, seconds, RED_LED_UA );
+        ua += RED_LED_UA;
+    }
+    if ( P9OUT & 0x80 )
+    {
+        add( &green, seconds, GREEN_LED_UA );
+        ua += GREEN_LED_UA;
+    }
+    add( &phase[ phaseNow ], seconds, ua );
+    add( &total, seconds, ua );
+}
+
+static void printTally( const char *name, const Tally *t, int wakeups )
+{
+    if ( t->seconds > 0 )
+    {
+        fprintf( stderr, "  %-16s %12.1f %6.1f%% %12.3f %6.1f%% %10.1f", name, t->seconds,
+                 100 * t->seconds / total.seconds, t->uc / 1000, 100 * t->uc / total.uc, t->uc / t->seconds );
+        if ( wakeups )
+        {
+            fprintf( stderr, " %10.1f", t->wakeups / t->seconds );
+        }
+        fprintf( stderr, "\n" );
+    }
+}
+
+static void printReport( void )
+{
+    double ua;
+    unsigned int k;
+
+    readTrace();
+    if ( total.seconds <= 0 )
+    {
+        return;
+    }
+    ua = total.uc / total.seconds;
+    fprintf( stderr, "energy: %.1f s, %lu games, %.3f mC, %.1f uA average: %.1f days on %.0f mAh\n",
+             total.seconds, games, total.uc / 1000, ua, batteryMah * 1000 / ua / 24, batteryMah );
+    fprintf( stderr, "  %-16s %12s %7s %12s %7s %10s %10s\n", "by phase", "time (s)", "", "charge (mC)", "",
+             "avg (uA)", "wakeups/s" );
+    for ( k = 0; k < PHASES; k++ )
+    {
+        printTally( phaseName[k], &phase[k], 1 );
+    }
+    fprintf( stderr, "  by part\n" );
+    for ( k = 0; k < MODES && modeName[k][0]; k++ )
+    {
+        printTally( modeName[k], &mode[k], 0 );
+    }
+    printTally( "LCD on", &lcd, 0 );
+    printTally( "red LED on", &red, 0 );
+    printTally( "green LED on", &green, 0 );
+}
+
+//*****************************************************************************
+// simWakeup()
+//
+// Counts an interrupt that woke the CPU, in the present phase.
+//*****************************************************************************
+void simWakeup( void )
+{
+    if ( !report )
+    {
+        return;
+    }
+    readTrace();
+    phase[ phaseNow ].wakeups++;
+    total.wakeups++;
+}
+
+//*****************************************************************************
+// simEnergyReport()
+//
+// Turns on the counting, the per-game lines, and the totals when the
+// simulation exits.
+//
+// Arg 1: "mah" is the battery capacity the totals are given for
+//*****************************************************************************
+void simEnergyReport( double mah )
+{
+    report     = 1;
+    batteryMah = mah;
+    atexit( printReport );
+}
@@ -0,0 +1,273 @@
+// ----------------------------------------------------------------------------
+// fuzz.c  (simulated board)
+//
+// libFuzzer entry points into the firmware, on the simulated board. Build
+// one with FUZZ set to the target, in place of the simulator's main():
+//
+//    clang -g -O1 -fsanitize=fuzzer,address,undefined -Wno-unknown-pragmas
+//       -DFUZZ=FUZZ_INPUT -Itools/sim -Dmain=firmware_main
+//       -o fuzz-input tools/sim/*.c *.c      (one line)
+//    ./fuzz-input corpus/
+//
+// FUZZ_INPUT    A game driven by a stream of button timings: each byte
+//               holds the buttons in its bits 0 and 1 (button 1, button 2)
+//               for its bits 2 to 7 more ticks, and the first byte picks
+//               the level (bits 0 and 1), adaptive mode (bit 2) and an
+//               endless game (bit 3). When the stream runs out, the
+//               harness presses the wrong button. After every round
+//               GetUserSequence() must agree with myGame.c about the game
+//               being over, and the round and score must have moved on by
+//               one exactly when it isn't.
+// FUZZ_WORD     The input as a string for DisplayWord(),
+// FUZZ_WORDS    DisplayMultipleWords()
+// FUZZ_SCROLL   and ScrollWords(), cut to the 249 characters they take.
+// FUZZ_NUMBER   The first four bytes, little endian, for DisplayNumber().
+//
+// With address and undefined behaviour sanitizers, an access outside an
+// array (the LCD tables, a string) stops the run with the input that did
+// it. Characters the LCD can't show are expected in arbitrary strings, so
+// unlike simboard the harness doesn't report them.
+//
+// Without a host on the UART the simulated board doesn't wait for the wall
+// clock, so delays cost a few events each and a round takes microseconds.
+// Keep -max_len near the 250 characters the display functions take: a
+// long scroll is 20 ticks a character.
+//
+// Where there is no libFuzzer (gcc), add -DFUZZ_DRIVER and leave out
+// -fsanitize=fuzzer. The harness then runs the files given to it, like
+// libFuzzer does, or without any, FUZZ_DRIVER_RUNS random inputs and the
+// executions per second. Random inputs aren't coverage guided: they are
+// there to try the harness and the sanitizers out.
+// ----------------------------------------------------------------------------
+
+#ifdef FUZZ
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "msp430.h"
+#include "driverlib.h"
+#include "../../myGpio.h"
+#include "../../myClocks.h"
+#include "../../myLcd.h"
+#include "../../myTrace.h"
+#include "../../myTelemetry.h"
+#include "../../myRemote.h"
+#include "../../myTimer.h"
+#include "../../myDifficulty.h"
+#include "../../myAdaptive.h"
+#include "../../mySequence.h"
+#include "../../myGame.h"
+
+#undef main
+
+#define FUZZ_INPUT          1
+#define FUZZ_WORD           2
+#define FUZZ_WORDS          3
+#define FUZZ_SCROLL         4
+#define FUZZ_NUMBER         5
+
+#define TEXT_MAX            249                                                 // Characters in a char words[250]
+#define FUZZ_SEED           0x2545F491UL                                        // Sequence of the FUZZ_INPUT games
+#define FUZZ_DRIVER_RUNS    200000
+#define FUZZ_DRIVER_LENGTH  64                                                  // Longest random input
+
+#define BUTTON1             0x0002                                              // As in main.c
+#define BUTTON2             0x0004
+
+// In main.c
+void DisplayWord( char words[250] );
+void DisplayMultipleWords( char words[250] );
+void ScrollWords( char words[250] );
+void DisplayNumber( unsigned long int number );
+int  GetUserSequence( Game *game, const Tempo *tempo );
+
+int LLVMFuzzerInitialize( int *argc, char ***argv );
+int LLVMFuzzerTestOneInput( const uint8_t *data, size_t size );
+
+static const uint8_t *stream, *streamEnd;                                       // FUZZ_INPUT button timings left
+static Game          *playing;
+static Timer          streamTimer;
+
+
+// Stops the run, as a sanitizer would, so the fuzzer keeps the input
+static void check( int ok, const char *what )
+{
+    if ( !ok )
+    {
+        fprintf( stderr, "fuzz: %s\n", what );
+        abort();
+    }
+}
+
+// Moves the button stream on, and sets the timer for the next change. Once
+// the stream has run out, presses the button the game isn't waiting for
+// each other tick, so every game ends in a few ticks.
+static int streamNext( Timer *timer )
+{
+    uint8_t was = remoteButtons;
+
+    if ( stream < streamEnd )
+    {
+        remoteButtons = ( *stream & 1 ? BUTTON1 : 0 ) | ( *stream & 2 ? BUTTON2 : 0 );
+        Timer_start( timer, 1 + ( *stream >> 2 ), 0, streamNext );
+        stream++;
+    }
+    else
+    {
+        remoteButtons = remoteButtons ? 0 : Sequence_get( playing->steps ) ? BUTTON1 : BUTTON2;
+        Timer_start( timer, 1, 0, streamNext );
+    }
+    return ( remoteButtons & ~was ) != 0;                                       // Wake on a press, like Remote_tick()
+}
+
+static void fuzzInput( const uint8_t *data, size_t size )
+{
+    Game         game;
+    unsigned int level, round, score;
+    int          over;
+
+    if ( size < 1 )
+    {
+        return;
+    }
+    level = ( data[0] & 3 ) % DIFFICULTY_LEVELS;
+    stream    = data + 1;
+    streamEnd = data + size;
+    playing   = &game;
+
+    Adaptive_start( ( data[0] >> 2 ) & 1, level, Difficulty_tempo( level, 0 )->timeoutTicks );
+    Game_start( &game, 0, 0, ( data[0] >> 3 ) & 1 );
+    Timer_start( &streamTimer, 1, 0, streamNext );
+    while ( Game_playing( &game ) )
+    {
+        round = game.round;
+        score = game.score;
+        over  = GetUserSequence( &game, Difficulty_tempo( level, round ) );
+        check( over == game.over, "GetUserSequence() and the game disagree about game over" );
+        check( over ? ( game.round == round && game.score == score )
+                    : ( game.round == round + 1 && game.score == score + 1 ), "the round or score moved wrongly" );
+        check( game.endless || game.score <= GAME_ROUNDS, "a normal game went past GAME_ROUNDS" );
+        check( !Game_won( &game ) || ( !game.over && game.score == GAME_ROUNDS ), "won with a mistake" );
+    }
+    Timer_stop( &streamTimer );
+    remoteButtons = 0;
+}
+
+// The input as a string, as the display functions take it
+static void text( char *words, const uint8_t *data, size_t size )
+{
+    size = size < TEXT_MAX ? size : TEXT_MAX;
+    memcpy( words, data, size );
+    words[ size ] = 0;
+}
+
+int LLVMFuzzerInitialize( int *argc, char ***argv )
+{
+    (void)argc;
+    (void)argv;
+    Trace_init();                                                               // As main() starts up
+    initGPIO();
+    initClocks();
+    Telemetry_init( 0 );
+    Remote_init();
+    myLCD_init();
+    Timer_init();
+    __enable_interrupt();
+    Sequence_fill( FUZZ_SEED );
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput( const uint8_t *data, size_t size )
+{
+    char words[ TEXT_MAX + 1 ];
+
+    switch ( FUZZ )
+    {
+    case FUZZ_INPUT:
+        fuzzInput( data, size );
+        break;
+    case FUZZ_WORD:
+        text( words, data, size );
+        DisplayWord( words );
+        break;
+    case FUZZ_WORDS:
+        text( words, data, size );
+        DisplayMultipleWords( words );
+        break;
+    case FUZZ_SCROLL:
+        text( words, data, size );
+        ScrollWords( words );
+        break;
+    case FUZZ_NUMBER:
+        if ( size >= 4 )
+        {
+            DisplayNumber( data[0] | (unsigned long)data[1] << 8 | (unsigned long)data[2] << 16
+                           | (unsigned long)data[3] << 24 );
+        }
+        break;
+    }
+    return 0;
+}
+
+#ifdef FUZZ_DRIVER
+static void runFile( const char *name )
+{
+    static uint8_t data[ 1 << 20 ];
+    FILE  *f = fopen( name, "rb" );
+    size_t size;
+
+    if ( !f )
+    {
+        perror( name );
+        exit( 1 );
+    }
+    size = fread( data, 1, sizeof( data ), f );
+    fclose( f );
+    LLVMFuzzerTestOneInput( data, size );
+}
+
+int main( int argc, char *argv[] )
+{
+    uint8_t         data[ FUZZ_DRIVER_LENGTH ];
+    uint32_t        x = 0x9E3779B9UL;
+    struct timespec start, end;
+    double          seconds;
+    size_t          size, k;
+    long            run;
+
+    LLVMFuzzerInitialize( &argc, &argv );
+    if ( argc > 1 )
+    {
+        for ( k = 1; k < (size_t)argc; k++ )
+        {
+            runFile( argv[k] );
+        }
+        return 0;
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    for ( run = 0; run < FUZZ_DRIVER_RUNS; run++ )
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        size = x % ( FUZZ_DRIVER_LENGTH + 1 );
+        for ( k = 0; k < size; k++ )
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            data[k] = (uint8_t)x;
+        }
+        LLVMFuzzerTestOneInput( data, size );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    seconds = ( end.tv_sec - start.tv_sec ) + ( end.tv_nsec - start.tv_nsec ) / 1e9;
+    printf( "fuzz: %d random inputs in %.2fs, %.0f a second\n", FUZZ_DRIVER_RUNS, seconds, FUZZ_DRIVER_RUNS / seconds );
+    return 0;
+}
+#endif
+
+#endif
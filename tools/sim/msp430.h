@@ -0,0 +1,167 @@
+/*
+ * msp430.h  (simulated board)
+ *
+ * Stands in for TI's device header when the firmware is built for the host
+ * by tools/sim. Only the registers and bits the game uses are here. Most
+ * registers are plain variables; the ones whose value depends on time or
+ * that have side effects when read go through the hooks in sim.c.
+ */
+
+#ifndef SIM_MSP430_H_
+#define SIM_MSP430_H_
+
+#include <stdint.h>
+
+//***** Bits ******************************************************************
+#define BIT0                (0x0001)
+#define BIT1                (0x0002)
+#define BIT2                (0x0004)
+#define BIT3                (0x0008)
+#define BIT4                (0x0010)
+#define BIT5                (0x0020)
+#define BIT6                (0x0040)
+#define BIT7                (0x0080)
+
+// Status register
+#define GIE                 (0x0008)
+#define CPUOFF              (0x0010)
+#define OSCOFF              (0x0020)
+#define SCG0                (0x0040)
+#define SCG1                (0x0080)
+#define LPM0_bits           (CPUOFF)
+#define LPM3_bits           (SCG1 | SCG0 | CPUOFF)
+#define LPM4_bits           (SCG1 | SCG0 | OSCOFF | CPUOFF)
+
+// Watchdog, PMM, MPU
+#define WDTPW               (0x5A00)
+#define WDTHOLD             (0x0080)
+#define PMMPW               (0xA500)
+#define PMMREGOFF           (0x0010)
+#define LOCKLPM5            (0x0001)
+#define MPUPW               (0xA500)
+
+// Timer_A
+#define TAIFG               (0x0001)
+#define TAIE                (0x0002)
+#define TACLR               (0x0004)
+#define MC_0                (0x0000)
+#define MC_1                (0x0010)
+#define MC_2                (0x0020)
+#define MC_3                (0x0030)
+#define TASSEL_1            (0x0100)
+#define TASSEL_2            (0x0200)
+#define ID_3                (0x00C0)
+#define TAIDEX_7            (0x0007)
+#define CCIFG               (0x0001)
+#define CCIE                (0x0010)
+
+// eUSCI_A UART
+#define UCSWRST             (0x0001)
+#define UCSSEL__SMCLK       (0x0080)
+#define UCOS16              (0x0001)
+#define UCBRF_1             (0x0010)
+#define UCRXIFG             (0x0001)
+#define UCTXIFG             (0x0002)
+#define UCRXIE              (0x0001)
+#define UCTXIE              (0x0002)
+#define UCBUSY              (0x0001)
+#define USCI_UART_UCRXIFG   (0x0002)
+#define USCI_UART_UCTXIFG   (0x0004)
+#define USCI_UART_UCTXCPTIFG (0x0008)
+
+// DMA
+#define DMADT_0             (0x0000)
+#define DMASRCINCR_3        (0x0300)
+#define DMADSTINCR_0        (0x0000)
+#define DMASRCBYTE          (0x0040)
+#define DMADSTBYTE          (0x0080)
+#define DMAIE               (0x0004)
+#define DMAIFG              (0x0008)
+#define DMAEN               (0x0010)
+#define DMARMWDIS           (0x0001)
+#define DMA0TSEL__UCA1TXIFG (17)
+#define DMAIV_DMA0IFG       (0x0002)
+
+//***** Registers *************************************************************
+// Plain registers. sim.c defines them from the same list.
+#define SIM_REGISTERS( R8, R16 ) \
+    R8( P1OUT )  R8( P1DIR )  R8( P1REN )  R8( P1IE )  R8( P1IES )  R8( P1IFG ) \
+    R8( P9OUT )  R8( P9DIR )  R8( P3SEL0 ) R8( P3SEL1 ) R8( P4SEL0 ) R8( P4SEL1 ) \
+    R16( PM5CTL0 ) R16( WDTCTL ) R16( PMMCTL0 ) R16( MPUCTL0 ) R16( REFCTL0 ) \
+    R16( TA0CTL ) R16( TA0CCTL0 ) R16( TA0CCR0 ) \
+    R16( TA1CCTL0 ) R16( TA1CCR0 ) \
+    R16( UCA1CTLW0 ) R16( UCA1BRW ) R16( UCA1MCTLW ) R16( UCA1IE ) R16( UCA1IFG ) \
+    R16( UCA1STATW ) R16( UCA1TXBUF ) \
+    R16( UCA0CTLW0 ) R16( UCA0BRW ) R16( UCA0MCTLW ) R16( UCA0IE ) R16( UCA0IFG ) \
+    R16( DMACTL0 ) R16( DMACTL4 ) R16( DMA0CTL ) R16( DMA0SZ ) R16( DMA0SA ) R16( DMA0DA )
+
+#define SIM_EXTERN8( name )     extern volatile uint8_t  name;
+#define SIM_EXTERN16( name )    extern volatile uint16_t name;
+SIM_REGISTERS( SIM_EXTERN8, SIM_EXTERN16 )
+
+extern volatile uint8_t LCDMEM[ 64 ];                                           // LCDM1 is LCDMEM[0]
+extern volatile uint8_t LCDBMEM[ 64 ];
+
+// Registers with behaviour, see sim.c
+uint8_t            sim_P1IN( void );
+uint16_t           sim_TA0R( void );
+uint16_t           sim_TA1R( void );
+volatile uint16_t *sim_TA1CTL( void );
+uint16_t           sim_SYSRSTIV( void );
+uint16_t           sim_DMAIV( void );
+uint16_t           sim_UCA1IV( void );
+uint16_t           sim_UCA1RXBUF( void );
+uint16_t           sim_UCA0IV( void );
+uint16_t           sim_UCA0RXBUF( void );
+volatile uint16_t *sim_UCA0TXBUF( void );
+volatile uint16_t *sim_CRCINIRES( void );
+volatile uint16_t *sim_CRCDI( void );
+
+#define P1IN                sim_P1IN()
+#define TA0R                sim_TA0R()
+#define TA1R                sim_TA1R()
+#define TA1CTL              ( *sim_TA1CTL() )
+#define SYSRSTIV            sim_SYSRSTIV()
+#define DMAIV               sim_DMAIV()
+#define UCA1IV              sim_UCA1IV()
+#define UCA1RXBUF           sim_UCA1RXBUF()
+#define UCA0IV              sim_UCA0IV()
+#define UCA0RXBUF           sim_UCA0RXBUF()
+#define UCA0TXBUF           ( *sim_UCA0TXBUF() )
+#define CRCINIRES           ( *sim_CRCINIRES() )
+#define CRCDI               ( *sim_CRCDI() )
+
+//***** Intrinsics ************************************************************
+void     sim_bisSR( uint16_t );
+void     sim_bicSROnExit( uint16_t );
+uint16_t sim_getInterruptState( void );
+void     sim_setInterruptState( uint16_t );
+void     sim_writeAddr( const char *, uintptr_t );
+
+#define __interrupt
+#define __bis_SR_register( bits )           sim_bisSR( bits )
+#define _BIS_SR( bits )                     sim_bisSR( bits )
+#define __bic_SR_register_on_exit( bits )   sim_bicSROnExit( bits )
+#define __enable_interrupt()                sim_setInterruptState( GIE )
+#define __disable_interrupt()               sim_setInterruptState( 0 )
+#define __get_interrupt_state()             sim_getInterruptState()
+#define __set_interrupt_state( state )      sim_setInterruptState( state )
+#define __even_in_range( value, range )     ( value )
+#define __no_operation()                    do { } while ( 0 )
+#define __get_SP_register()                 ( (uintptr_t)STACK_END )
+
+//***** Stack *****************************************************************
+// Stands in for .stack (myStack.c). The firmware runs on the host's stack,
+// so nothing is pushed here and the high-water mark stays 0.
+#define SIM_STACK_BYTES     160
+extern uint16_t sim_stack[ SIM_STACK_BYTES / 2 ];
+
+#define STACK_BOTTOM        ( &sim_stack[0] )
+#define STACK_END           ( &sim_stack[ SIM_STACK_BYTES / 2 ] )
+
+// The DMA address registers. The firmware cuts the register's address to
+// 16 bits, so the simulator is given its name.
+#define __data16_write_addr( reg, value )   sim_writeAddr( #reg, (uintptr_t)( value ) )
+
+
+#endif /* SIM_MSP430_H_ */
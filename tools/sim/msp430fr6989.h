@@ -0,0 +1,6 @@
+/*
+ * msp430fr6989.h  (simulated board)
+ *
+ */
+
+#include "msp430.h"
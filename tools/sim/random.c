@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------------
+// random.c  (simulated board)
+//
+// Statistical tests of the firmware's generators (myRandom.c), on the
+// numbers the game actually uses:
+//
+//    ./simboard --random
+//
+// Four streams are tested, 2^26 bits each:
+//    - Random_next(), the xorshift generator, seeded from a fixed pool
+//    - Random_at() words, GAME_ROUNDS counters for each seed taken from
+//      Random_next(), as a game takes them (128K games)
+//    - the steps of such games, the top SEQUENCE_BITS bits of each word
+//      (with two buttons, 4M normal games)
+//    - the steps of one endless game, 2^26 / SEQUENCE_BITS counters of one
+//      seed
+//
+// Each stream goes through a frequency test (all bits, and each bit of a
+// value on its own), a runs test over the bits, a serial correlation test
+// between each value and the 1 to GAME_ROUNDS values after it, and a
+// chi-square test of the 16-bit blocks (with two buttons, each block is
+// one game's sequence, so it checks that all 2^16 are as likely). Each
+// test comes to a z-score; the worst one of each kind is printed, and any
+// past Z_LIMIT fails. The pool is fixed, so every run draws the same
+// numbers and gives the same result. It takes about three seconds, and exits
+// with 1 if any test failed.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include "../../myGame.h"
+#include "../../mySequence.h"
+#include "../../myRandom.h"
+
+#define STREAM_BITS         ( 1UL << 26 )                                       // Bits drawn from each stream
+#define LAGS                GAME_ROUNDS                                         // Serial correlation lags
+#define BLOCKS              ( 1UL << 16 )                                       // Values of a 16-bit block
+#define Z_LIMIT             4.5                                                 // |z| past this fails (p < 7e-6)
+
+typedef struct
+{
+    const char    *name;
+    int            bits;                                                        // Bits in each value
+    uint32_t     (*next)( void );                                               // Next value of the stream
+} Stream;
+
+typedef struct
+{
+    double         monobit, position, runs, serial, blocks;                     // Worst |z| of each test
+} Result;
+
+static uint32_t seed;                                                           // Seed of the game being drawn
+static uint32_t counter;                                                        // Its next Random_at() counter
+static unsigned long blockCount[ BLOCKS ];
+
+
+//***** Streams ***************************************************************
+static uint32_t nextWord( void )
+{
+    if ( counter == GAME_ROUNDS )                                               // A new game, with a new seed
+    {
+        counter = 0;
+        seed = Random_next();
+    }
+    return Random_at( seed, counter++ );
+}
+
+static uint32_t nextStep( void )
+{
+    return nextWord() >> ( 32 - SEQUENCE_BITS );
+}
+
+static uint32_t nextEndlessStep( void )
+{
+    return Random_at( seed, counter++ ) >> ( 32 - SEQUENCE_BITS );
+}
+
+static const Stream streams[] =
+{
+    { "Random_next()",        32,            Random_next     },
+    { "Random_at() words",    32,            nextWord        },
+    { "game steps",           SEQUENCE_BITS, nextStep        },
+    { "endless game steps",   SEQUENCE_BITS, nextEndlessStep },
+};
+
+
+//*****************************************************************************
+// root()
+//
+// Square root by Newton's method, so the simulated board needs no libm.
+//*****************************************************************************
+static double root( double x )
+{
+    double r = x > 1 ? x : 1;
+    int    k;
+
+    for ( k = 0; k < 64 && x > 0; k++ )
+    {
+        r = ( r + x / r ) / 2;
+    }
+    return x > 0 ? r : 0;
+}
+
+static double magnitude( double z )
+{
+    return z < 0 ? -z : z;
+}
+
+//*****************************************************************************
+// testStream()
+//
+// Draws STREAM_BITS bits from a stream and runs every test on them, without
+// keeping them: each test only needs running sums.
+//*****************************************************************************
+static void testStream( const Stream *s, Result *r )
+{
+    unsigned long n = STREAM_BITS / s->bits, i, ones = 0, transitions = 0;
+    unsigned long positionOnes[ 32 ] = { 0 };
+    double        recent[ LAGS ] = { 0 }, products[ LAGS + 1 ] = { 0 };
+    double        sum = 0, sumSquares = 0, mean, variance, pi, z, chi = 0, expected;
+    uint64_t      pending = 0;                                                  // Bits not yet in a block
+    int           pendingBits = 0, b, lag;
+    uint32_t      v, last = 0, mask = s->bits == 32 ? 0xFFFFFFFFUL : ( 1UL << s->bits ) - 1;
+    double        u;
+
+    memset( blockCount, 0, sizeof( blockCount ) );
+    memset( r, 0, sizeof( *r ) );
+    for ( i = 0; i < n; i++ )
+    {
+        v = s->next() & mask;
+
+        ones += __builtin_popcount( v );
+        for ( b = 0; b < s->bits; b++ )
+        {
+            positionOnes[b] += ( v >> b ) & 1;
+        }
+
+        transitions += __builtin_popcount( ( v ^ ( v >> 1 ) ) & ( mask >> 1 ) );  // Inside the value, first bit first
+        if ( i > 0 )
+        {
+            transitions += ( last ^ ( v >> ( s->bits - 1 ) ) ) & 1;             // Last bit before it to its first
+        }
+        last = v;
+
+        u = v / ( (double)mask + 1 );
+        sum += u;
+        sumSquares += u * u;
+        for ( lag = 1; lag <= LAGS; lag++ )
+        {
+            products[ lag ] += u * recent[ ( i - lag ) % LAGS ];                // recent[] is 0 before the start
+        }
+        recent[ i % LAGS ] = u;
+
+        pending = ( pending << s->bits ) | v;
+        pendingBits += s->bits;
+        while ( pendingBits >= 16 )
+        {
+            pendingBits -= 16;
+            blockCount[ ( pending >> pendingBits ) & ( BLOCKS - 1 ) ]++;
+        }
+    }
+
+    r->monobit = magnitude( ( 2.0 * ones - STREAM_BITS ) / root( STREAM_BITS ) );
+    for ( b = 0; b < s->bits; b++ )
+    {
+        z = magnitude( ( 2.0 * positionOnes[b] - n ) / root( n ) );
+        r->position = z > r->position ? z : r->position;
+    }
+
+    pi = (double)ones / STREAM_BITS;                                            // NIST SP 800-22 runs test
+    r->runs = magnitude( ( transitions + 1 - 2.0 * STREAM_BITS * pi * ( 1 - pi ) )
+                    / ( 2 * root( 2.0 * STREAM_BITS ) * pi * ( 1 - pi ) ) );
+
+    mean = sum / n;
+    variance = sumSquares / n - mean * mean;
+    for ( lag = 1; lag <= LAGS; lag++ )
+    {
+        z = magnitude( ( products[ lag ] / ( n - lag ) - mean * mean ) / variance * root( n - lag ) );
+        r->serial = z > r->serial ? z : r->serial;
+    }
+
+    expected = (double)( STREAM_BITS / 16 ) / BLOCKS;
+    for ( i = 0; i < BLOCKS; i++ )
+    {
+        chi += ( blockCount[i] - expected ) * ( blockCount[i] - expected ) / expected;
+    }
+    r->blocks = magnitude( ( chi - ( BLOCKS - 1 ) ) / root( 2.0 * ( BLOCKS - 1 ) ) );
+}
+
+static int check( const char *test, double z )
+{
+    printf( "  %s %5.2f%s", test, z, z > Z_LIMIT ? "!" : "" );
+    return z <= Z_LIMIT;
+}
+
+int simRandom( void )
+{
+    Result   r;
+    unsigned k;
+    int      ok = 1, passed;
+
+    for ( k = 0; k < RANDOM_POOL_WORDS; k++ )                                   // A fixed pool, so runs repeat
+    {
+        Random_stir( 0x2545 + 0x1F35 * k );
+    }
+    Random_seed();
+
+    printf( "random: %lu bits from each stream, worst |z| of each test (fails past %.1f)\n",
+            STREAM_BITS, Z_LIMIT );
+    for ( k = 0; k < sizeof( streams ) / sizeof( streams[0] ); k++ )
+    {
+        counter = GAME_ROUNDS;                                                  // Start a new game
+        if ( streams[k].next == nextEndlessStep )
+        {
+            seed = Random_next();
+            counter = 0;
+        }
+        testStream( &streams[k], &r );
+        printf( "%-20s", streams[k].name );
+        passed  = check( "frequency", r.monobit );
+        passed &= check( "bits", r.position );
+        passed &= check( "runs", r.runs );
+        passed &= check( "serial", r.serial );
+        passed &= check( "blocks", r.blocks );
+        printf( "  %s\n", passed ? "ok" : "FAILED" );
+        ok &= passed;
+    }
+    printf( "random: %s\n", ok ? "all tests passed" : "FAILED" );
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,931 @@
+// ----------------------------------------------------------------------------
+// sim.c  (simulated board)
+//
+// Runs the game on the PC, with the backchannel UART on a pseudo-terminal,
+// so tools/runner.c and tools/telemetry.c can talk to it like a LaunchPad.
+//
+//    cc -O2 -Wno-unknown-pragmas -Itools/sim -Dmain=firmware_main
+//       -o simboard tools/sim/*.c *.c      (one line)
+//    ./simboard                      (real time)
+//    ./simboard --lockstep           (time only moves while the host has
+//                                     timed commands queued)
+//    ./simboard --lcd frames.lcd     (also save every change of the LCD,
+//                                     for tools/lcd.c)
+//    ./simboard --energy [mAh]       (report the charge used, per game and
+//                                     per phase, the wakeups per second,
+//                                     and the battery life on mAh, 225 (a
+//                                     CR2032) if not given; see energy.c)
+//    ./simboard --pair               (a LINK build: two boards wired
+//                                     together, in real time; prints board
+//                                     A's pty, then board B's)
+//    ./simboard --verify [workers]   (check the rules of the game against
+//                                     every sequence and every mistake, and
+//                                     exit; see verify.c)
+//    ./simboard --random             (run statistical tests on the random
+//                                     numbers of the game, and exit; see
+//                                     random.c)
+//    ./simboard --adaptive           (play the adaptive mode against a
+//                                     population of simulated players, and
+//                                     exit; see adaptive.c)
+//
+// The firmware is compiled unchanged against the msp430.h and driverlib.h
+// in this directory. Time is counted in MCLK cycles, but it is not
+// cycle-accurate: code takes no time, and time only moves when the
+// firmware reads a timer or the buttons, or sleeps. That is enough for
+// everything the game waits on: delay() sleeps until the next tick, so
+// delays cost almost nothing to simulate.
+//
+// Interrupts are taken whenever GIE is set, between register accesses:
+// Timer_0 CCR0 when TA0R wraps, Timer_1 CCR0 when the count reaches it (it
+// runs continuously, on ACLK, for myTimer.c), DMA channel 0 when a block
+// has been written to the pty, and eUSCI_A1 receive for each byte from the
+// pty. The buttons are never pressed (P1IN reads 0xFF); use REMOTE_BUTTONS
+// instead. Unlike the real board, Timer_1 and the UART keep running in
+// LPM4, so a host can wake the game from deep sleep. FRAM is plain RAM that
+// starts blank every run. A DMA block that isn't set up to write to
+// UCA1TXBUF stops the simulation, as it would hang the board.
+//
+// In lockstep mode the simulation waits at each Timer_1 tick (myTimer.h)
+// for the host to send something, unless myRemote has timed commands
+// queued. Commands that queue nothing, like REMOTE_LCD, are answered
+// without moving time on. The host then sees exactly the ticks it asked
+// for, however slow it is, so scripted runs are repeatable.
+//
+// A LINK build (myLink.h) also has eUSCI_A0. With --pair the simulator
+// forks into two boards, each with its own pty, and carries the bytes each
+// one sends to the other, stamped with the time the last bit is in (87us
+// a byte at 115200 baud). Board B boots PAIR_LATE_MS after board A, so
+// their clocks differ as two LaunchPads' would. Both wait for the wall
+// clock before each event, so a byte is taken at its time on the other
+// board, unless that board is already past it. UCTXIFG comes back when the
+// byte is out. Without --pair nobody is at the other end.
+//
+// tools/sim/fuzz.c builds the firmware with libFuzzer entry points
+// instead of main() (define FUZZ). There is no pty then: what the board
+// sends is dropped, and time runs on without waiting for the wall clock.
+// Timer_1 ticks are only events when a host is waiting for them, and
+// Timer_0 only wraps while it is running.
+//
+// At each Timer_1 tick the LCD memory is decoded with
+// tools/lcd.h if it has changed, and a position with all its segments on
+// (myLCD_showChar() given a character it can't show) is reported on
+// stderr.
+// ----------------------------------------------------------------------------
+
+#define _GNU_SOURCE                                                             // ppoll()
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <termios.h>
+#include <sys/prctl.h>
+#include <sys/socket.h>
+#include "msp430.h"
+#include "driverlib.h"
+#include "../lcd.h"
+#include "../../myTimer.h"
+#include "../../myRemote.h"
+
+#undef main
+
+#define MCLK_HZ             4000000ULL
+#define ACLK_HZ             32768ULL
+#define TA0_WRAP            ( 2ULL * 65536 )                                    // MCLK cycles per Timer_0 wrap (SMCLK = MCLK/2)
+#define READ_CYCLES         4                                                   // Time taken by a timer read
+#define POLL_CYCLES         10                                                  // Time taken by a button poll
+#define RX_BYTES            256
+#define BYTE_CYCLES         ( MCLK_HZ * 10 / 115200 )                           // A byte on eUSCI_A0, 8N1
+#define LINK_BYTES          256
+#define PAIR_LATE_MS        250                                                 // Board B boots this much after board A
+
+// The firmware's interrupt service routines
+void Timer_A0( void );
+void Timer_A1( void );
+void USCI_A1_ISR( void );
+void USCI_A0_ISR( void );
+void DMA_ISR( void );
+void firmware_main( void );
+
+// energy.c
+void simEnergy( double, uint16_t );
+void simWakeup( void );
+void simEnergyReport( double );
+
+// verify.c
+int simVerify( int );
+
+// random.c
+int simRandom( void );
+
+// adaptive.c
+int simAdaptive( void );
+
+
+//***** Registers *************************************************************
+#define SIM_DEFINE8( name )     volatile uint8_t  name = 0;
+#define SIM_DEFINE16( name )    volatile uint16_t name = 0;
+SIM_REGISTERS( SIM_DEFINE8, SIM_DEFINE16 )
+
+volatile uint8_t LCDMEM[ 64 ];
+volatile uint8_t LCDBMEM[ 64 ];
+uint16_t         sim_stack[ SIM_STACK_BYTES / 2 ];
+
+static volatile uint16_t ta1ctl = 0;
+static uint64_t          ta1Start = 0;                                          // ACLK count when Timer_1 was cleared
+static uint64_t          ta1Seen = 0;                                           // ACLK count CCR0 has been compared up to
+static volatile uint16_t crcResult = 0;
+static volatile uint16_t crcInput = 0;
+static int               crcPending = 0;                                        // crcInput was written, not yet processed
+static uint16_t          resetVector = 0x0002;                                  // Brownout, the first time it is read
+static uint16_t          dmaVector = 0;
+static int               rxFlag = 0;
+static uint8_t           rxBuf = 0;
+static uintptr_t         dmaSource = 0;                                         // DMA0SA
+static uintptr_t         dmaDestination = 0;                                    // DMA0DA
+static int               link0Flag = 0;                                         // eUSCI_A0 receive
+static uint8_t           link0Buf = 0;
+static volatile uint16_t linkTxBuf = 0;
+static int               linkTxWritten = 0;                                     // UCA0TXBUF was written, not yet sent
+
+
+//***** Simulation state ******************************************************
+static uint64_t now = 0;                                                        // MCLK cycles since reset
+static uint64_t ta0Next = TA0_WRAP;                                             // Next Timer_0 wrap
+
+static int      gie = 0;
+static int      inIsr = 0;
+static int      woken = 0;                                                      // __bic_SR_register_on_exit() was called
+static int      ta0Flag = 0;
+static int      waitForHost = 0;                                                // A Timer_1 tick went by (lockstep)
+static uint16_t sleepBits = 0;                                                  // Status register bits while asleep
+
+static int      pty = -1;
+static int      lockstep = 0;
+static uint8_t  rx[ RX_BYTES ];
+static int      rxHead = 0, rxCount = 0;
+static struct timespec start;
+static volatile sig_atomic_t stopping = 0;                                      // SIGINT or SIGTERM
+
+typedef struct
+{
+    uint64_t at;                                                                // MCLK cycle its last bit is in
+    uint8_t  byte;
+} LinkByte;
+
+static int      paired = 0;                                                     // --pair
+static int      linkFd = -1;                                                    // The other board
+static LinkByte linkIn[ LINK_BYTES ];
+static int      linkHead = 0, linkCount = 0;
+static uint64_t linkTxDone = 0;                                                 // When the byte going out is out, or 0
+static uint64_t linkEpoch = 0;                                                  // Cycles this board booted after board A
+
+static uint32_t ta1Ticks = 0;                                                   // Timer_1 ticks since it was started
+static FILE    *lcdFile = NULL;                                                 // --lcd file
+static LcdFrame lcdLast;                                                        // Display at the last change
+
+
+static uint64_t aclkAt( uint64_t cycles )
+{
+    return cycles * ACLK_HZ / MCLK_HZ;
+}
+
+static uint64_t cyclesAt( uint64_t aclk )                                       // First cycle at which ACLK has reached aclk
+{
+    return ( aclk * MCLK_HZ + ACLK_HZ - 1 ) / ACLK_HZ;
+}
+
+static int ta1Running( void )
+{
+    if ( ta1ctl & TACLR )                                                       // Cleared since we last looked
+    {
+        ta1ctl  &= ~TACLR;
+        ta1Start = aclkAt( now );
+        ta1Seen  = ta1Start;
+        ta1Ticks = 0;
+    }
+    return ( ta1ctl & MC_3 ) != 0;
+}
+
+static uint64_t ta1Tick( void )                                                 // ACLK count of the next tick
+{
+    return ta1Start + (uint64_t)( ta1Ticks + 1 ) * TIMER_TICK_COUNTS;
+}
+
+static uint64_t ta1Match( void )                                                // ACLK count of the next CCR0 match
+{
+    uint64_t from = ta1Seen + 1;
+
+    return from + (uint16_t)( TA1CCR0 - (uint16_t)( from - ta1Start ) );
+}
+
+static uint64_t nextEvent( void )
+{
+    uint64_t next = ( TA0CTL & MC_3 ) ? ta0Next : UINT64_MAX;                   // Timer_0 stopped (the fuzz harness)
+
+    if ( ta1Running() )
+    {
+        if ( pty >= 0 && cyclesAt( ta1Tick() ) < next )                         // Only a host waits for every tick
+        {
+            next = cyclesAt( ta1Tick() );
+        }
+        if ( ( TA1CCTL0 & CCIE ) && cyclesAt( ta1Match() ) < next )
+        {
+            next = cyclesAt( ta1Match() );
+        }
+    }
+    if ( linkTxDone && linkTxDone < next )
+    {
+        next = linkTxDone;
+    }
+    if ( linkCount && ( UCA0IE & UCRXIE ) && linkIn[ linkHead ].at > now && linkIn[ linkHead ].at < next )
+    {                                                                           // One that is due waits for GIE
+        next = linkIn[ linkHead ].at;
+    }
+    return next;
+}
+
+//*****************************************************************************
+// Host side of the UART
+//*****************************************************************************
+static void hostReceive( int timeoutMs )
+{
+    struct pollfd p = { pty, POLLIN, 0 };
+    ssize_t n;
+
+    if ( stopping )                                                             // Exit here, where the firmware is
+    {                                                                           //  waiting, so the --lcd file is whole
+        exit( 0 );
+    }
+    if ( rxCount == RX_BYTES || poll( &p, 1, timeoutMs ) <= 0 )
+    {
+        return;
+    }
+    if ( rxHead + rxCount >= RX_BYTES )
+    {
+        memmove( rx, rx + rxHead, rxCount );
+        rxHead = 0;
+    }
+    n = read( pty, rx + rxHead + rxCount, RX_BYTES - rxHead - rxCount );
+    if ( n > 0 )
+    {
+        rxCount += n;
+    }
+    else if ( n < 0 && errno != EAGAIN && errno != EINTR )
+    {
+        perror( "pty" );
+        exit( 1 );
+    }
+}
+
+static void hostSend( const uint8_t *data, unsigned int length )
+{
+    if ( pty < 0 )                                                              // No host (the fuzz harness)
+    {
+        return;
+    }
+    if ( write( pty, data, length ) < 0 && errno != EAGAIN )                    // Nobody reading: the bytes are lost,
+    {                                                                           //  like on a real UART
+        perror( "pty" );
+        exit( 1 );
+    }
+}
+
+// Keeps virtual time from running ahead of the wall clock, while watching
+// for bytes from the host.
+static void pace( void )
+{
+    struct timespec t;
+    int64_t ahead;
+
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    ahead = (int64_t)( now * 1000 / MCLK_HZ )
+          - ( ( t.tv_sec - start.tv_sec ) * 1000 + ( t.tv_nsec - start.tv_nsec ) / 1000000 );
+    hostReceive( ahead > 0 ? (int)ahead : 0 );
+}
+
+//*****************************************************************************
+// The link to the other board (--pair)
+//*****************************************************************************
+static uint64_t wallCycles( void )                                              // MCLK cycles of real time since the start
+{
+    struct timespec t;
+
+    clock_gettime( CLOCK_MONOTONIC, &t );
+    return (uint64_t)( ( t.tv_sec - start.tv_sec ) * 1000000000LL + ( t.tv_nsec - start.tv_nsec ) ) * MCLK_HZ
+         / 1000000000ULL;
+}
+
+static void linkReceive( void )
+{
+    uint8_t  record[9];
+    uint64_t at;
+    ssize_t  n;
+
+    while ( linkFd >= 0 && linkCount < LINK_BYTES )
+    {
+        n = recv( linkFd, record, sizeof( record ), MSG_DONTWAIT );
+        if ( n == 0 )                                                           // The other board has gone
+        {
+            close( linkFd );
+            linkFd = -1;
+        }
+        if ( n != sizeof( record ) )
+        {
+            return;
+        }
+        memcpy( &at, record, 8 );                                               // In board A's time
+        linkIn[ ( linkHead + linkCount ) % LINK_BYTES ].at   = at > linkEpoch ? at - linkEpoch : 0;
+        linkIn[ ( linkHead + linkCount ) % LINK_BYTES ].byte = record[8];
+        linkCount++;
+    }
+}
+
+static void linkSend( void )                                                    // Sends what was written to UCA0TXBUF
+{
+    uint8_t  record[9];
+    uint64_t at;
+
+    linkTxWritten = 0;
+    UCA0IFG      &= ~UCTXIFG;
+    linkTxDone    = now + BYTE_CYCLES;
+    at            = linkTxDone + linkEpoch;                                     // In board A's time
+    memcpy( record, &at, 8 );
+    record[8] = (uint8_t)linkTxBuf;
+    if ( linkFd >= 0 )
+    {
+        send( linkFd, record, sizeof( record ), MSG_DONTWAIT );                 // Lost if the other board is behind
+    }
+}
+
+// Waits for the wall clock to reach the event at 'next', reading from the
+// host and the other board meanwhile, and returns the time of the first
+// event, which is earlier if a byte from the other board is due sooner.
+// Without --pair it doesn't wait.
+static uint64_t linkPace( uint64_t next )
+{
+    struct pollfd   p[2];
+    struct timespec wait;
+    uint64_t        wall;
+
+    while ( paired )
+    {
+        hostReceive( 0 );                                                       // Taken at the next event
+        linkReceive();
+        next = nextEvent();
+        wall = wallCycles();
+        if ( wall >= next )
+        {
+            break;
+        }
+        p[0].fd = pty;
+        p[1].fd = linkFd;
+        p[0].events = p[1].events = POLLIN;
+        wait.tv_sec  = 0;
+        wait.tv_nsec = (long)( ( next - wall ) * 1000000000ULL / MCLK_HZ );
+        if ( wait.tv_nsec > 100000000L )
+        {
+            wait.tv_nsec = 100000000L;
+        }
+        ppoll( p, 2, &wait, NULL );
+    }
+    return next;
+}
+
+//*****************************************************************************
+// The LCD
+//*****************************************************************************
+
+// Called at the end of each Timer_1 tick. Saves the display if it has
+// changed, and reports glitches.
+static void lcdWatch( void )
+{
+    LcdFrame frame;
+    LcdText  text;
+
+    if ( pty < 0 )                                                              // The fuzz harness: arbitrary strings
+    {                                                                           //  are expected to glitch
+        return;
+    }
+    memset( &frame, 0, sizeof( frame ) );
+    frame.on = (uint8_t)simLcdOn;
+    memcpy( frame.mem, (const void *)LCDMEM, LCD_MEM_BYTES );
+    if ( frame.on == lcdLast.on && memcmp( frame.mem, lcdLast.mem, LCD_MEM_BYTES ) == 0 )
+    {
+        return;
+    }
+    frame.tick = ta1Ticks;
+    lcdLast    = frame;
+
+    if ( frame.on && lcdDecode( frame.mem, &text ) )
+    {
+        fprintf( stderr, "tick %lu: LCD \"%s\" has all segments on at position", (unsigned long)ta1Ticks, text.text );
+        fprintf( stderr, "%s%s%s%s%s%s\n", text.glitches & 1 ? " 1" : "", text.glitches & 2 ? " 2" : "",
+                 text.glitches & 4 ? " 3" : "", text.glitches & 8 ? " 4" : "", text.glitches & 16 ? " 5" : "",
+                 text.glitches & 32 ? " 6" : "" );
+    }
+    if ( lcdFile && fwrite( &frame, sizeof( frame ), 1, lcdFile ) != 1 )
+    {
+        perror( "lcd" );
+        exit( 1 );
+    }
+}
+
+static void openLcdFile( const char *name )
+{
+    LcdFileHeader h = { LCD_FRAME_MAGIC, LCD_FRAME_VERSION, sizeof( LcdFrame ) };
+
+    lcdFile = fopen( name, "wb" );
+    if ( !lcdFile || fwrite( &h, sizeof( h ), 1, lcdFile ) != 1 )
+    {
+        perror( name );
+        exit( 1 );
+    }
+}
+
+static void stop( int signal )
+{
+    (void)signal;
+    stopping = 1;
+}
+
+//*****************************************************************************
+// Events and interrupts
+//*****************************************************************************
+static void fireDue( void )
+{
+    if ( now >= ta0Next )
+    {
+        ta0Next += ( ( now - ta0Next ) / TA0_WRAP + 1 ) * TA0_WRAP;             // Wraps nobody looked for count as one
+        ta0Flag  = 1;
+    }
+    if ( ta1Running() && ( TA1CCTL0 & CCIE ) && now >= cyclesAt( ta1Match() ) )
+    {
+        ta1Seen   = ta1Match();
+        TA1CCTL0 |= CCIFG;
+    }
+    else if ( ta1Running() && aclkAt( now ) > ta1Seen )                         // No match missed meanwhile
+    {
+        ta1Seen = aclkAt( now );
+    }
+    if ( linkTxDone && now >= linkTxDone )                                      // The byte is out
+    {
+        linkTxDone = 0;
+        UCA0IFG   |= UCTXIFG;
+    }
+    if ( ta1Running() && now >= cyclesAt( ta1Tick() ) )
+    {
+        ta1Ticks = (uint32_t)( ( aclkAt( now ) - ta1Start ) / TIMER_TICK_COUNTS ); // Catch up, without a host
+        lcdWatch();
+        if ( lockstep )
+        {
+            waitForHost = 1;
+        }
+        else if ( pty >= 0 )
+        {
+            pace();
+        }
+    }
+}
+
+static void isr( void ( *routine )( void ) )
+{
+    if ( ( sleepBits & CPUOFF ) && !( routine == Timer_A0 && ( sleepBits & SCG1 ) ) )
+    {                                                                           // Timer_0 counts SMCLK, which LPM3
+        simWakeup();                                                            //  and LPM4 stop on the board
+    }
+    inIsr = 1;
+    gie   = 0;
+    routine();
+    gie   = 1;
+    inIsr = 0;
+}
+
+// Runs the DMA and takes every pending interrupt, until none is left.
+static void processEvents( void )
+{
+    for ( ;; )
+    {
+        if ( DMA0CTL & DMAEN )                                                  // The UART "sends" the block at once
+        {
+            if ( dmaDestination != (uintptr_t)&UCA1TXBUF )                      // The board would write somewhere else,
+            {                                                                   //  and the block would never finish
+                fprintf( stderr, "DMA channel 0 isn't writing to UCA1TXBUF (DMA0DA %#lx)\n",
+                         (unsigned long)dmaDestination );
+                exit( 1 );
+            }
+            hostSend( (const uint8_t *)dmaSource, DMA0SZ );
+            DMA0CTL = ( DMA0CTL & ~DMAEN ) | DMAIFG;
+        }
+        if ( linkTxWritten )
+        {
+            linkSend();
+        }
+        if ( !gie || inIsr )
+        {
+            return;
+        }
+
+        if ( ( DMA0CTL & ( DMAIE | DMAIFG ) ) == ( DMAIE | DMAIFG ) )
+        {
+            DMA0CTL  &= ~DMAIFG;
+            dmaVector = DMAIV_DMA0IFG;
+            isr( DMA_ISR );
+        }
+        else if ( ta0Flag && ( TA0CCTL0 & CCIE ) )
+        {
+            ta0Flag = 0;
+            isr( Timer_A0 );
+        }
+        else if ( ( TA1CCTL0 & ( CCIE | CCIFG ) ) == ( CCIE | CCIFG ) )
+        {
+            TA1CCTL0 &= ~CCIFG;
+            isr( Timer_A1 );
+        }
+#ifdef LINK
+        else if ( linkCount && ( UCA0IE & UCRXIE ) && !link0Flag && linkIn[ linkHead ].at <= now )
+        {
+            link0Buf  = linkIn[ linkHead ].byte;
+            link0Flag = 1;
+            linkHead  = ( linkHead + 1 ) % LINK_BYTES;
+            linkCount--;
+            isr( USCI_A0_ISR );
+        }
+        else if ( ( UCA0IE & UCTXIE ) && ( UCA0IFG & UCTXIFG ) )
+        {
+            isr( USCI_A0_ISR );
+        }
+#endif
+        else if ( rxCount && ( UCA1IE & UCRXIE ) )
+        {
+            rxBuf  = rx[ rxHead++ ];
+            rxFlag = 1;
+            rxCount--;
+            isr( USCI_A1_ISR );
+        }
+        else if ( waitForHost && ( UCA1IE & UCRXIE ) && !remoteQueued )         // Lockstep: nothing queued, so wait
+        {                                                                       //  for the host, until it queues
+            hostReceive( -1 );                                                  //  something
+        }
+        else
+        {
+            waitForHost = waitForHost && !remoteQueued;
+            return;
+        }
+    }
+}
+
+static void moveTo( uint64_t cycles )                                           // Moves time on, counting the charge
+{
+    if ( cycles > now )
+    {
+        simEnergy( (double)( cycles - now ) / MCLK_HZ, sleepBits );
+        now = cycles;
+    }
+}
+
+static void advance( uint64_t cycles )
+{
+    uint64_t target = now + cycles;
+    uint64_t next;
+
+    while ( ( next = nextEvent() ) <= target )
+    {
+        moveTo( linkPace( next ) );
+        fireDue();
+        processEvents();
+    }
+    moveTo( target );
+    processEvents();
+}
+
+//*****************************************************************************
+// Registers with behaviour
+//*****************************************************************************
+uint8_t sim_P1IN( void )
+{
+    advance( POLL_CYCLES );
+    return 0xFF;                                                                // Pull-ups, no button pressed
+}
+
+uint16_t sim_TA0R( void )
+{
+    advance( READ_CYCLES );
+    return (uint16_t)( now / 2 );
+}
+
+uint16_t sim_TA1R( void )
+{
+    advance( READ_CYCLES );
+    if ( !ta1Running() )
+    {
+        return 0;
+    }
+    return (uint16_t)( aclkAt( now ) - ta1Start );
+}
+
+volatile uint16_t *sim_TA1CTL( void )
+{
+    ta1Running();                                                               // Take note of an earlier TACLR
+    return &ta1ctl;
+}
+
+uint16_t sim_SYSRSTIV( void )
+{
+    uint16_t vector = resetVector;
+
+    resetVector = 0;
+    return vector;
+}
+
+uint16_t sim_DMAIV( void )
+{
+    uint16_t vector = dmaVector;
+
+    dmaVector = 0;
+    return vector;
+}
+
+uint16_t sim_UCA1IV( void )
+{
+    return rxFlag ? USCI_UART_UCRXIFG : 0;
+}
+
+uint16_t sim_UCA1RXBUF( void )
+{
+    rxFlag = 0;
+    return rxBuf;
+}
+
+uint16_t sim_UCA0IV( void )
+{
+    if ( link0Flag )
+    {
+        return USCI_UART_UCRXIFG;
+    }
+    if ( ( UCA0IE & UCTXIE ) && ( UCA0IFG & UCTXIFG ) )
+    {
+        UCA0IFG &= ~UCTXIFG;
+        return USCI_UART_UCTXIFG;
+    }
+    return 0;
+}
+
+uint16_t sim_UCA0RXBUF( void )
+{
+    link0Flag = 0;
+    return link0Buf;
+}
+
+volatile uint16_t *sim_UCA0TXBUF( void )
+{
+    linkTxWritten = 1;                                                          // Sent at the next register access
+    return &linkTxBuf;
+}
+
+static void crcUpdate( void )                                                   // CRC-CCITT, low byte first
+{
+    int bit;
+
+    crcPending = 0;
+    for ( bit = 0; bit < 16; bit++ )
+    {
+        uint16_t in = ( ( bit < 8 ? crcInput >> ( 7 - bit ) : crcInput >> ( 23 - bit ) ) & 1 );
+
+        crcResult = ( crcResult << 1 ) ^ ( ( ( crcResult >> 15 ) ^ in ) ? 0x1021 : 0 );
+    }
+}
+
+volatile uint16_t *sim_CRCINIRES( void )
+{
+    if ( crcPending )
+    {
+        crcUpdate();
+    }
+    return &crcResult;
+}
+
+volatile uint16_t *sim_CRCDI( void )
+{
+    if ( crcPending )
+    {
+        crcUpdate();
+    }
+    crcPending = 1;                                                             // Processed at the next CRC access
+    return &crcInput;
+}
+
+//*****************************************************************************
+// Intrinsics
+//*****************************************************************************
+void sim_bisSR( uint16_t bits )
+{
+    gie = gie || ( bits & GIE );
+    processEvents();
+    if ( !( bits & CPUOFF ) )
+    {
+        return;
+    }
+
+    woken     = 0;                                                              // Sleep until an ISR wakes us
+    sleepBits = bits;
+    while ( !woken )
+    {
+        moveTo( linkPace( nextEvent() ) );
+        fireDue();
+        processEvents();
+    }
+    sleepBits = 0;
+}
+
+void sim_bicSROnExit( uint16_t bits )
+{
+    woken = woken || ( bits & CPUOFF );
+}
+
+uint16_t sim_getInterruptState( void )
+{
+    return gie ? GIE : 0;
+}
+
+void sim_setInterruptState( uint16_t state )
+{
+    gie = ( state & GIE ) != 0;
+    processEvents();
+}
+
+// __data16_write_addr(), for the DMA's 20-bit address registers. The
+// firmware passes the register's address cut to 16 bits, as on the board,
+// so the register is told by its name in the call.
+void sim_writeAddr( const char *reg, uintptr_t address )
+{
+    if ( strstr( reg, "DMA0SA" ) )
+    {
+        dmaSource = address;
+    }
+    else if ( strstr( reg, "DMA0DA" ) )
+    {
+        dmaDestination = address;
+    }
+    else
+    {
+        fprintf( stderr, "__data16_write_addr() to a register the simulator doesn't have\n" );
+        exit( 1 );
+    }
+}
+
+
+//*****************************************************************************
+// main()
+//*****************************************************************************
+#ifndef FUZZ
+static void openPty( void )
+{
+    struct termios tio;
+    int slave;
+
+    pty = posix_openpt( O_RDWR | O_NOCTTY );
+    if ( pty < 0 || grantpt( pty ) || unlockpt( pty ) )
+    {
+        perror( "pty" );
+        exit( 1 );
+    }
+    slave = open( ptsname( pty ), O_RDWR | O_NOCTTY );                           // Keep the slave open, so the master
+    if ( slave < 0 )                                                            //  works while no host has it open
+    {
+        perror( "pty" );
+        exit( 1 );
+    }
+    if ( tcgetattr( slave, &tio ) == 0 )
+    {
+        cfmakeraw( &tio );
+        tcsetattr( slave, TCSANOW, &tio );
+    }
+    fcntl( pty, F_SETFL, fcntl( pty, F_GETFL ) | O_NONBLOCK );
+}
+
+static void openLink( void )                                                    // Forks board B
+{
+    int             fds[2];
+    int             ptyA, ptyB;
+    pid_t           child;
+    struct timespec late = { 0, PAIR_LATE_MS * 1000000L };
+
+    openPty();
+    ptyA = pty;
+    openPty();
+    ptyB = pty;
+    if ( socketpair( AF_UNIX, SOCK_SEQPACKET, 0, fds ) )
+    {
+        perror( "socketpair" );
+        exit( 1 );
+    }
+    printf( "%s\n", ptsname( ptyA ) );                                          // ptsname() has one buffer
+    printf( "%s\n", ptsname( ptyB ) );
+    fflush( stdout );
+    clock_gettime( CLOCK_MONOTONIC, &start );                                   // Board A's start
+
+    child = fork();
+    if ( child < 0 )
+    {
+        perror( "fork" );
+        exit( 1 );
+    }
+    pty    = child ? ptyA : ptyB;
+    linkFd = child ? fds[0] : fds[1];
+    close( child ? fds[1] : fds[0] );
+    paired = 1;
+    if ( !child )
+    {
+        prctl( PR_SET_PDEATHSIG, SIGTERM );                                     // Board B stops with board A
+        nanosleep( &late, NULL );
+        linkEpoch = wallCycles();
+        clock_gettime( CLOCK_MONOTONIC, &start );
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    int k, verify = -1, statistics = 0, players = 0;
+
+    for ( k = 1; k < argc; k++ )
+    {
+        if ( strcmp( argv[k], "--lockstep" ) == 0 )
+        {
+            lockstep = 1;
+        }
+        else if ( strcmp( argv[k], "--lcd" ) == 0 && k + 1 < argc )
+        {
+            openLcdFile( argv[ ++k ] );
+        }
+#ifdef LINK
+        else if ( strcmp( argv[k], "--pair" ) == 0 )
+        {
+            paired = 1;
+        }
+#endif
+        else if ( strcmp( argv[k], "--energy" ) == 0 )
+        {
+            simEnergyReport( ( k + 1 < argc && atof( argv[ k + 1 ] ) > 0 ) ? atof( argv[ ++k ] ) : 225 );
+        }
+        else if ( strcmp( argv[k], "--verify" ) == 0 )
+        {
+            verify = ( k + 1 < argc && atoi( argv[ k + 1 ] ) > 0 ) ? atoi( argv[ ++k ] ) : 0;
+        }
+        else if ( strcmp( argv[k], "--random" ) == 0 )
+        {
+            statistics = 1;
+        }
+        else if ( strcmp( argv[k], "--adaptive" ) == 0 )
+        {
+            players = 1;
+        }
+        else
+        {
+            fprintf( stderr, "usage: %s [--lockstep] [--lcd frames.lcd] [--energy [mAh]] [--pair] [--verify [workers]] [--random] [--adaptive]\n",
+                     argv[0] );
+            return 2;
+        }
+    }
+    if ( paired && ( lockstep || lcdFile ) )
+    {
+        fprintf( stderr, "%s: --pair runs in real time, and has no --lcd\n", argv[0] );
+        return 2;
+    }
+    if ( verify >= 0 )
+    {
+        return simVerify( verify );
+    }
+    if ( statistics )
+    {
+        return simRandom();
+    }
+    if ( players )
+    {
+        return simAdaptive();
+    }
+    signal( SIGINT, stop );
+    signal( SIGTERM, stop );
+
+    UCA0IFG = UCTXIFG;                                                          // As after a reset
+    if ( paired )
+    {
+        openLink();
+    }
+    else
+    {
+        openPty();
+        printf( "%s\n", ptsname( pty ) );
+        fflush( stdout );
+        clock_gettime( CLOCK_MONOTONIC, &start );
+    }
+
+    firmware_main();
+    return 0;
+}
+#endif
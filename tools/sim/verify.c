@@ -0,0 +1,362 @@
+// ----------------------------------------------------------------------------
+// verify.c  (simulated board)
+//
+// Checks the rules of the game (myGame.c) against every sequence a normal
+// game can have and every single mistake in it:
+//
+//    ./simboard --verify [workers]
+//
+// With two buttons and GAME_ROUNDS rounds there are 2^16 sequences. Seeds
+// are 32 bits, so the checker looks for the first seed that makes each
+// one, straight from Random_at(), and fills the FRAM store from it with
+// Sequence_fill() as a game does. For each sequence, as a normal game and
+// as an endless one, it plays every round right and, from the start of
+// each round, every wrong press and every timeout at every step of it. It
+// checks the result of each press, the score, that the game is over after
+// a mistake and only then, that a normal game stops after GAME_ROUNDS
+// rounds and an endless one doesn't, and that only a perfect normal game
+// is won. A game resumed at a round (a checkpoint) must be the same as
+// one played up to it.
+//
+// Each round's mistakes start from a copy of the game at the start of the
+// round, so the rounds before it are played once, not once per mistake.
+//
+// The sequences are shared out between worker processes, one per CPU
+// unless given, each with its own copy of the firmware's variables. Each
+// worker takes chunks from the front of its own share, and when that runs
+// out it takes the back half of the largest share left. It takes a few
+// seconds, and exits with 1 if anything failed, so it can run on every
+// commit.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "../../myGame.h"
+#include "../../mySequence.h"
+#include "../../myRandom.h"
+
+#define SEQUENCES           ( 1UL << GAME_ROUNDS )                              // Normal games, with two buttons
+#define WORKERS_MAX         64
+#define CHUNK               64                                                  // Sequences a worker takes at a time
+#define FAILURES_SHOWN      10
+
+#define MISTAKE_WRONG       0
+#define MISTAKE_TIMEOUT     1
+
+typedef struct
+{
+    volatile char  lock;
+    unsigned long  head, tail;                                                  // Sequences [head, tail) are left to do
+    unsigned long  steals;                                                      // Chunks this worker took from others
+} Share;
+
+typedef struct
+{
+    Share          share[ WORKERS_MAX ];
+    unsigned long  patterns;                                                    // Input patterns checked
+    unsigned long  failures;
+} Shared;
+
+static Shared   *shared;
+static int       workers;
+static uint32_t  seedOf[ SEQUENCES ];                                           // First seed that makes each sequence
+
+
+// Step k of sequence p
+static unsigned int step( unsigned long p, unsigned int k )
+{
+    return ( p >> k ) & 1;
+}
+
+static void fail( unsigned long p, int endless, unsigned int round, const char *what )
+{
+    if ( __atomic_fetch_add( &shared->failures, 1, __ATOMIC_RELAXED ) < FAILURES_SHOWN )
+    {
+        fprintf( stderr, "verify: seed 0x%08lX (sequence 0x%04lX), %s game, round %u: %s\n",
+                 (unsigned long)seedOf[p], p, endless ? "endless" : "normal", round + 1, what );
+    }
+}
+
+// Looks for a seed for each sequence, in order from 0
+static unsigned long findSeeds( void )
+{
+    static uint8_t found[ SEQUENCES ];
+    unsigned long  left = SEQUENCES, p;
+    uint32_t       seed;
+    unsigned int   k;
+
+    for ( seed = 0; left; seed++ )
+    {
+        for ( p = 0, k = 0; k < GAME_ROUNDS; k++ )
+        {
+            p |= (unsigned long)( Random_at( seed, k ) >> ( 32 - SEQUENCE_BITS ) ) << k;
+        }
+        if ( !found[p] )
+        {
+            found[p] = 1;
+            seedOf[p] = seed;
+            left--;
+        }
+    }
+    return seed - 1;
+}
+
+// Checks what any mistake leaves behind
+static void checkOver( Game *game, unsigned long p, unsigned int round, const char *mistake )
+{
+    char what[ 160 ];
+
+    if ( !game->over || Game_playing( game ) || Game_won( game ) || game->score != round
+         || Game_press( game, step( p, 0 ) ) != GAME_WRONG )
+    {
+        snprintf( what, sizeof( what ), "%s: over %d, playing %d, won %d, score %u", mistake,
+                  game->over, Game_playing( game ), Game_won( game ), game->score );
+        fail( p, game->endless, round, what );
+    }
+}
+
+// Plays round r right up to step k, then makes a mistake there
+static void playMistake( Game game, unsigned long p, unsigned int r, unsigned int k, int mistake )
+{
+    char         what[ 80 ];
+    unsigned int j;
+
+    Game_begin( &game );
+    for ( j = 0; j < k; j++ )
+    {
+        if ( Game_press( &game, step( p, j ) ) != GAME_RIGHT )
+        {
+            fail( p, game.endless, r, "a right press before the last step wasn't GAME_RIGHT" );
+            return;
+        }
+    }
+    if ( mistake == MISTAKE_WRONG )
+    {
+        snprintf( what, sizeof( what ), "wrong press at step %u", k + 1 );
+        if ( Game_press( &game, !step( p, k ) ) != GAME_WRONG )
+        {
+            fail( p, game.endless, r, what );
+        }
+    }
+    else
+    {
+        snprintf( what, sizeof( what ), "timeout at step %u", k + 1 );
+        Game_timeout( &game );
+    }
+    checkOver( &game, p, r, what );
+}
+
+// Plays sequence p right to the end, with every single mistake on the way;
+// returns the patterns played
+static unsigned long playSequence( unsigned long p, int endless )
+{
+    Game          game, resumed;
+    unsigned int  r, k;
+    unsigned long patterns = 1;
+    int           result;
+
+    Game_start( &game, 0, 0, endless );
+    for ( r = 0; r < GAME_ROUNDS; r++ )
+    {
+        Game_start( &resumed, r, r, endless );
+        if ( resumed.round != game.round || resumed.score != game.score || resumed.over != game.over
+             || resumed.endless != game.endless || !Game_playing( &game ) )
+        {
+            fail( p, endless, r, "the game at the start of the round isn't a resumed one" );
+        }
+        for ( k = 0; k <= r; k++ )
+        {
+            playMistake( game, p, r, k, MISTAKE_WRONG );
+            playMistake( game, p, r, k, MISTAKE_TIMEOUT );
+            patterns += 2;
+        }
+
+        Game_begin( &game );
+        for ( k = 0; k <= r; k++ )
+        {
+            result = Game_press( &game, step( p, k ) );
+            if ( result != ( k < r ? GAME_RIGHT : GAME_ROUND_DONE ) )
+            {
+                fail( p, endless, r, "a right press got the wrong result" );
+                return patterns;
+            }
+        }
+        if ( game.over || game.score != r + 1 || game.round != r + 1
+             || Game_playing( &game ) != ( endless || r + 1 < GAME_ROUNDS )
+             || Game_won( &game ) != ( !endless && r + 1 == GAME_ROUNDS ) )
+        {
+            fail( p, endless, r, "wrong state after the round was answered" );
+        }
+    }
+    return patterns;
+}
+
+static void checkSequence( unsigned long p )
+{
+    unsigned long patterns;
+    unsigned int  k;
+    char          what[ 80 ];
+
+    Sequence_fill( seedOf[p] );                                                 // As a game does
+    for ( k = 0; k < GAME_ROUNDS; k++ )
+    {
+        if ( Sequence_get( k ) != step( p, k ) )
+        {
+            snprintf( what, sizeof( what ), "the store has the wrong step %u", k + 1 );
+            fail( p, 0, 0, what );
+            return;
+        }
+    }
+    patterns = playSequence( p, 0 ) + playSequence( p, 1 );
+    __atomic_fetch_add( &shared->patterns, patterns, __ATOMIC_RELAXED );
+}
+
+static void lock( Share *s )
+{
+    while ( __atomic_test_and_set( &s->lock, __ATOMIC_ACQUIRE ) )
+    {
+        sched_yield();                                                          // The holder may be waiting for this CPU
+    }
+}
+
+static void unlock( Share *s )
+{
+    __atomic_clear( &s->lock, __ATOMIC_RELEASE );
+}
+
+// Takes the next chunk of worker w's share, or steals half of the largest
+// share left. Returns 0 when there is nothing left anywhere.
+static int take( int w, unsigned long *first, unsigned long *last )
+{
+    Share        *own = &shared->share[w], *victim;
+    unsigned long most, left, half, from;
+    int           v, best;
+
+    for ( ;; )
+    {
+        lock( own );
+        if ( own->head < own->tail )
+        {
+            *first = own->head;
+            own->head = own->head + CHUNK < own->tail ? own->head + CHUNK : own->tail;
+            *last = own->head;
+            unlock( own );
+            return 1;
+        }
+        unlock( own );
+
+        for ( best = -1, most = 0, v = 0; v < workers; v++ )                    // A rough look, without the locks
+        {
+            victim = &shared->share[v];
+            left = victim->tail - victim->head;
+            if ( v != w && victim->head < victim->tail && left > most )
+            {
+                best = v;
+                most = left;
+            }
+        }
+        if ( best < 0 )
+        {
+            return 0;
+        }
+
+        victim = &shared->share[ best ];
+        lock( victim );
+        left = victim->head < victim->tail ? victim->tail - victim->head : 0;
+        half = left > CHUNK ? left / 2 : left;
+        victim->tail -= half;
+        from = victim->tail;
+        unlock( victim );
+        if ( half )
+        {
+            lock( own );
+            own->head = from;
+            own->tail = from + half;
+            own->steals++;
+            unlock( own );
+        }
+    }
+}
+
+static void work( int w )
+{
+    unsigned long first, last;
+
+    while ( take( w, &first, &last ) )
+    {
+        for ( ; first < last; first++ )
+        {
+            checkSequence( first );
+        }
+    }
+}
+
+int simVerify( int wanted )
+{
+    struct timespec start, end;
+    unsigned long   lastSeed, steals = 0;
+    int             w, status, ok = 1;
+    pid_t           pid[ WORKERS_MAX ];
+
+    if ( SEQUENCE_SYMBOLS != 2 )
+    {
+        fprintf( stderr, "verify: only checks the LaunchPad's two buttons (SEQUENCE_SYMBOLS 2)\n" );
+        return 2;
+    }
+    workers = wanted > 0 ? wanted : (int)sysconf( _SC_NPROCESSORS_ONLN );
+    workers = workers < 1 ? 1 : workers > WORKERS_MAX ? WORKERS_MAX : workers;
+    shared = mmap( NULL, sizeof( Shared ), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+    if ( shared == MAP_FAILED )
+    {
+        perror( "verify: mmap" );
+        return 2;
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    lastSeed = findSeeds();
+    for ( w = 0; w < workers; w++ )                                             // Even shares to start with
+    {
+        shared->share[w].head = SEQUENCES * w / workers;
+        shared->share[w].tail = SEQUENCES * ( w + 1 ) / workers;
+    }
+    fflush( stdout );
+    for ( w = 0; w < workers; w++ )
+    {
+        pid[w] = fork();
+        if ( pid[w] == 0 )
+        {
+            work( w );
+            _exit( 0 );
+        }
+        if ( pid[w] < 0 )
+        {
+            perror( "verify: fork" );
+            work( w );                                                          // The others will steal the rest
+        }
+    }
+    for ( w = 0; w < workers; w++ )
+    {
+        if ( pid[w] > 0 && ( waitpid( pid[w], &status, 0 ) < 0 || !WIFEXITED( status ) || WEXITSTATUS( status ) ) )
+        {
+            ok = 0;
+        }
+        steals += shared->share[w].steals;
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+
+    printf( "verify: %lu sequences (seeds 0 to %lu), %lu patterns, %lu failed, in %.2fs on %d worker%s (%lu steals)\n",
+            SEQUENCES, lastSeed, shared->patterns, shared->failures,
+            ( end.tv_sec - start.tv_sec ) + ( end.tv_nsec - start.tv_nsec ) / 1e9,
+            workers, workers == 1 ? "" : "s", steals );
+    if ( !ok )
+    {
+        fprintf( stderr, "verify: a worker didn't finish\n" );
+    }
+    return ok && shared->failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,482 @@
+// ----------------------------------------------------------------------------
+// size.c  (host tool)
+//
+// Reports where the firmware's RAM and FRAM go, from the map file the TI
+// linker writes next to the .out file, and checks the sizes against a
+// budget.
+//
+//    cc -O2 -o size tools/size.c
+//    ./size Debug/Flashing-LEDs-Game.map tools/budget.txt
+//    ./size --symbols 40 Debug/Flashing-LEDs-Game.map
+//
+// To check every build, add it to the CCS project as a post-build step
+// (Properties, Build, Steps). A step that exits with an error fails the
+// build, and this one does when a budget is exceeded:
+//
+//    ${PROJECT_ROOT}/tools/size ${BuildArtifactFileBaseName}.map ${PROJECT_ROOT}/tools/budget.txt
+//
+// It prints the memory ranges of the linker command file, the output
+// sections and where each one is loaded and runs (.TI.ramfunc is loaded in
+// FRAM and runs in RAM, so it counts in both), the bytes of each module
+// (object file, or library) in RAM and in FRAM, and the largest symbols.
+// Symbols are the names of the input sections: the compiler puts each
+// function and variable in its own subsection, such as .text:main or
+// .bss:txRing. Gaps the linker left for alignment are counted as padding.
+//
+// The stack is the size the project reserves for it (.stack). How deep it
+// really goes is only known at run time.
+//
+// A budget file has one limit per line, as a name and the most bytes it may
+// use; '#' starts a comment. The name is a memory range (RAM, FRAM), an
+// output section (.bss, .text) or a module (main.obj, driverlib.lib).
+// Every build configuration is checked against the same file, so leave room
+// for the buffers the Bench and Profile builds add.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NAME_MAX_CHARS  80
+#define RANGES_MAX      128
+#define SECTIONS_MAX    256
+#define MODULES_MAX     256
+#define SYMBOLS_MAX     4096
+#define SYMBOLS_SHOWN   20                                                      // Default for --symbols
+
+enum { KIND_RAM, KIND_FRAM, KIND_OTHER, KINDS };                                // Columns of the module table
+
+typedef struct
+{
+    char          name[ NAME_MAX_CHARS ];
+    unsigned long origin, length, used;
+} Range;
+
+typedef struct
+{
+    char          name[ NAME_MAX_CHARS ];
+    unsigned long origin, size;
+    unsigned long run;                                                          // Run address, if not the load address
+    int           hasRun, uninitialized;
+} Section;
+
+typedef struct
+{
+    char          name[ NAME_MAX_CHARS ];
+    unsigned long bytes[ KINDS ];
+} Module;
+
+typedef struct
+{
+    char          name[ NAME_MAX_CHARS ];
+    char          module[ NAME_MAX_CHARS ];
+    const char   *section;                                                      // Output section
+    unsigned long address, size;
+} Symbol;
+
+static Range   ranges[ RANGES_MAX ];
+static int     rangeCount = 0;
+static Section sections[ SECTIONS_MAX ];
+static int     sectionCount = 0;
+static Module  modules[ MODULES_MAX ];
+static int     moduleCount = 0;
+static Symbol  symbols[ SYMBOLS_MAX ];
+static int     symbolCount = 0;
+
+
+static void copyName( char *to, const char *from, size_t length )
+{
+    if ( length >= NAME_MAX_CHARS )
+    {
+        length = NAME_MAX_CHARS - 1;
+    }
+    memcpy( to, from, length );
+    to[ length ] = 0;
+}
+
+static Range *rangeAt( unsigned long address )
+{
+    int k;
+
+    for ( k = 0; k < rangeCount; k++ )
+    {
+        if ( address >= ranges[k].origin && address < ranges[k].origin + ranges[k].length )
+        {
+            return &ranges[k];
+        }
+    }
+    return NULL;
+}
+
+static const char *rangeName( unsigned long address )
+{
+    const Range *r = rangeAt( address );
+
+    return r ? r->name : "?";
+}
+
+static int kindOf( unsigned long address )
+{
+    const Range *r = rangeAt( address );
+
+    if ( r && strncmp( r->name, "RAM", 3 ) == 0 )
+    {
+        return KIND_RAM;
+    }
+    if ( r && strncmp( r->name, "FRAM", 4 ) == 0 )
+    {
+        return KIND_FRAM;
+    }
+    return KIND_OTHER;
+}
+
+static Module *module( const char *name )
+{
+    int k;
+
+    for ( k = 0; k < moduleCount && strcmp( modules[k].name, name ) != 0; k++ );
+    if ( k == moduleCount && moduleCount < MODULES_MAX )
+    {
+        memset( &modules[k], 0, sizeof( Module ) );
+        copyName( modules[k].name, name, strlen( name ) );
+        moduleCount++;
+    }
+    return k < moduleCount ? &modules[k] : NULL;
+}
+
+// Adds one input section line: "address size module (section:symbol)".
+static void addInput( const Section *out, unsigned long address, unsigned long size, const char *text )
+{
+    char        name[ NAME_MAX_CHARS ], sub[ NAME_MAX_CHARS ];
+    const char *paren = strstr( text, " (" );
+    const char *colon, *slash;
+    Module     *m;
+
+    if ( size == 0 )
+    {
+        return;
+    }
+    sub[0] = 0;
+    if ( strncmp( text, "--HOLE--", 8 ) == 0 )
+    {
+        strcpy( name, "(padding)" );
+    }
+    else if ( strncmp( text, "(.common:", 9 ) == 0 )                            // Globals that weren't given a
+    {                                                                           //  subsection of .bss
+        strcpy( name, "(common)" );
+        paren = text - 1;
+    }
+    else if ( text[0] == '(' )                                                  // Made by the linker: copy tables,
+    {                                                                           //  compressed .cinit images
+        strcpy( name, "(linker)" );
+        paren = text - 1;
+    }
+    else
+    {
+        colon = strstr( text, " : " );                                          // "library.lib : member.obj"
+        copyName( name, text, colon ? (size_t)( colon - text ) : paren ? (size_t)( paren - text ) : strlen( text ) );
+        for ( slash = name; strpbrk( slash, "/\\" ); slash = strpbrk( slash, "/\\" ) + 1 );
+        memmove( name, slash, strlen( slash ) + 1 );
+    }
+    if ( paren && paren[1] == '(' )                                             // The input section, for the symbol
+    {
+        const char *end = strchr( paren + 2, ')' );
+
+        copyName( sub, paren + 2, end ? (size_t)( end - paren - 2 ) : strlen( paren + 2 ) );
+    }
+
+    m = module( name );
+    if ( !m )
+    {
+        return;
+    }
+    m->bytes[ kindOf( address ) ] += size;
+    if ( out->hasRun )                                                          // A copy runs from somewhere else
+    {
+        m->bytes[ kindOf( out->run + ( address - out->origin ) ) ] += size;
+    }
+
+    if ( symbolCount < SYMBOLS_MAX && strcmp( name, "(padding)" ) != 0 )
+    {
+        Symbol *s = &symbols[ symbolCount++ ];
+
+        colon = strchr( sub, ':' );
+        copyName( s->name, colon ? colon + 1 : sub, strlen( colon ? colon + 1 : sub ) );
+        strcpy( s->module, m->name );
+        s->section = out->name;
+        s->address = out->hasRun ? out->run + ( address - out->origin ) : address;
+        s->size    = size;
+    }
+}
+
+static int startsWith( const char *line, const char *prefix )
+{
+    return strncmp( line, prefix, strlen( prefix ) ) == 0;
+}
+
+// Reads the memory ranges and the section allocation map.
+static int loadMap( const char *file )
+{
+    enum { OTHER, MEMORY, SECTIONS } part = OTHER;
+    FILE    *f = fopen( file, "r" );
+    char     line[ 512 ], name[ NAME_MAX_CHARS * 2 ], pending[ NAME_MAX_CHARS ] = "";
+    Section *out = NULL;
+    int      hasPage = 1, n;
+
+    if ( !f )
+    {
+        perror( file );
+        return 0;
+    }
+    while ( fgets( line, sizeof( line ), f ) )
+    {
+        unsigned long a, b, c;
+        unsigned int  page;
+
+        if ( startsWith( line, "MEMORY CONFIGURATION" ) )
+        {
+            part = MEMORY;
+        }
+        else if ( startsWith( line, "SECTION ALLOCATION MAP" ) )
+        {
+            part = SECTIONS;
+        }
+        else if ( startsWith( line, "MODULE SUMMARY" ) || startsWith( line, "GLOBAL SYMBOLS" ) ||
+                  startsWith( line, "LINKER GENERATED" ) || startsWith( line, "SEGMENT ALLOCATION" ) )
+        {
+            part = OTHER;
+        }
+        else if ( part == MEMORY )
+        {
+            if ( sscanf( line, " %79s %lx %lx %lx", name, &a, &b, &c ) == 4 && rangeCount < RANGES_MAX )
+            {
+                copyName( ranges[ rangeCount ].name, name, strlen( name ) );
+                ranges[ rangeCount ].origin = a;
+                ranges[ rangeCount ].length = b;
+                ranges[ rangeCount ].used   = c;
+                rangeCount++;
+            }
+        }
+        else if ( part == SECTIONS && strstr( line, "input sections" ) )        // The column headings
+        {
+            hasPage = strstr( line, "page" ) != NULL;
+        }
+        else if ( part == SECTIONS && line[0] != ' ' && line[0] != '\n' && line[0] != '-' )
+        {                                                                       // An output section
+            n = hasPage ? sscanf( line, "%159s %u %lx %lx", name, &page, &a, &b )
+                        : sscanf( line, "%159s %lx %lx", name, &a, &b ) + 1;
+            if ( n == 1 )                                                       // A long name, on a line of its own
+            {
+                copyName( pending, name, strlen( name ) );
+            }
+            else if ( n == 4 && sectionCount < SECTIONS_MAX )
+            {
+                const char *run = strstr( line, "RUN ADDR = " );
+
+                out = &sections[ sectionCount++ ];
+                memset( out, 0, sizeof( Section ) );
+                copyName( out->name, strcmp( name, "*" ) == 0 ? pending : name,
+                          strlen( strcmp( name, "*" ) == 0 ? pending : name ) );
+                out->origin        = a;
+                out->size          = b;
+                out->uninitialized = strstr( line, "UNINITIALIZED" ) != NULL;
+                out->hasRun        = run && sscanf( run + 11, "%lx", &out->run ) == 1;
+            }
+        }
+        else if ( part == SECTIONS && out && sscanf( line, " %lx %lx %n", &a, &b, &n ) == 2 )
+        {
+            line[ strcspn( line, "\r\n" ) ] = 0;
+            addInput( out, a, b, line + n );
+        }
+    }
+    fclose( f );
+    if ( rangeCount == 0 || sectionCount == 0 )
+    {
+        fprintf( stderr, "%s: not a TI linker map file (use --map_file, which CCS sets)\n", file );
+        return 0;
+    }
+    return 1;
+}
+
+static int byTotal( const void *a, const void *b )
+{
+    const Module *x = a, *y = b;
+    unsigned long tx = x->bytes[0] + x->bytes[1] + x->bytes[2], ty = y->bytes[0] + y->bytes[1] + y->bytes[2];
+
+    return ( tx < ty ) - ( tx > ty );
+}
+
+static int bySize( const void *a, const void *b )
+{
+    const Symbol *x = a, *y = b;
+
+    return ( x->size < y->size ) - ( x->size > y->size );
+}
+
+static void report( int shown )
+{
+    unsigned long total[ KINDS ] = { 0 };
+    int k, j;
+
+    printf( "%-24s %8s %8s %8s %8s %6s\n", "memory range", "origin", "size", "used", "free", "%" );
+    for ( k = 0; k < rangeCount; k++ )
+    {
+        if ( ranges[k].used && ranges[k].length > 2 )                           // Not the interrupt vectors
+        {
+            printf( "%-24s %8lX %8lu %8lu %8lu %5.1f%%\n", ranges[k].name, ranges[k].origin, ranges[k].length,
+                    ranges[k].used, ranges[k].length - ranges[k].used, 100.0 * ranges[k].used / ranges[k].length );
+        }
+    }
+
+    printf( "\n%-24s %8s %8s  %s\n", "output section", "address", "size", "placement" );
+    for ( k = 0; k < sectionCount; k++ )
+    {
+        const Section *s = &sections[k];
+
+        if ( s->size && s->size > 2 )
+        {
+            printf( "%-24s %8lX %8lu  %s", s->name, s->origin, s->size, rangeName( s->origin ) );
+            if ( s->hasRun )
+            {
+                printf( ", runs in %s at %lX", rangeName( s->run ), s->run );
+            }
+            printf( "%s\n", s->uninitialized ? ", uninitialized" : "" );
+        }
+    }
+
+    qsort( modules, moduleCount, sizeof( Module ), byTotal );
+    printf( "\n%-24s %8s %8s %8s\n", "module", "RAM", "FRAM", "other" );
+    for ( k = 0; k < moduleCount; k++ )
+    {
+        printf( "%-24s %8lu %8lu %8lu\n", modules[k].name, modules[k].bytes[ KIND_RAM ],
+                modules[k].bytes[ KIND_FRAM ], modules[k].bytes[ KIND_OTHER ] );
+        for ( j = 0; j < KINDS; j++ )
+        {
+            total[j] += modules[k].bytes[j];
+        }
+    }
+    printf( "%-24s %8lu %8lu %8lu\n", "total", total[ KIND_RAM ], total[ KIND_FRAM ], total[ KIND_OTHER ] );
+
+    qsort( symbols, symbolCount, sizeof( Symbol ), bySize );
+    printf( "\n%-32s %8s %8s  %-12s %s\n", "largest symbols", "address", "size", "section", "module" );
+    for ( k = 0; k < symbolCount && k < shown; k++ )
+    {
+        printf( "%-32s %8lX %8lu  %-12s %s\n", symbols[k].name[0] ? symbols[k].name : "(whole section)",
+                symbols[k].address, symbols[k].size, symbols[k].section, symbols[k].module );
+    }
+
+    for ( k = 0; k < sectionCount && strcmp( sections[k].name, ".stack" ) != 0; k++ );
+    if ( k < sectionCount )
+    {
+        const Range *r = rangeAt( sections[k].origin );
+
+        printf( "\nstack: %lu bytes reserved in %s, which has %lu bytes unused beyond it\n", sections[k].size,
+                r ? r->name : "?", r ? r->length - r->used : 0 );
+    }
+}
+
+// Checks every line of the budget file. Returns the number exceeded, or -1
+// if the file can't be read.
+static int checkBudget( const char *file )
+{
+    FILE         *f = fopen( file, "r" );
+    char          line[ 256 ], name[ NAME_MAX_CHARS ];
+    unsigned long limit, used;
+    int           k, over = 0, found, lineNumber = 0;
+
+    if ( !f )
+    {
+        perror( file );
+        return -1;
+    }
+    printf( "\n%-24s %8s %8s\n", "budget", "used", "limit" );
+    while ( fgets( line, sizeof( line ), f ) )
+    {
+        lineNumber++;
+        line[ strcspn( line, "#" ) ] = 0;
+        if ( sscanf( line, "%79s", name ) != 1 )
+        {
+            continue;
+        }
+        if ( sscanf( line, "%*s %li", (long *)&limit ) != 1 )
+        {
+            fprintf( stderr, "%s:%d: expected a name and a size\n", file, lineNumber );
+            over++;
+            continue;
+        }
+
+        used  = 0;
+        found = 0;
+        for ( k = 0; k < rangeCount; k++ )
+        {
+            if ( strcmp( ranges[k].name, name ) == 0 )
+            {
+                used += ranges[k].used;
+                found = 1;
+            }
+        }
+        for ( k = 0; k < sectionCount; k++ )
+        {
+            if ( strcmp( sections[k].name, name ) == 0 )
+            {
+                used += sections[k].size;
+                found = 1;
+            }
+        }
+        for ( k = 0; k < moduleCount; k++ )
+        {
+            if ( strcmp( modules[k].name, name ) == 0 )
+            {
+                used += modules[k].bytes[0] + modules[k].bytes[1] + modules[k].bytes[2];
+                found = 1;
+            }
+        }
+
+        if ( !found )                                                           // Nothing there yet: that fits
+        {
+            printf( "%-24s %8s %8lu\n", name, "-", limit );
+        }
+        else
+        {
+            printf( "%-24s %8lu %8lu%s\n", name, used, limit, used > limit ? "  OVER BUDGET" : "" );
+            over += used > limit;
+        }
+    }
+    fclose( f );
+    return over;
+}
+
+int main( int argc, char *argv[] )
+{
+    int shown = SYMBOLS_SHOWN, over = 0;
+    int k = 1;
+
+    if ( k + 1 < argc && strcmp( argv[k], "--symbols" ) == 0 )
+    {
+        shown = atoi( argv[ k + 1 ] );
+        k += 2;
+    }
+    if ( argc - k < 1 || argc - k > 2 )
+    {
+        fprintf( stderr, "usage: %s [--symbols N] firmware.map [budget.txt]\n", argv[0] );
+        return 2;
+    }
+    if ( !loadMap( argv[k] ) )
+    {
+        return 2;
+    }
+    report( shown );
+    if ( argc - k == 2 )
+    {
+        over = checkBudget( argv[ k + 1 ] );
+        if ( over < 0 )
+        {
+            return 2;
+        }
+        if ( over )
+        {
+            fprintf( stderr, "size: %d budget(s) exceeded, see %s\n", over, argv[ k + 1 ] );
+        }
+    }
+    return over ? 1 : 0;
+}
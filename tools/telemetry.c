@@ -0,0 +1,325 @@
+// ----------------------------------------------------------------------------
+// telemetry.c  (host tool)
+//
+// Reads the game's telemetry stream from the LaunchPad's backchannel UART
+// and prints one line per frame.
+//
+//    cc -O2 -o telemetry tools/telemetry.c
+//    ./telemetry /dev/ttyACM1          (the eZ-FET's "UART" port)
+//    ./telemetry --pty
+//
+// With --pty no board is needed: the tool opens a pseudo-terminal, prints
+// the name of its slave side and reads whatever is written there, so a
+// simulated board or a script can stand in for the LaunchPad.
+//
+// Frames are COBS-encoded and end with 0x00 (see myUart.c). The frame
+// layouts are listed in myTelemetry.h. Bytes before the first 0x00 are
+// skipped, since the reader may have started in the middle of a frame.
+// ----------------------------------------------------------------------------
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "lcd.h"
+
+#define FRAME_MAX       256
+
+// Keep in step with myTelemetry.h
+enum { HELLO, GAME, PRESS, TRACE, COUNTER, STATE, LCD, SEED, BENCH, PROFILE, ISR, RACE };
+
+// Keep in step with the event IDs in myTrace.h
+static const char *eventName[] =
+{
+    "NONE", "BOOT", "CLOCKS", "GAME_START", "RESUME", "ROUND", "LED",
+    "BUTTON_DOWN", "BUTTON_UP", "TIMEOUT", "GAME_OVER", "LCD_WORD",
+    "LCD_NUMBER", "LCD_SCROLL", "SLEEP", "WAKE", "PHASE", "STACK",
+    "ISR_TIME", "ISR_LATENCY", "LOST"
+};
+#define EVENTS          ( sizeof( eventName ) / sizeof( eventName[0] ) )
+
+static const char *levelName[]   = { "EASY", "NORMAL", "HARD" };
+static const char *raceResult[]  = { "no race", "won", "lost", "tied" };          // LINK_xxx in myLink.h
+static const char *counterName[] =
+{
+    "checkpoint cycles", "UART frames dropped", "profile samples", "profile outside", "stack used", "stack size"
+};
+#define COUNTERS        ( sizeof( counterName ) / sizeof( counterName[0] ) )
+
+// Keep in step with the ISR IDs in myIsr.h
+static const char *isrName[] = { "Timer_0", "Timer_1", "Port_1", "UART", "DMA", "Link" };
+#define ISRS            ( sizeof( isrName ) / sizeof( isrName[0] ) )
+
+// Keep in step with the benchmark IDs in myBench.h
+static const char *benchName[] =
+{
+    "overhead", "myLCD_showChar", "DisplayWord", "DisplayNumber",
+    "myLCD_displayNumber", "myLCD_showSymbol", "clearLCD", "ScrollFrame",
+    "burst render", "Message_showGlyph", "Message_scroll", "message burst",
+    "Sequence 1 bit", "Sequence 2 bit", "Sequence 3 bit"
+};
+#define BENCHES         ( sizeof( benchName ) / sizeof( benchName[0] ) )
+
+static unsigned int smclkKhz = 2000;                                            // Until a HELLO frame says otherwise
+static unsigned int mclkKhz  = 4000;
+static int          expected = -1;                                              // Next sequence number
+
+
+static uint16_t get16( const uint8_t *p )
+{
+    return (uint16_t)( p[0] | ( p[1] << 8 ) );
+}
+
+// Decodes a COBS frame (without its 0x00) in place. Returns the decoded
+// length, or -1 if the frame is malformed.
+static int cobsDecode( uint8_t *buf, int length )
+{
+    int in = 0, out = 0;
+
+    while ( in < length )
+    {
+        int code = buf[in++];
+        int k;
+
+        if ( code == 0 || in + code - 1 > length )
+        {
+            return -1;
+        }
+        for ( k = 1; k < code; k++ )
+        {
+            buf[out++] = buf[in++];
+        }
+        if ( code < 0xFF && in < length )                                       // A run shorter than 254 ended in a zero
+        {
+            buf[out++] = 0;
+        }
+    }
+    return out;
+}
+
+static void printFrame( const uint8_t *f, int length )
+{
+    LcdText       text;
+    unsigned long median, runs, total;
+    int           k;
+
+    if ( length < 2 )
+    {
+        printf( "short frame\n" );
+        return;
+    }
+    if ( expected >= 0 && f[1] != expected && f[0] != HELLO )
+    {
+        printf( "-- %u frame(s) dropped\n", (uint8_t)( f[1] - expected ) );
+    }
+    expected = (uint8_t)( f[1] + 1 );
+
+    switch ( f[0] )
+    {
+    case HELLO:
+        if ( length < 7 ) break;
+        smclkKhz = get16( f + 3 ) ? get16( f + 3 ) : smclkKhz;
+        mclkKhz  = ( length >= 9 && get16( f + 7 ) ) ? get16( f + 7 ) : mclkKhz;  // From version 2
+        printf( "HELLO    version %u, SMCLK %u kHz, MCLK %u kHz, reset reason 0x%04X\n", f[2], smclkKhz, mclkKhz,
+                get16( f + 5 ) );
+        return;
+    case GAME:
+        if ( length < 7 ) break;
+        printf( "GAME     score %u, %s%s", get16( f + 2 ), f[4] < 3 ? levelName[ f[4] ] : "?", f[5] ? " endless" : "" );
+        if ( (int8_t)f[6] >= 0 )
+        {
+            printf( ", high score #%d", f[6] + 1 );
+        }
+        printf( "\n" );
+        return;
+    case PRESS:
+        if ( length < 7 ) break;
+        printf( "PRESS    round %u, %u ms, %s\n", get16( f + 2 ) + 1, get16( f + 4 ) * 10, f[6] ? "right" : "wrong" );
+        return;
+    case TRACE:
+        if ( ( length - 2 ) % 8 ) break;
+        for ( k = 2; k < length; k += 8 )
+        {
+            uint32_t stamp = ( (uint32_t)get16( f + k + 2 ) << 16 ) | get16( f + k );
+            unsigned int id = get16( f + k + 4 );
+
+            printf( "TRACE    %10.3f ms  %-12s %u\n", (double)stamp / smclkKhz,
+                    id < EVENTS ? eventName[id] : "?", get16( f + k + 6 ) );
+        }
+        return;
+    case COUNTER:
+        if ( length < 7 ) break;
+        printf( "COUNTER  %s = %lu\n", f[2] < COUNTERS ? counterName[ f[2] ] : "?",
+                (unsigned long)get16( f + 3 ) | ( (unsigned long)get16( f + 5 ) << 16 ) );
+        return;
+    case STATE:
+        if ( length < 9 ) break;
+        printf( "STATE    leds %s%s, buttons %s%s, %u free, TA0R %u, epoch %u\n",
+                f[2] & 1 ? "R" : "-", f[2] & 2 ? "G" : "-", f[3] & 1 ? "1" : "-", f[3] & 2 ? "2" : "-",
+                f[4], get16( f + 5 ), get16( f + 7 ) );
+        return;
+    case SEED:
+        if ( length < 7 ) break;
+        printf( "SEED     0x%08lX%s\n", (unsigned long)get16( f + 2 ) | ( (unsigned long)get16( f + 4 ) << 16 ),
+                f[6] ? " endless" : "" );
+        return;
+    case BENCH:
+        if ( length < 17 ) break;
+        median = (unsigned long)get16( f + 9 ) | ( (unsigned long)get16( f + 11 ) << 16 );
+        printf( "BENCH    %-20s %3u runs, cycles min %lu, median %lu (%.1f us), max %lu\n",
+                f[2] < BENCHES ? benchName[ f[2] ] : "?", get16( f + 3 ),
+                (unsigned long)get16( f + 5 ) | ( (unsigned long)get16( f + 7 ) << 16 ),
+                median, 1000.0 * median / mclkKhz,
+                (unsigned long)get16( f + 13 ) | ( (unsigned long)get16( f + 15 ) << 16 ) );
+        return;
+    case ISR:                                                                   // Times in Timer_0 (SMCLK) counts
+        if ( length < 16 ) break;
+        runs  = (unsigned long)get16( f + 4 ) | ( (unsigned long)get16( f + 6 ) << 16 );
+        total = (unsigned long)get16( f + 8 ) | ( (unsigned long)get16( f + 10 ) << 16 );
+        printf( "ISR      %-8s %lu runs, cycles mean %.0f, max %.0f, nesting %u", f[2] < ISRS ? isrName[ f[2] ] : "?",
+                runs, runs ? (double)total * mclkKhz / smclkKhz / runs : 0.0,
+                (double)get16( f + 12 ) * mclkKhz / smclkKhz, f[3] );
+        if ( get16( f + 14 ) )                                                  // Only known for Timer_0's own
+        {
+            printf( ", latency max %.1f us", 1000.0 * get16( f + 14 ) / smclkKhz );
+        }
+        printf( "\n" );
+        return;
+    case RACE:                                                                  // Times in ACLK counts
+        if ( length < 21 ) break;
+        printf( "RACE     %s, %lu to %lu presses, margin %.1f ms, clock offset %.1f ms, round trip %.2f ms\n",
+                f[2] < 4 ? raceResult[ f[2] ] : "?",
+                (unsigned long)( get16( f + 3 ) | ( (uint32_t)get16( f + 5 ) << 16 ) ),
+                (unsigned long)( get16( f + 7 ) | ( (uint32_t)get16( f + 9 ) << 16 ) ),
+                1000.0 * (int32_t)( get16( f + 11 ) | ( (uint32_t)get16( f + 13 ) << 16 ) ) / 32768,
+                1000.0 * (int32_t)( get16( f + 15 ) | ( (uint32_t)get16( f + 17 ) << 16 ) ) / 32768,
+                1000.0 * get16( f + 19 ) / 32768 );
+        return;
+    case PROFILE:                                                               // Read by tools/profile.c
+        if ( length < 5 || ( length - 5 ) % 3 ) break;
+        printf( "PROFILE  buckets of %u bytes:", 1u << f[2] );
+        for ( k = 5; k < length; k += 3 )
+        {
+            printf( " 0x%04lX %u", get16( f + 3 ) + ( (unsigned long)f[k] << f[2] ), get16( f + k + 1 ) );
+        }
+        printf( "\n" );
+        return;
+    case LCD:
+        if ( length < 2 + LCD_MEM_BYTES ) break;
+        lcdDecode( f + 2, &text );
+        printf( "LCD      \"%s\"", text.text );
+        lcdPrintIcons( stdout, text.icons );
+        if ( text.glitches || strchr( text.text, LCD_UNKNOWN_CHAR ) )           // Not all characters: show the bytes
+        {
+            printf( ", " );
+            for ( k = 2; k < 2 + LCD_MEM_BYTES; k++ )
+            {
+                printf( "%02X", f[k] );
+            }
+        }
+        printf( "\n" );
+        return;
+    }
+    printf( "frame type %u, %d bytes:", f[0], length );
+    for ( k = 0; k < length; k++ )
+    {
+        printf( " %02X", f[k] );
+    }
+    printf( "\n" );
+}
+
+static int openPort( const char *name )
+{
+    struct termios tio;
+    int fd;
+
+    if ( strcmp( name, "--pty" ) == 0 )
+    {
+        fd = posix_openpt( O_RDWR | O_NOCTTY );
+        if ( fd < 0 || grantpt( fd ) || unlockpt( fd ) )
+        {
+            perror( "pty" );
+            exit( 1 );
+        }
+        printf( "reading from %s\n", ptsname( fd ) );
+        fflush( stdout );
+        if ( open( ptsname( fd ), O_RDWR | O_NOCTTY ) < 0 )                      // Keep the slave open, or reads fail
+        {                                                                       //  while no writer has it open
+            perror( "pty" );
+            exit( 1 );
+        }
+    }
+    else
+    {
+        fd = open( name, O_RDWR | O_NOCTTY );
+        if ( fd < 0 )
+        {
+            perror( name );
+            exit( 1 );
+        }
+    }
+
+    if ( tcgetattr( fd, &tio ) == 0 )                                           // Raw 8N1 at 115200 baud
+    {
+        cfmakeraw( &tio );
+        cfsetispeed( &tio, B115200 );
+        cfsetospeed( &tio, B115200 );
+        tcsetattr( fd, TCSANOW, &tio );
+    }
+    return fd;
+}
+
+int main( int argc, char *argv[] )
+{
+    uint8_t frame[ FRAME_MAX ];
+    uint8_t buf[ 256 ];
+    int fd, length = 0, synced = 0;
+    ssize_t n, k;
+
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s /dev/ttyACMx | --pty\n", argv[0] );
+        return 2;
+    }
+    fd = openPort( argv[1] );
+    setvbuf( stdout, NULL, _IOLBF, 0 );                                         // Line by line, into a pipe too
+    synced = ( strcmp( argv[1], "--pty" ) == 0 );                               // A pty starts at the start of a frame
+
+    while ( ( n = read( fd, buf, sizeof( buf ) ) ) > 0 )
+    {
+        for ( k = 0; k < n; k++ )
+        {
+            if ( buf[k] != 0 )
+            {
+                if ( length < FRAME_MAX )
+                {
+                    frame[ length ] = buf[k];
+                }
+                length++;
+                continue;
+            }
+            if ( synced && length > 0 )                                         // End of a frame
+            {
+                int decoded = length <= FRAME_MAX ? cobsDecode( frame, length ) : -1;
+
+                if ( decoded < 0 )
+                {
+                    printf( "-- bad frame (%d bytes)\n", length );
+                }
+                else
+                {
+                    printFrame( frame, decoded );
+                }
+                fflush( stdout );
+            }
+            synced = 1;
+            length = 0;
+        }
+    }
+    return 0;
+}
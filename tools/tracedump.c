@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------------------
+// tracedump.c  (host tool)
+//
+// Decodes a memory dump of the game's event trace into a timeline.
+//
+// Save 'traceLog' (RAM) or 'traceFram' (FRAM, with TRACE_FRAM) from the CCS
+// Memory Browser as a raw binary file, then run:
+//
+//    cc -O2 -o tracedump tools/tracedump.c
+//    ./tracedump trace.bin
+//
+// The dump starts with the header from myTrace.h (magic, ring size, head,
+// SMCLK in kHz) followed by the ring of 8-byte records, all little-endian.
+// Records are printed oldest first, with the time since the first record
+// and since the previous one.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#define TRACE_MAGIC     0x5254
+
+// Keep in step with the event IDs in myTrace.h
+static const char *eventName[] =
+{
+    "NONE", "BOOT", "CLOCKS", "GAME_START", "RESUME", "ROUND", "LED",
+    "BUTTON_DOWN", "BUTTON_UP", "TIMEOUT", "GAME_OVER", "LCD_WORD",
+    "LCD_NUMBER", "LCD_SCROLL", "SLEEP", "WAKE", "PHASE", "STACK",
+    "ISR_TIME", "ISR_LATENCY", "LOST"
+};
+#define EVENTS          ( sizeof( eventName ) / sizeof( eventName[0] ) )
+
+static const char *levelName[] = { "EASY", "NORMAL", "HARD" };
+static const char *phaseName[] = { "start", "wait", "level", "intro", "playback", "input", "game over" };
+
+// Keep in step with the ISR IDs in myIsr.h
+static const char *isrName[] = { "Timer_0", "Timer_1", "Port_1", "UART", "DMA", "Link" };
+#define ISRS            ( sizeof( isrName ) / sizeof( isrName[0] ) )
+
+
+static uint16_t get16( const uint8_t *p )
+{
+    return (uint16_t)( p[0] | ( p[1] << 8 ) );
+}
+
+static void printPayload( unsigned int id, unsigned int payload )
+{
+    switch ( id )
+    {
+    case 1:                                                                     // BOOT
+        printf( "reset reason 0x%04X", payload );
+        break;
+    case 2:                                                                     // CLOCKS
+        printf( "MCLK %u kHz", payload );
+        break;
+    case 3:                                                                     // GAME_START
+        printf( "%s%s%s", ( payload & 0xFF ) < 3 ? levelName[ payload & 0xFF ] : "?",
+                payload & 0x100 ? " endless" : "", payload & 0x200 ? " adaptive" : "" );
+        break;
+    case 4:                                                                     // RESUME
+    case 5:                                                                     // ROUND
+    case 9:                                                                     // TIMEOUT
+        printf( "round %u", payload + 1 );
+        break;
+    case 6:                                                                     // LED
+        printf( "%s", payload == 0 ? "red" : payload == 1 ? "green" : "external" );
+        break;
+    case 7:                                                                     // BUTTON_DOWN
+    case 8:                                                                     // BUTTON_UP
+        printf( "S%u", payload );
+        break;
+    case 10:                                                                    // GAME_OVER
+        printf( "score %u", payload );
+        break;
+    case 11:                                                                    // LCD_WORD
+        printf( "\"%c%c...\"", payload & 0xFF ? payload & 0xFF : ' ', payload >> 8 ? payload >> 8 : ' ' );
+        break;
+    case 14:                                                                    // SLEEP
+        printf( "LPM%u", payload );
+        break;
+    case 15:                                                                    // WAKE
+        printf( "%s", payload ? "button" : "timeout" );
+        break;
+    case 16:                                                                    // PHASE
+        printf( "%s", payload < 7 ? phaseName[ payload ] : "?" );
+        break;
+    case 17:                                                                    // STACK
+        printf( "%u bytes", payload );
+        break;
+    case 18:                                                                    // ISR_TIME
+    case 19:                                                                    // ISR_LATENCY
+        printf( "%s %u%s Timer_0 counts", ( payload >> 12 ) < ISRS ? isrName[ payload >> 12 ] : "?",
+                payload & 0x0FFF, ( payload & 0x0FFF ) == 0x0FFF ? " or more" : "" );
+        break;
+    case 20:                                                                    // LOST
+        printf( "%u records written over before they were read", payload );
+        break;
+    default:
+        printf( "%u", payload );
+        break;
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    FILE *f;
+    uint8_t header[8];
+    uint8_t *ring;
+    unsigned int records, head, smclkKhz, i;
+    uint64_t wraps = 0;                                                         // Times the 32-bit timestamp wrapped
+    uint32_t last = 0;
+    double first = -1, previous = 0, now;
+
+    if ( argc != 2 )
+    {
+        fprintf( stderr, "usage: %s trace.bin\n", argv[0] );
+        return 2;
+    }
+    f = fopen( argv[1], "rb" );
+    if ( !f || fread( header, 1, sizeof( header ), f ) != sizeof( header ) )
+    {
+        fprintf( stderr, "%s: can't read header\n", argv[1] );
+        return 1;
+    }
+    if ( get16( header ) != TRACE_MAGIC )
+    {
+        fprintf( stderr, "%s: not a trace dump (magic 0x%04X)\n", argv[1], get16( header ) );
+        return 1;
+    }
+    records  = get16( header + 2 );
+    head     = get16( header + 4 );
+    smclkKhz = get16( header + 6 );
+    if ( records == 0 || head >= records || smclkKhz == 0 )
+    {
+        fprintf( stderr, "%s: bad header\n", argv[1] );
+        return 1;
+    }
+
+    ring = malloc( records * 8 );
+    if ( !ring || fread( ring, 8, records, f ) != records )
+    {
+        fprintf( stderr, "%s: dump is shorter than its %u records\n", argv[1], records );
+        return 1;
+    }
+    fclose( f );
+
+    printf( "%u records, SMCLK %u kHz\n", records, smclkKhz );
+    printf( "%12s %10s  %-12s %s\n", "time (ms)", "delta", "event", "payload" );
+
+    for ( i = 0; i < records; i++ )                                             // Oldest record is at 'head'
+    {
+        const uint8_t *r = ring + ( ( head + i ) % records ) * 8;
+        uint32_t stamp = ( (uint32_t)get16( r + 2 ) << 16 ) | get16( r );
+        unsigned int id = get16( r + 4 );
+
+        if ( id == 0 )
+        {
+            continue;                                                           // Never written
+        }
+
+        // The ISR may not have counted a Timer_0 wrap yet when a record was
+        // taken right after it. A step back of less than one wrap is that,
+        // so the record is moved forward by one wrap; a bigger step back
+        // means the 32-bit timestamp itself wrapped.
+        if ( first >= 0 && stamp < last )
+        {
+            if ( last - stamp > 0x10000 )
+            {
+                wraps++;
+            }
+            else
+            {
+                stamp += 0x10000;
+            }
+        }
+        last = stamp;
+
+        now = ( (double)( wraps << 32 ) + stamp ) / smclkKhz;
+        if ( first < 0 )
+        {
+            first = previous = now;
+        }
+        printf( "%12.3f %+10.3f  %-12s ", now - first, now - previous,
+                id < EVENTS ? eventName[id] : "?" );
+        printPayload( id, get16( r + 6 ) );
+        printf( "\n" );
+        previous = now;
+    }
+
+    free( ring );
+    return 0;
+}